@@ -0,0 +1,28 @@
+########################################################
+#
+#    Copyright (c) 2023
+#      SMASH Team
+#
+#    BSD 3-clause license
+#
+#########################################################
+
+# cmake-format: off
+#=======================================================
+# - Try to find the LZ4 compression library
+#
+# This will define:
+#
+#  LZ4_INCLUDE_DIR
+#  LZ4_LIBRARIES
+#  LZ4_FOUND
+#=======================================================
+# cmake-format: on
+
+find_path(LZ4_INCLUDE_DIR lz4.h DOC "Directory of the LZ4 header")
+find_library(LZ4_LIBRARIES NAMES lz4 DOC "The LZ4 library")
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4 REQUIRED_VARS LZ4_INCLUDE_DIR LZ4_LIBRARIES)
+
+mark_as_advanced(LZ4_INCLUDE_DIR LZ4_LIBRARIES)
@@ -0,0 +1,28 @@
+########################################################
+#
+#    Copyright (c) 2023
+#      SMASH Team
+#
+#    BSD 3-clause license
+#
+#########################################################
+
+# cmake-format: off
+#=======================================================
+# - Try to find the Zstandard compression library
+#
+# This will define:
+#
+#  ZSTD_INCLUDE_DIR
+#  ZSTD_LIBRARIES
+#  Zstd_FOUND
+#=======================================================
+# cmake-format: on
+
+find_path(ZSTD_INCLUDE_DIR zstd.h DOC "Directory of the Zstandard header")
+find_library(ZSTD_LIBRARIES NAMES zstd DOC "The Zstandard library")
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Zstd REQUIRED_VARS ZSTD_INCLUDE_DIR ZSTD_LIBRARIES)
+
+mark_as_advanced(ZSTD_INCLUDE_DIR ZSTD_LIBRARIES)
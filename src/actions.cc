@@ -0,0 +1,116 @@
+/*
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ */
+
+#include "smash/actions.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace smash {
+
+ActionPtr Actions::pop() {
+  if (n_pending_ == 0) {
+    throw std::runtime_error("Empty actions list!");
+  }
+  const uint32_t slot = heap_.front().slot;
+  std::pop_heap(heap_.begin(), heap_.end(), later);
+  heap_.pop_back();
+  ActionPtr act = std::move(slots_[slot]);
+  release(slot);
+  drop_removed_keys();
+  return act;
+}
+
+void Actions::insert(ActionPtr&& action) {
+  uint32_t slot;
+  if (free_slots_.empty()) {
+    slot = static_cast<uint32_t>(slots_.size());
+    slots_.emplace_back();
+    generations_.push_back(0);
+  } else {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  }
+  const uint32_t generation = generations_[slot];
+  for (const ParticleData& p : action->incoming_particles()) {
+    const unsigned index = p.index();
+    // Particles outside of Particles cannot interact
+    if (index == std::numeric_limits<unsigned>::max()) {
+      continue;
+    }
+    if (index >= first_link_.size()) {
+      first_link_.resize(index + 1, no_link);
+    }
+    links_.push_back({slot, generation, first_link_[index]});
+    first_link_[index] = static_cast<uint32_t>(links_.size() - 1);
+  }
+  heap_.push_back(
+      {action->time_of_execution(), n_inserted_++, slot, generation});
+  std::push_heap(heap_.begin(), heap_.end(), later);
+  slots_[slot] = std::move(action);
+  n_pending_++;
+}
+
+std::size_t Actions::invalidate(const ParticleList& particles) {
+  std::size_t n_removed = 0;
+  for (const ParticleData& p : particles) {
+    const unsigned index = p.index();
+    if (index >= first_link_.size()) {
+      continue;
+    }
+    for (uint32_t l = first_link_[index]; l != no_link; l = links_[l].next) {
+      if (generations_[links_[l].slot] == links_[l].generation) {
+        release(links_[l].slot);
+        n_removed++;
+      }
+    }
+    first_link_[index] = no_link;
+  }
+  drop_removed_keys();
+  return n_removed;
+}
+
+void Actions::clear() {
+  heap_.clear();
+  slots_.clear();
+  generations_.clear();
+  free_slots_.clear();
+  first_link_.clear();
+  links_.clear();
+  n_pending_ = 0;
+}
+
+void Actions::release(uint32_t slot) {
+  slots_[slot].reset();
+  generations_[slot]++;
+  free_slots_.push_back(slot);
+  n_pending_--;
+}
+
+void Actions::drop_removed_keys() {
+  if (n_pending_ == 0) {
+    // Nothing refers to the slots anymore
+    heap_.clear();
+    first_link_.clear();
+    links_.clear();
+    return;
+  }
+  if (heap_.size() > 2 * n_pending_ + 16) {
+    heap_.erase(std::remove_if(heap_.begin(), heap_.end(),
+                               [this](const Key& key) {
+                                 return !is_pending(key);
+                               }),
+                heap_.end());
+    std::make_heap(heap_.begin(), heap_.end(), later);
+  }
+  while (!is_pending(heap_.front())) {
+    std::pop_heap(heap_.begin(), heap_.end(), later);
+    heap_.pop_back();
+  }
+}
+
+}  // namespace smash
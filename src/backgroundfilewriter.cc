@@ -0,0 +1,133 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/backgroundfilewriter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "smash/logging.h"
+
+namespace smash {
+static constexpr int LOutput = LogArea::Output::id;
+
+BackgroundFileWriter::BackgroundFileWriter(std::FILE *file,
+                                           std::size_t memory_budget)
+    : file_(file), memory_budget_(memory_budget) {
+  if (memory_budget_ > 0) {
+    worker_ = std::thread([this]() { worker_loop(); });
+  }
+}
+
+BackgroundFileWriter::~BackgroundFileWriter() {
+  try {
+    finish();
+  } catch (std::exception &e) {
+    logg[LOutput].error("Writing an output file failed: ", e.what());
+  }
+}
+
+std::size_t BackgroundFileWriter::block_size() const {
+  constexpr std::size_t min_block_size = 64 * 1024;
+  return std::max(min_block_size, memory_budget_ / 4);
+}
+
+void BackgroundFileWriter::submit(std::vector<char> &&block, bool flush,
+                                  Encoder encoder) {
+  Entry entry{std::move(block), flush, std::move(encoder)};
+  if (!worker_.joinable()) {
+    write_block(entry);
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  rethrow_error();
+  // A block larger than the budget is still accepted once the queue is empty.
+  block_written_.wait(lock, [&]() {
+    return queued_bytes_ == 0 ||
+           queued_bytes_ + entry.block.size() <= memory_budget_ || error_;
+  });
+  rethrow_error();
+  queued_bytes_ += entry.block.size();
+  queue_.push_back(std::move(entry));
+  lock.unlock();
+  work_available_.notify_one();
+}
+
+void BackgroundFileWriter::finish() {
+  if (worker_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_available_.notify_one();
+    worker_.join();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  rethrow_error();
+}
+
+void BackgroundFileWriter::write_block(const Entry &entry) {
+  std::vector<char> encoded;
+  if (entry.encoder) {
+    encoded = entry.encoder(entry.block);
+  }
+  const std::vector<char> &block = entry.encoder ? encoded : entry.block;
+  if (!block.empty() &&
+      std::fwrite(block.data(), 1, block.size(), file_) != block.size()) {
+    throw std::runtime_error(std::string("Could not write output file: ") +
+                             std::strerror(errno));
+  }
+  if (entry.flush && std::fflush(file_) != 0) {
+    throw std::runtime_error(std::string("Could not flush output file: ") +
+                             std::strerror(errno));
+  }
+}
+
+void BackgroundFileWriter::worker_loop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_available_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+    Entry entry = std::move(queue_.front());
+    queue_.pop_front();
+    const bool failed_before = failed_;
+    lock.unlock();
+    // After an error the remaining blocks are dropped, but still dequeued.
+    std::exception_ptr error;
+    if (!failed_before) {
+      try {
+        write_block(entry);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    lock.lock();
+    if (error) {
+      error_ = error;
+      failed_ = true;
+    }
+    queued_bytes_ -= entry.block.size();
+    block_written_.notify_all();
+  }
+}
+
+void BackgroundFileWriter::rethrow_error() {
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace smash
@@ -0,0 +1,292 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/binarycompression.h"
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#ifdef SMASH_USE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef SMASH_USE_LZ4
+#include <lz4.h>
+#endif
+
+namespace smash {
+
+namespace {
+/**
+ * Shortest match of the built-in codec. Shorter repetitions are cheaper to
+ * store as literals.
+ */
+constexpr std::size_t min_match = 4;
+
+/// Number of bits of the hash of the built-in codec's match finder.
+constexpr int hash_bits = 16;
+
+/**
+ * Append an unsigned number with 7 bits per byte, the highest bit telling
+ * whether another byte follows.
+ *
+ * \param[in] value Number to append
+ * \param[inout] out Buffer to append to
+ */
+void put_varint(std::size_t value, std::vector<char> &out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+/**
+ * Read a number written by put_varint.
+ *
+ * \param[inout] in Position to read from, moved past the number
+ * \param[in] end End of the input
+ * \return The number
+ * \throw std::runtime_error if the number is cut off or too long
+ */
+std::size_t get_varint(const unsigned char *&in, const unsigned char *end) {
+  std::size_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (in == end) {
+      break;
+    }
+    const unsigned char byte = *in++;
+    value |= static_cast<std::size_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Corrupt compressed chunk in binary output.");
+}
+
+/// Hash of the four bytes at p for the match finder of the built-in codec.
+std::uint32_t hash4(const char *p) {
+  std::uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return (v * 2654435761u) >> (32 - hash_bits);
+}
+
+/**
+ * Built-in LZ77-style compression. The output is a sequence of a number of
+ * literal bytes, the literals, the length of a match minus min_match and the
+ * distance back to the match. The last literals are not followed by a match.
+ * Matches are found greedily with a hash table of the last position of each
+ * four-byte sequence.
+ */
+std::vector<char> builtin_compress(const char *data, std::size_t size) {
+  std::vector<char> out;
+  out.reserve(size / 2 + 16);
+  // Positions + 1 of the last occurrence of each hash, 0 if none
+  std::vector<std::size_t> table(std::size_t(1) << hash_bits, 0);
+  std::size_t literal_start = 0;
+  std::size_t i = 0;
+  while (i + min_match <= size) {
+    const std::uint32_t h = hash4(data + i);
+    const std::size_t candidate = table[h];
+    table[h] = i + 1;
+    if (candidate == 0 ||
+        std::memcmp(data + candidate - 1, data + i, min_match) != 0) {
+      i++;
+      continue;
+    }
+    const std::size_t match = candidate - 1;
+    std::size_t length = min_match;
+    while (i + length < size && data[match + length] == data[i + length]) {
+      length++;
+    }
+    put_varint(i - literal_start, out);
+    out.insert(out.end(), data + literal_start, data + i);
+    put_varint(length - min_match, out);
+    put_varint(i - match, out);
+    for (std::size_t j = i + 1; j < i + length && j + min_match <= size; j++) {
+      table[hash4(data + j)] = j + 1;
+    }
+    i += length;
+    literal_start = i;
+  }
+  put_varint(size - literal_start, out);
+  out.insert(out.end(), data + literal_start, data + size);
+  return out;
+}
+
+/// Inverse of builtin_compress, see decompress_chunk.
+void builtin_decompress(const char *data, std::size_t size, char *out,
+                        std::size_t out_size) {
+  const auto *in = reinterpret_cast<const unsigned char *>(data);
+  const unsigned char *const in_end = in + size;
+  std::size_t pos = 0;
+  const std::runtime_error corrupt(
+      "Corrupt compressed chunk in binary output.");
+  while (true) {
+    const std::size_t literals = get_varint(in, in_end);
+    if (literals > static_cast<std::size_t>(in_end - in) ||
+        literals > out_size - pos) {
+      throw corrupt;
+    }
+    if (literals > 0) {
+      std::memcpy(out + pos, in, literals);
+    }
+    in += literals;
+    pos += literals;
+    if (in == in_end) {
+      break;
+    }
+    const std::size_t length = get_varint(in, in_end) + min_match;
+    const std::size_t distance = get_varint(in, in_end);
+    if (distance == 0 || distance > pos || length > out_size - pos) {
+      throw corrupt;
+    }
+    // Byte by byte, since a match may overlap the bytes it produces.
+    for (std::size_t j = 0; j < length; j++, pos++) {
+      out[pos] = out[pos - distance];
+    }
+  }
+  if (pos != out_size) {
+    throw corrupt;
+  }
+}
+
+/// Error for a codec which SMASH was built without.
+std::runtime_error unavailable(BinaryCompression codec) {
+  return std::runtime_error(
+      "SMASH was built without support for the compression of binary output "
+      "with codec number " +
+      std::to_string(static_cast<int>(codec)) + ".");
+}
+}  // unnamed namespace
+
+bool is_available(BinaryCompression codec) {
+  switch (codec) {
+    case BinaryCompression::None:
+    case BinaryCompression::Builtin:
+      return true;
+    case BinaryCompression::Zstd:
+#ifdef SMASH_USE_ZSTD
+      return true;
+#else
+      return false;
+#endif
+    case BinaryCompression::LZ4:
+#ifdef SMASH_USE_LZ4
+      return true;
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+std::vector<char> compress_chunk(BinaryCompression codec, const char *data,
+                                 std::size_t size) {
+  switch (codec) {
+    case BinaryCompression::None:
+      return std::vector<char>(data, data + size);
+    case BinaryCompression::Builtin:
+      return builtin_compress(data, size);
+    case BinaryCompression::Zstd: {
+#ifdef SMASH_USE_ZSTD
+      std::vector<char> out(ZSTD_compressBound(size));
+      const std::size_t n = ZSTD_compress(out.data(), out.size(), data, size,
+                                          ZSTD_CLEVEL_DEFAULT);
+      if (ZSTD_isError(n)) {
+        throw std::runtime_error(std::string("Zstd compression failed: ") +
+                                 ZSTD_getErrorName(n));
+      }
+      out.resize(n);
+      return out;
+#else
+      break;
+#endif
+    }
+    case BinaryCompression::LZ4: {
+#ifdef SMASH_USE_LZ4
+      if (size > LZ4_MAX_INPUT_SIZE) {
+        throw std::runtime_error("Chunk too large for LZ4 compression.");
+      }
+      const int in_size = static_cast<int>(size);
+      std::vector<char> out(LZ4_compressBound(in_size));
+      const int n = LZ4_compress_default(data, out.data(), in_size,
+                                         static_cast<int>(out.size()));
+      if (n <= 0 && size > 0) {
+        throw std::runtime_error("LZ4 compression failed.");
+      }
+      out.resize(n);
+      return out;
+#else
+      break;
+#endif
+    }
+  }
+  throw unavailable(codec);
+}
+
+void decompress_chunk(BinaryCompression codec, const char *data,
+                      std::size_t size, char *out, std::size_t out_size) {
+  switch (codec) {
+    case BinaryCompression::None:
+      if (size != out_size) {
+        throw std::runtime_error("Corrupt chunk in binary output.");
+      }
+      if (size > 0) {
+        std::memcpy(out, data, size);
+      }
+      return;
+    case BinaryCompression::Builtin:
+      builtin_decompress(data, size, out, out_size);
+      return;
+    case BinaryCompression::Zstd: {
+#ifdef SMASH_USE_ZSTD
+      const std::size_t n = ZSTD_decompress(out, out_size, data, size);
+      if (ZSTD_isError(n) || n != out_size) {
+        throw std::runtime_error("Corrupt Zstd chunk in binary output.");
+      }
+      return;
+#else
+      break;
+#endif
+    }
+    case BinaryCompression::LZ4: {
+#ifdef SMASH_USE_LZ4
+      if (size > LZ4_MAX_INPUT_SIZE || out_size > LZ4_MAX_INPUT_SIZE ||
+          LZ4_decompress_safe(data, out, static_cast<int>(size),
+                              static_cast<int>(out_size)) !=
+              static_cast<int>(out_size)) {
+        throw std::runtime_error("Corrupt LZ4 chunk in binary output.");
+      }
+      return;
+#else
+      break;
+#endif
+    }
+  }
+  throw unavailable(codec);
+}
+
+std::ostream &operator<<(std::ostream &out, BinaryCompression codec) {
+  switch (codec) {
+    case BinaryCompression::None:
+      return out << "None";
+    case BinaryCompression::Builtin:
+      return out << "Builtin";
+    case BinaryCompression::Zstd:
+      return out << "Zstd";
+    case BinaryCompression::LZ4:
+      return out << "LZ4";
+  }
+  return out << "unknown (" << static_cast<int>(codec) << ")";
+}
+
+}  // namespace smash
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2020,2022
+ *    Copyright (c) 2014-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -9,6 +9,7 @@
 
 #include "smash/binaryoutput.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <string>
 
@@ -20,6 +21,20 @@ namespace smash {
 
 static constexpr int LHyperSurfaceCrossing = LogArea::HyperSurfaceCrossing::id;
 
+namespace {
+/**
+ * Append the bytes of a value to a buffer.
+ *
+ * \param[in] x Value to be written
+ * \param[inout] out Buffer to append to
+ */
+template <typename T>
+void put(const T &x, std::vector<char> &out) {
+  const char *bytes = reinterpret_cast<const char *>(&x);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+}  // unnamed namespace
+
 /*!\Userguide
  * \page doxypage_output_binary
  * SMASH supports a binary output version similar to the OSCAR 2013 standard.
@@ -43,7 +58,9 @@ static constexpr int LHyperSurfaceCrossing = LogArea::HyperSurfaceCrossing::id;
  * \endcode
  * \li magic_number - 4 bytes that in ASCII read as "SMSH".
  * \li Format version is an integer number, currently it is 7.
- * \li Format variant is an integer number: 0 for default, 1 for extended.
+ * \li Format variant is an integer number: 0 for default, 1 for extended. 2
+ * is added for the compressed variant, see
+ * \ref doxypage_output_binary_compressed.
  * \li len is the length of smash version string
  * \li smash_version is len chars that give information about the SMASH version.
  *
@@ -130,37 +147,191 @@ static constexpr int LHyperSurfaceCrossing = LogArea::HyperSurfaceCrossing::id;
  * \ref input_output_content_specific_ "content-specific output options".
  *
  * See also \ref doxypage_output_collisions_box_modus.
+ *
+ * Reading binary output
+ * ---------------------
+ * Within SMASH, and for analyses linked to the SMASH library, the class
+ * smash::BinaryReader maps a binary file into memory and gives random and
+ * parallel access to its events without copying the particle lines. The
+ * positions of the events can be stored next to the file in advance with the
+ * \c --index-binary command line option, see \ref doxypage_smash_invocation.
  **/
 
+/*!\Userguide
+ * \page doxypage_output_binary_compressed
+ * With the \ref key_output_binary_compression_ "Binary_Compression" key, the
+ * binary outputs compress their records in chunks. The header is the same as
+ * for the uncompressed format, except that 2 is added to the format variant.
+ * It is followed by the chunks and the chunk index.
+ *
+ * **Chunk**
+ * \code
+ * char uint8_t uint32_t        uint32_t          compressed_size*char
+ * 'c'  codec   compressed_size uncompressed_size data
+ * \endcode
+ * \li \c codec: 0 for uncompressed data, 1 for the built-in codec, 2 for
+ * Zstandard and 3 for LZ4. A chunk which does not become smaller is stored
+ * uncompressed.
+ * \li \c data decompresses to \c uncompressed_size bytes of 'p', 'i' and 'f'
+ * blocks, which are the same as in the uncompressed format.
+ *
+ * The chunks are independent of each other. A chunk only contains blocks of
+ * one event and ends at the end of a block. An event ends with its 'f' block
+ * at the end of its last chunk. At most 4 MiB of blocks are put in a chunk,
+ * unless a single block is larger.
+ *
+ * The built-in codec stores sequences of a varint number of literal bytes,
+ * the literal bytes, the varint length of a repetition minus 4 and the varint
+ * distance back to the repeated bytes. The last literal bytes of a chunk are
+ * not followed by a repetition. Varints store 7 bits per byte, starting with
+ * the lowest bits, and the highest bit of a byte is set if another byte
+ * follows.
+ *
+ * **Chunk index**
+ * \code
+ * char uint32_t
+ * 'x'  n_chunks
+ * \endcode
+ * followed by \c n_chunks entries
+ * \code
+ * uint64_t uint32_t        uint32_t          uint32_t
+ * offset   compressed_size uncompressed_size event
+ * \endcode
+ * and
+ * \code
+ * uint64_t     4*char
+ * index_offset "SIDX"
+ * \endcode
+ * \li \c offset is the position of the 'c' of the chunk in the file.
+ * \li \c event is the number of events in the file before the one the chunk
+ * belongs to.
+ * \li \c index_offset is the position of the 'x' in the file.
+ *
+ * Readers find the index from the last 12 bytes of the file. They can seek to
+ * an event and decompress the chunks in parallel. If the index is missing,
+ * because SMASH did not finish, the chunks can still be read one after the
+ * other.
+ */
+
 BinaryOutputBase::BinaryOutputBase(const std::filesystem::path &path,
                                    const std::string &mode,
                                    const std::string &name,
-                                   bool extended_format)
-    : OutputInterface(name), file_{path, mode}, extended_(extended_format) {
-  std::fwrite("SMSH", 4, 1, file_.get());  // magic number
-  write(format_version_);                  // file format version number
+                                   bool extended_format,
+                                   std::size_t buffer_size,
+                                   BinaryCompression compression)
+    : OutputInterface(name),
+      file_{path, mode},
+      extended_(extended_format),
+      compression_(compression),
+      writer_(file_.get(), buffer_size) {
+  for (const char c : {'S', 'M', 'S', 'H'}) {  // magic number
+    write(c);
+  }
+  write(format_version_);  // file format version number
   std::uint16_t format_variant = static_cast<uint16_t>(extended_);
+  if (compression_ != BinaryCompression::None) {
+    format_variant += 2;
+  }
   write(format_variant);
   write(SMASH_VERSION);
+  // The header is never compressed.
+  file_offset_ = buffer_.size();
+  writer_.submit(std::move(buffer_), false);
+  buffer_ = std::vector<char>();
+  buffer_.reserve(writer_.block_size());
 }
 
-// write functions:
-void BinaryOutputBase::write(const char c) {
-  std::fwrite(&c, sizeof(char), 1, file_.get());
+BinaryOutputBase::~BinaryOutputBase() {
+  try {
+    if (!buffer_.empty()) {
+      finish_record(true);
+    }
+    writer_.finish();
+    if (compression_ != BinaryCompression::None) {
+      write_chunk_index();
+    }
+  } catch (std::exception &e) {
+    logg[LOutput].error("Writing the binary output failed: ", e.what());
+  }
 }
 
-void BinaryOutputBase::write(const std::string &s) {
-  const auto size = smash::numeric_cast<uint32_t>(s.size());
-  std::fwrite(&size, sizeof(std::uint32_t), 1, file_.get());
-  std::fwrite(s.c_str(), s.size(), 1, file_.get());
+void BinaryOutputBase::finish_record(bool flush) {
+  const std::size_t chunk_size =
+      compression_ == BinaryCompression::None
+          ? writer_.block_size()
+          : std::min(writer_.block_size(), max_chunk_size);
+  if (flush || buffer_.size() >= chunk_size) {
+    std::vector<char> full_buffer;
+    full_buffer.reserve(writer_.block_size());
+    std::swap(full_buffer, buffer_);
+    if (compression_ == BinaryCompression::None) {
+      writer_.submit(std::move(full_buffer), flush);
+    } else if (!full_buffer.empty()) {
+      const std::uint32_t event = events_finished_;
+      writer_.submit(std::move(full_buffer), flush,
+                     [this, event](const std::vector<char> &records) {
+                       return encode_chunk(records, event);
+                     });
+    }
+  }
+  if (flush) {
+    events_finished_++;
+  }
+}
+
+std::vector<char> BinaryOutputBase::encode_chunk(
+    const std::vector<char> &records, std::uint32_t event) {
+  std::vector<char> data =
+      compress_chunk(compression_, records.data(), records.size());
+  BinaryCompression codec = compression_;
+  if (data.size() >= records.size()) {
+    codec = BinaryCompression::None;
+    data = records;
+  }
+  const ChunkIndexEntry entry{file_offset_,
+                              numeric_cast<std::uint32_t>(data.size()),
+                              numeric_cast<std::uint32_t>(records.size()),
+                              event};
+  std::vector<char> chunk;
+  chunk.reserve(data.size() + 10);
+  put('c', chunk);
+  put(static_cast<std::uint8_t>(codec), chunk);
+  put(entry.compressed_size, chunk);
+  put(entry.uncompressed_size, chunk);
+  chunk.insert(chunk.end(), data.begin(), data.end());
+  chunk_index_.push_back(entry);
+  file_offset_ += chunk.size();
+  return chunk;
+}
+
+void BinaryOutputBase::write_chunk_index() {
+  std::vector<char> index;
+  index.reserve(chunk_index_.size() * 20 + 17);
+  put('x', index);
+  put(numeric_cast<std::uint32_t>(chunk_index_.size()), index);
+  for (const ChunkIndexEntry &entry : chunk_index_) {
+    put(entry.offset, index);
+    put(entry.compressed_size, index);
+    put(entry.uncompressed_size, index);
+    put(entry.event, index);
+  }
+  put(file_offset_, index);
+  for (const char c : {'S', 'I', 'D', 'X'}) {
+    put(c, index);
+  }
+  writer_.submit(std::move(index), true);
 }
 
-void BinaryOutputBase::write(const double x) {
-  std::fwrite(&x, sizeof(x), 1, file_.get());
+// write functions:
+void BinaryOutputBase::write(const std::string &s) {
+  write(smash::numeric_cast<uint32_t>(s.size()));
+  buffer_.insert(buffer_.end(), s.begin(), s.end());
 }
 
 void BinaryOutputBase::write(const FourVector &v) {
-  std::fwrite(v.begin(), sizeof(*v.begin()), 4, file_.get());
+  for (const double x : v) {
+    write(x);
+  }
 }
 
 void BinaryOutputBase::write(const Particles &particles) {
@@ -177,8 +348,7 @@ void BinaryOutputBase::write(const ParticleList &particles) {
 
 void BinaryOutputBase::write_particledata(const ParticleData &p) {
   write(p.position());
-  double mass = p.effective_mass();
-  std::fwrite(&mass, sizeof(mass), 1, file_.get());
+  write(p.effective_mass());
   write(p.momentum());
   write(p.pdgcode().get_decimal());
   write(p.id());
@@ -202,16 +372,18 @@ BinaryOutputCollisions::BinaryOutputCollisions(
     const OutputParameters &out_par)
     : BinaryOutputBase(
           path / ((name == "Collisions" ? "collisions_binary" : name) + ".bin"),
-          "wb", name, out_par.get_coll_extended(name)),
+          "wb", name, out_par.get_coll_extended(name),
+          out_par.binary_buffer_size, out_par.binary_compression),
       print_start_end_(out_par.coll_printstartend) {}
 
 void BinaryOutputCollisions::at_eventstart(const Particles &particles,
                                            const int, const EventInfo &) {
   const char pchar = 'p';
   if (print_start_end_) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
+    finish_record();
   }
 }
 
@@ -220,54 +392,54 @@ void BinaryOutputCollisions::at_eventend(const Particles &particles,
                                          const EventInfo &event) {
   const char pchar = 'p';
   if (print_start_end_) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
   }
 
   // Event end line
   const char fchar = 'f';
-  std::fwrite(&fchar, sizeof(char), 1, file_.get());
+  write(fchar);
   write(event_number);
   write(event.impact_parameter);
   const char empty = event.empty_event;
   write(empty);
 
   // Flush to disk
-  std::fflush(file_.get());
+  finish_record(true);
 }
 
 void BinaryOutputCollisions::at_interaction(const Action &action,
                                             const double density) {
   const char ichar = 'i';
-  std::fwrite(&ichar, sizeof(char), 1, file_.get());
+  write(ichar);
   write(action.incoming_particles().size());
   write(action.outgoing_particles().size());
-  std::fwrite(&density, sizeof(double), 1, file_.get());
-  const double weight = action.get_total_weight();
-  std::fwrite(&weight, sizeof(double), 1, file_.get());
-  const double partial_weight = action.get_partial_weight();
-  std::fwrite(&partial_weight, sizeof(double), 1, file_.get());
-  const auto type = static_cast<uint32_t>(action.get_type());
-  std::fwrite(&type, sizeof(uint32_t), 1, file_.get());
+  write(density);
+  write(action.get_total_weight());
+  write(action.get_partial_weight());
+  write(static_cast<uint32_t>(action.get_type()));
   write(action.incoming_particles());
   write(action.outgoing_particles());
+  finish_record();
 }
 
 BinaryOutputParticles::BinaryOutputParticles(const std::filesystem::path &path,
                                              std::string name,
                                              const OutputParameters &out_par)
     : BinaryOutputBase(path / "particles_binary.bin", "wb", name,
-                       out_par.part_extended),
+                       out_par.part_extended, out_par.binary_buffer_size,
+                       out_par.binary_compression),
       only_final_(out_par.part_only_final) {}
 
 void BinaryOutputParticles::at_eventstart(const Particles &particles, const int,
                                           const EventInfo &) {
   const char pchar = 'p';
   if (only_final_ == OutputOnlyFinal::No) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
+    finish_record();
   }
 }
 
@@ -276,21 +448,21 @@ void BinaryOutputParticles::at_eventend(const Particles &particles,
                                         const EventInfo &event) {
   const char pchar = 'p';
   if (!(event.empty_event && only_final_ == OutputOnlyFinal::IfNotEmpty)) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
   }
 
   // Event end line
   const char fchar = 'f';
-  std::fwrite(&fchar, sizeof(char), 1, file_.get());
+  write(fchar);
   write(event_number);
   write(event.impact_parameter);
   const char empty = event.empty_event;
   write(empty);
 
   // Flush to disk
-  std::fflush(file_.get());
+  finish_record(true);
 }
 
 void BinaryOutputParticles::at_intermediate_time(const Particles &particles,
@@ -299,17 +471,19 @@ void BinaryOutputParticles::at_intermediate_time(const Particles &particles,
                                                  const EventInfo &) {
   const char pchar = 'p';
   if (only_final_ == OutputOnlyFinal::No) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
+    finish_record();
   }
 }
 
 BinaryOutputInitialConditions::BinaryOutputInitialConditions(
     const std::filesystem::path &path, std::string name,
     const OutputParameters &out_par)
-    : BinaryOutputBase(path / "SMASH_IC.bin", "wb", name, out_par.ic_extended) {
-}
+    : BinaryOutputBase(path / "SMASH_IC.bin", "wb", name, out_par.ic_extended,
+                       out_par.binary_buffer_size,
+                       out_par.binary_compression) {}
 
 void BinaryOutputInitialConditions::at_eventstart(const Particles &, const int,
                                                   const EventInfo &) {}
@@ -319,14 +493,14 @@ void BinaryOutputInitialConditions::at_eventend(const Particles &particles,
                                                 const EventInfo &event) {
   // Event end line
   const char fchar = 'f';
-  std::fwrite(&fchar, sizeof(char), 1, file_.get());
+  write(fchar);
   write(event_number);
   write(event.impact_parameter);
   const char empty = event.empty_event;
   write(empty);
 
   // Flush to disk
-  std::fflush(file_.get());
+  finish_record(true);
 
   // If the runtime is too short some particles might not yet have
   // reached the hypersurface. Warning is printed.
@@ -342,9 +516,10 @@ void BinaryOutputInitialConditions::at_interaction(const Action &action,
                                                    const double) {
   if (action.get_type() == ProcessType::HyperSurfaceCrossing) {
     const char pchar = 'p';
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(action.incoming_particles().size());
     write(action.incoming_particles());
+    finish_record();
   }
 }
 }  // namespace smash
@@ -0,0 +1,441 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/binaryreader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "smash/binarycompression.h"
+#include "smash/file.h"
+#include "smash/threadpool.h"
+
+namespace smash {
+
+namespace {
+/// The only format version that BinaryOutputBase writes
+constexpr std::uint16_t supported_format_version = 8;
+/// Version of the index file format
+constexpr std::uint16_t index_version = 1;
+/// Size of the header of the index file [bytes]
+constexpr std::size_t index_header_size = 24;
+/// Size of an 'f' block [bytes]
+constexpr std::size_t end_block_size = 1 + 4 + 8 + 1;
+/// Size of an 'i' block without its particles [bytes]
+constexpr std::size_t interaction_header_size = 1 + 4 + 4 + 3 * 8 + 4;
+/// Size of the header of a compressed chunk [bytes]
+constexpr std::size_t chunk_header_size = 1 + 1 + 4 + 4;
+
+/**
+ * Read a value from unaligned memory.
+ *
+ * \param[in] data First byte of the value
+ * \return The value
+ */
+template <typename T>
+T get(const char *data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+/**
+ * Append the bytes of a value to a buffer.
+ *
+ * \param[in] x Value to be written
+ * \param[inout] out Buffer to append to
+ */
+template <typename T>
+void put(const T &x, std::vector<char> &out) {
+  const char *bytes = reinterpret_cast<const char *>(&x);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+}  // unnamed namespace
+
+BinaryReader::BinaryReader(const std::filesystem::path &path,
+                           bool use_index_file)
+    : path_(path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open " + path.string() + ": " +
+                             std::strerror(errno));
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || status.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error(path.string() + " is not a SMASH binary file.");
+  }
+  size_ = static_cast<std::size_t>(status.st_size);
+  void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Cannot map " + path.string() + ": " +
+                             std::strerror(error));
+  }
+  data_ = static_cast<const char *>(mapping);
+  try {
+    read_header();
+    index_loaded_ = use_index_file && load_index();
+    if (!index_loaded_) {
+      if (!compressed_) {
+        scan_blocks();
+      } else if (!read_chunk_index()) {
+        scan_chunks();
+      }
+    }
+  } catch (...) {
+    ::munmap(const_cast<char *>(data_), size_);
+    throw;
+  }
+}
+
+BinaryReader::~BinaryReader() { ::munmap(const_cast<char *>(data_), size_); }
+
+std::filesystem::path BinaryReader::index_path(
+    const std::filesystem::path &path) {
+  std::filesystem::path result = path;
+  result += ".idx";
+  return result;
+}
+
+void BinaryReader::read_header() {
+  const std::runtime_error not_binary(path_.string() +
+                                      " is not a SMASH binary file.");
+  constexpr std::size_t fixed_size = 4 + 2 + 2 + 4;
+  if (size_ < fixed_size || std::memcmp(data_, "SMSH", 4) != 0) {
+    throw not_binary;
+  }
+  format_version_ = get<std::uint16_t>(data_ + 4);
+  if (format_version_ != supported_format_version) {
+    throw std::runtime_error(
+        path_.string() + " has binary format version " +
+        std::to_string(format_version_) + ", but only version " +
+        std::to_string(supported_format_version) + " can be read.");
+  }
+  const std::uint16_t variant = get<std::uint16_t>(data_ + 6);
+  if (variant > 3) {
+    throw std::runtime_error(path_.string() +
+                             " has unknown binary format variant " +
+                             std::to_string(variant) + ".");
+  }
+  extended_ = variant & 1;
+  compressed_ = variant & 2;
+  const std::uint32_t length = get<std::uint32_t>(data_ + 8);
+  if (length > size_ - fixed_size) {
+    throw not_binary;
+  }
+  smash_version_.assign(data_ + fixed_size, length);
+  header_size_ = fixed_size + length;
+}
+
+bool BinaryReader::load_index() {
+  std::ifstream file(index_path(path_), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  char header[index_header_size];
+  if (!file.read(header, sizeof(header)) ||
+      std::memcmp(header, "SBIX", 4) != 0 ||
+      get<std::uint16_t>(header + 4) != index_version ||
+      get<std::uint64_t>(header + 8) != size_) {
+    return false;
+  }
+  const std::uint64_t n_events = get<std::uint64_t>(header + 16);
+  // An index file cannot have more events than the output file has bytes.
+  if (n_events > size_) {
+    return false;
+  }
+  std::vector<EventRange> events(n_events);
+  if (n_events > 0 &&
+      !file.read(reinterpret_cast<char *>(events.data()),
+                 n_events * sizeof(EventRange))) {
+    return false;
+  }
+  for (const EventRange &range : events) {
+    if (range.offset < header_size_ || range.offset > size_ ||
+        range.size > size_ - range.offset) {
+      return false;
+    }
+  }
+  events_ = std::move(events);
+  return true;
+}
+
+void BinaryReader::write_index() const {
+  std::vector<char> index;
+  index.reserve(index_header_size + events_.size() * sizeof(EventRange));
+  for (const char c : {'S', 'B', 'I', 'X'}) {
+    put(c, index);
+  }
+  put(index_version, index);
+  put(std::uint16_t(0), index);
+  put(static_cast<std::uint64_t>(size_), index);
+  put(static_cast<std::uint64_t>(events_.size()), index);
+  for (const EventRange &range : events_) {
+    put(range.offset, index);
+    put(range.size, index);
+  }
+  RenamingFilePtr file(index_path(path_), "wb");
+  if (std::fwrite(index.data(), 1, index.size(), file.get()) != index.size()) {
+    throw std::runtime_error("Could not write " +
+                             index_path(path_).string() + ": " +
+                             std::strerror(errno));
+  }
+}
+
+std::size_t BinaryReader::block_size(const char *data,
+                                     std::size_t available) const {
+  const std::size_t line_size = extended_ ? BinaryParticleView::extended_size
+                                          : BinaryParticleView::size;
+  std::size_t size = 0;
+  switch (data[0]) {
+    case 'p':
+      if (available < 5) {
+        return 0;
+      }
+      size = 5 + get<std::uint32_t>(data + 1) * line_size;
+      break;
+    case 'i':
+      if (available < interaction_header_size) {
+        return 0;
+      }
+      size = interaction_header_size +
+             (std::size_t(get<std::uint32_t>(data + 1)) +
+              get<std::uint32_t>(data + 5)) *
+                 line_size;
+      break;
+    case 'f':
+      size = end_block_size;
+      break;
+    default:
+      throw std::runtime_error("Unknown block type '" +
+                               std::string(1, data[0]) + "' in " +
+                               path_.string() + ".");
+  }
+  return size <= available ? size : 0;
+}
+
+void BinaryReader::scan_blocks() {
+  std::size_t event_start = header_size_;
+  std::size_t position = header_size_;
+  while (position < size_) {
+    const char type = data_[position];
+    const std::size_t size = block_size(data_ + position, size_ - position);
+    if (size == 0) {
+      // The last block is incomplete.
+      break;
+    }
+    position += size;
+    if (type == 'f') {
+      events_.push_back({event_start, position - event_start});
+      event_start = position;
+    }
+  }
+}
+
+bool BinaryReader::read_chunk_index() {
+  constexpr std::size_t trailer_size = 8 + 4;
+  if (size_ < header_size_ + 5 + trailer_size ||
+      std::memcmp(data_ + size_ - 4, "SIDX", 4) != 0) {
+    return false;
+  }
+  const std::uint64_t index_offset =
+      get<std::uint64_t>(data_ + size_ - trailer_size);
+  if (index_offset < header_size_ ||
+      index_offset > size_ - 5 - trailer_size || data_[index_offset] != 'x') {
+    return false;
+  }
+  constexpr std::size_t entry_size = 8 + 4 + 4 + 4;
+  const std::uint32_t n_chunks = get<std::uint32_t>(data_ + index_offset + 1);
+  if (index_offset + 5 + std::uint64_t(n_chunks) * entry_size + trailer_size !=
+      size_) {
+    return false;
+  }
+  std::vector<EventRange> events;
+  std::uint32_t current_event = 0;
+  std::uint64_t last_chunk = 0;
+  const char *entry = data_ + index_offset + 5;
+  for (std::uint32_t i = 0; i < n_chunks; i++, entry += entry_size) {
+    const std::uint64_t offset = get<std::uint64_t>(entry);
+    const std::uint32_t compressed_size = get<std::uint32_t>(entry + 8);
+    const std::uint32_t event = get<std::uint32_t>(entry + 16);
+    const std::uint64_t end = offset + chunk_header_size + compressed_size;
+    if (offset < header_size_ || end > index_offset) {
+      return false;
+    }
+    if (events.empty() || event != current_event) {
+      events.push_back({offset, end - offset});
+      current_event = event;
+    } else {
+      events.back().size = end - events.back().offset;
+    }
+    last_chunk = offset;
+  }
+  /* The output flushes an unfinished event when it is destroyed, then the
+   * last chunk does not end with the 'f' block. */
+  if (!events.empty()) {
+    std::vector<char> records;
+    if (decompress(last_chunk, records) == 0) {
+      return false;
+    }
+    if (!ends_event(records)) {
+      events.pop_back();
+    }
+  }
+  events_ = std::move(events);
+  return true;
+}
+
+std::uint64_t BinaryReader::decompress(std::uint64_t offset,
+                                       std::vector<char> &records) const {
+  if (offset + chunk_header_size > size_ || data_[offset] != 'c') {
+    return 0;
+  }
+  const auto codec = static_cast<BinaryCompression>(data_[offset + 1]);
+  const std::uint32_t compressed_size = get<std::uint32_t>(data_ + offset + 2);
+  const std::uint32_t uncompressed_size =
+      get<std::uint32_t>(data_ + offset + 6);
+  if (compressed_size > size_ - offset - chunk_header_size) {
+    return 0;
+  }
+  const std::size_t start = records.size();
+  records.resize(start + uncompressed_size);
+  decompress_chunk(codec, data_ + offset + chunk_header_size, compressed_size,
+                   records.data() + start, uncompressed_size);
+  return chunk_header_size + compressed_size;
+}
+
+void BinaryReader::scan_chunks() {
+  std::uint64_t event_start = header_size_;
+  std::uint64_t position = header_size_;
+  std::vector<char> records;
+  while (position < size_) {
+    records.clear();
+    const std::uint64_t size = decompress(position, records);
+    if (size == 0) {
+      // The last chunk is incomplete, or the chunk index follows.
+      break;
+    }
+    position += size;
+    if (ends_event(records)) {
+      events_.push_back({event_start, position - event_start});
+      event_start = position;
+    }
+  }
+}
+
+bool BinaryReader::ends_event(const std::vector<char> &records) const {
+  // Only the last chunk of an event contains its 'f' block, at the end.
+  bool event_end = false;
+  std::size_t i = 0;
+  while (i < records.size()) {
+    const std::size_t block = block_size(&records[i], records.size() - i);
+    if (block == 0) {
+      throw std::runtime_error("Incomplete block in a chunk of " +
+                               path_.string() + ".");
+    }
+    event_end = records[i] == 'f';
+    i += block;
+  }
+  return event_end;
+}
+
+void BinaryReader::parse_event(const char *data, std::size_t size,
+                               BinaryEvent &event) const {
+  const std::runtime_error corrupt("Corrupt event " +
+                                   std::to_string(event.index_) + " in " +
+                                   path_.string() + ".");
+  std::size_t i = 0;
+  while (i < size) {
+    const char *block = data + i;
+    const std::size_t length = block_size(block, size - i);
+    if (length == 0) {
+      throw corrupt;
+    }
+    i += length;
+    if (block[0] == 'f') {
+      if (i != size) {
+        throw corrupt;
+      }
+      event.number_ = get<std::int32_t>(block + 1);
+      event.impact_parameter_ = get<double>(block + 5);
+      event.empty_event_ = block[13] != 0;
+      return;
+    }
+    BinaryBlock result{};
+    result.type = block[0];
+    if (block[0] == 'p') {
+      result.particles = {block + 5, get<std::uint32_t>(block + 1), extended_};
+    } else {
+      const std::uint32_t n_in = get<std::uint32_t>(block + 1);
+      const std::uint32_t n_out = get<std::uint32_t>(block + 5);
+      result.density = get<double>(block + 9);
+      result.total_weight = get<double>(block + 17);
+      result.partial_weight = get<double>(block + 25);
+      result.process_type = get<std::uint32_t>(block + 33);
+      const char *lines = block + interaction_header_size;
+      result.incoming = {lines, n_in, extended_};
+      result.outgoing = {
+          lines + n_in * (extended_ ? BinaryParticleView::extended_size
+                                    : BinaryParticleView::size),
+          n_out, extended_};
+    }
+    event.blocks_.push_back(result);
+  }
+  throw corrupt;
+}
+
+BinaryEvent BinaryReader::event(std::size_t k) const {
+  if (k >= events_.size()) {
+    throw std::out_of_range("Event " + std::to_string(k) + " of " +
+                            path_.string() + " does not exist.");
+  }
+  const EventRange &range = events_[k];
+  BinaryEvent event;
+  event.index_ = k;
+  if (!compressed_) {
+    parse_event(data_ + range.offset, range.size, event);
+    return event;
+  }
+  auto records = std::make_shared<std::vector<char>>();
+  std::uint64_t position = range.offset;
+  const std::uint64_t end = range.offset + range.size;
+  while (position < end) {
+    const std::uint64_t size = decompress(position, *records);
+    if (size == 0 || size > end - position) {
+      throw std::runtime_error("Corrupt chunk of event " + std::to_string(k) +
+                               " in " + path_.string() + ".");
+    }
+    position += size;
+  }
+  parse_event(records->data(), records->size(), event);
+  event.records_ = std::move(records);
+  return event;
+}
+
+void BinaryReader::for_each_event(
+    const std::function<void(const BinaryEvent &)> &function,
+    int n_threads) const {
+  if (events_.size() > std::numeric_limits<int>::max()) {
+    throw std::overflow_error("Too many events in " + path_.string() + ".");
+  }
+  ThreadPool pool(n_threads);
+  pool.parallel_for(static_cast<int>(events_.size()),
+                    [&](int k) { function(event(k)); });
+}
+
+}  // namespace smash
@@ -0,0 +1,261 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/columnaroutput.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "smash/clock.h"
+#include "smash/config.h"
+#include "smash/particles.h"
+
+namespace smash {
+
+/*!\Userguide
+ * \page doxypage_output_columnar
+ * The columnar output writes the same particle lists as the
+ * \ref doxypage_output_binary "binary particles output", but each list is
+ * stored as one array per property of the particles instead of one record
+ * per particle. An analysis which needs only a few properties, e.g. the
+ * momenta of pions, reads only those arrays. The file is meant to be mapped
+ * into memory: all arrays start at multiples of 64 bytes, such that they can
+ * be used in place with vector instructions. The header-only reader
+ * \c smash/columnarreader.h does this and can be used without linking to
+ * SMASH.
+ *
+ * The output is written to the \c particles_columnar.bin file when
+ * \c "Columnar" is among the formats of the \c Particles content. The
+ * \key Extended and \key Only_Final options of the \c Particles content are
+ * respected. All numbers are stored in the byte order of the machine running
+ * SMASH.
+ *
+ * **Header** (64 bytes)
+ * \code
+ * 8*char  uint32_t       uint32_t  uint64_t     uint64_t    32*char
+ * magic   format_version n_columns table_offset n_snapshots smash_version
+ * \endcode
+ * \li \c magic reads "SMASHCOL" in ASCII.
+ * \li \c format_version is currently 1.
+ * \li \c table_offset and \c n_snapshots locate the snapshot table.
+ * \li \c smash_version is padded with zeros.
+ *
+ * **Column descriptors** (32 bytes each) follow the header:
+ * \code
+ * 24*char  uint32_t  uint32_t
+ * name     type      element_size
+ * \endcode
+ * \li \c name is padded with zeros.
+ * \li \c type is 0 for double (8 bytes) and 1 for int32_t (4 bytes).
+ *
+ * The columns are \c t, \c x, \c y, \c z, \c mass, \c p0, \c px, \c py,
+ * \c pz, \c pdg, \c id and \c charge. The extended output adds \c ncoll,
+ * \c form_time, \c xsecfac, \c proc_id_origin, \c proc_type_origin,
+ * \c time_last_coll, \c pdg_mother1, \c pdg_mother2 and \c baryon_number,
+ * see \ref doxypage_output_binary for their meaning.
+ *
+ * **Snapshots** start at the first multiple of 64 bytes after the
+ * descriptors. A snapshot of n particles contains the columns in the order of
+ * the descriptors, each an array of n elements, padded with zeros to a
+ * multiple of 64 bytes.
+ *
+ * **Snapshot table** (40 bytes per snapshot) at \c table_offset, which is a
+ * multiple of 64:
+ * \code
+ * uint64_t uint64_t    int32_t uint32_t double           uint32_t    uint32_t
+ * offset   n_particles event   kind     impact_parameter empty_event 0
+ * \endcode
+ * \li \c offset is the position of the first column of the snapshot.
+ * \li \c kind is 0 at event start, 1 at an intermediate time and 2 at event
+ * end.
+ * \li \c empty_event is 1 if there was no interaction between projectile and
+ * target, 0 otherwise.
+ *
+ * The table and the header are completed when SMASH finishes, before the
+ * file is renamed from \c particles_columnar.bin.unfinished.
+ */
+
+namespace {
+/**
+ * Descriptor of a column.
+ *
+ * \param[in] name Name of the column, at most 23 characters
+ * \param[in] type Type of the elements
+ * \return The descriptor.
+ */
+columnar::ColumnDescriptor describe(const char *name,
+                                    columnar::ColumnType type) {
+  columnar::ColumnDescriptor column{};
+  std::strncpy(column.name, name, sizeof(column.name) - 1);
+  column.type = type;
+  column.element_size = type == columnar::ColumnType::Float64 ? 8 : 4;
+  return column;
+}
+}  // unnamed namespace
+
+ColumnarOutput::ColumnarOutput(const std::filesystem::path &path,
+                               std::string name,
+                               const OutputParameters &out_par)
+    : OutputInterface(name),
+      file_{path / "particles_columnar.bin", "wb"},
+      extended_(out_par.part_extended),
+      only_final_(out_par.part_only_final) {
+  constexpr auto f64 = columnar::ColumnType::Float64;
+  constexpr auto i32 = columnar::ColumnType::Int32;
+  // The order must be the same as in write_snapshot.
+  const std::pair<const char *, columnar::ColumnType> columns[] = {
+      {"t", f64},
+      {"x", f64},
+      {"y", f64},
+      {"z", f64},
+      {"mass", f64},
+      {"p0", f64},
+      {"px", f64},
+      {"py", f64},
+      {"pz", f64},
+      {"pdg", i32},
+      {"id", i32},
+      {"charge", i32},
+      {"ncoll", i32},
+      {"form_time", f64},
+      {"xsecfac", f64},
+      {"proc_id_origin", i32},
+      {"proc_type_origin", i32},
+      {"time_last_coll", f64},
+      {"pdg_mother1", i32},
+      {"pdg_mother2", i32},
+      {"baryon_number", i32}};
+  const std::size_t n_columns = extended_ ? 21 : 12;
+  for (std::size_t i = 0; i < n_columns; i++) {
+    columns_.push_back(describe(columns[i].first, columns[i].second));
+  }
+
+  // The table offset and number of snapshots are filled in at the end.
+  std::memcpy(header_.magic, columnar::magic_number, sizeof(header_.magic));
+  header_.format_version = columnar::format_version;
+  header_.n_columns = static_cast<std::uint32_t>(columns_.size());
+  std::strncpy(header_.smash_version, SMASH_VERSION,
+               sizeof(header_.smash_version));
+  write(&header_, sizeof(header_));
+  write(columns_.data(), columns_.size() * sizeof(columnar::ColumnDescriptor));
+  write_padding();
+}
+
+ColumnarOutput::~ColumnarOutput() {
+  try {
+    write_padding();
+    header_.table_offset = offset_;
+    header_.n_snapshots = snapshots_.size();
+    write(snapshots_.data(),
+          snapshots_.size() * sizeof(columnar::SnapshotEntry));
+    if (std::fseek(file_.get(), 0, SEEK_SET) != 0) {
+      throw std::runtime_error(std::string("Could not seek: ") +
+                               std::strerror(errno));
+    }
+    write(&header_, sizeof(header_));
+  } catch (std::exception &e) {
+    logg[LOutput].error("Writing the columnar output failed: ", e.what());
+  }
+}
+
+void ColumnarOutput::at_eventstart(const Particles &particles,
+                                   const int event_number,
+                                   const EventInfo &event) {
+  event_number_ = event_number;
+  if (only_final_ == OutputOnlyFinal::No) {
+    write_snapshot(particles, columnar::SnapshotKind::EventStart, event);
+  }
+}
+
+void ColumnarOutput::at_eventend(const Particles &particles,
+                                 const int event_number,
+                                 const EventInfo &event) {
+  event_number_ = event_number;
+  if (!(event.empty_event && only_final_ == OutputOnlyFinal::IfNotEmpty)) {
+    write_snapshot(particles, columnar::SnapshotKind::EventEnd, event);
+  }
+  std::fflush(file_.get());
+}
+
+void ColumnarOutput::at_intermediate_time(const Particles &particles,
+                                          const std::unique_ptr<Clock> &,
+                                          const DensityParameters &,
+                                          const EventInfo &event) {
+  if (only_final_ == OutputOnlyFinal::No) {
+    write_snapshot(particles, columnar::SnapshotKind::Intermediate, event);
+  }
+}
+
+void ColumnarOutput::write_snapshot(const Particles &particles,
+                                    columnar::SnapshotKind kind,
+                                    const EventInfo &event) {
+  const std::uint64_t n_particles = particles.size();
+  const std::vector<std::uint64_t> offsets = columnar::column_offsets(
+      columns_.data(), static_cast<std::uint32_t>(columns_.size()),
+      n_particles);
+  // Zeros for the padding after each column
+  buffer_.assign(offsets.back(), 0);
+  std::size_t i = 0;
+  for (const ParticleData &p : particles) {
+    std::size_t column = 0;
+    auto put = [&](auto value) {
+      std::memcpy(buffer_.data() + offsets[column] + i * sizeof(value), &value,
+                  sizeof(value));
+      column++;
+    };
+    const FourVector &x = p.position();
+    const FourVector &mom = p.momentum();
+    put(x.x0());
+    put(x.x1());
+    put(x.x2());
+    put(x.x3());
+    put(p.effective_mass());
+    put(mom.x0());
+    put(mom.x1());
+    put(mom.x2());
+    put(mom.x3());
+    put(static_cast<std::int32_t>(p.pdgcode().get_decimal()));
+    put(static_cast<std::int32_t>(p.id()));
+    put(static_cast<std::int32_t>(p.type().charge()));
+    if (extended_) {
+      const HistoryData history = p.get_history();
+      put(static_cast<std::int32_t>(history.collisions_per_particle));
+      put(p.formation_time());
+      put(p.xsec_scaling_factor());
+      put(static_cast<std::int32_t>(history.id_process));
+      put(static_cast<std::int32_t>(history.process_type));
+      put(history.time_last_collision);
+      put(static_cast<std::int32_t>(history.p1.get_decimal()));
+      put(static_cast<std::int32_t>(history.p2.get_decimal()));
+      put(static_cast<std::int32_t>(p.type().baryon_number()));
+    }
+    i++;
+  }
+  snapshots_.push_back({offset_, n_particles, event_number_, kind,
+                        event.impact_parameter,
+                        static_cast<std::uint32_t>(event.empty_event), 0});
+  write(buffer_.data(), buffer_.size());
+}
+
+void ColumnarOutput::write(const void *data, std::size_t size) {
+  if (size > 0 && std::fwrite(data, 1, size, file_.get()) != size) {
+    throw std::runtime_error(std::string("Could not write columnar output: ") +
+                             std::strerror(errno));
+  }
+  offset_ += size;
+}
+
+void ColumnarOutput::write_padding() {
+  static const char zeros[columnar::alignment] = {};
+  write(zeros, columnar::align(offset_) - offset_);
+}
+
+}  // namespace smash
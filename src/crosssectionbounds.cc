@@ -0,0 +1,141 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/crosssectionbounds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "smash/constants.h"
+#include "smash/particletype.h"
+#include "smash/random.h"
+
+namespace smash {
+
+CrossSectionBounds::CrossSectionBounds(CrossSectionFunction cross_section)
+    : cross_section_(std::move(cross_section)) {
+  const ParticleTypeList &all_types = ParticleType::list_all();
+  stable_index_.reserve(all_types.size());
+  int n_stable = 0;
+  for (const ParticleType &type : all_types) {
+    stable_index_.push_back(type.is_stable() ? n_stable++ : -1);
+  }
+  n_pairs_ = static_cast<std::size_t>(n_stable) * (n_stable + 1) / 2;
+  pair_bins_ = std::make_unique<std::atomic<std::atomic<double> *>[]>(n_pairs_);
+  for (std::size_t i = 0; i < n_pairs_; i++) {
+    pair_bins_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+CrossSectionBounds::~CrossSectionBounds() {
+  for (std::size_t i = 0; i < n_pairs_; i++) {
+    delete[] pair_bins_[i].load(std::memory_order_relaxed);
+  }
+}
+
+int CrossSectionBounds::stable_index(const ParticleType &type) const {
+  const std::size_t i = std::addressof(type) - ParticleType::list_all().data();
+  return i < stable_index_.size() ? stable_index_[i] : -1;
+}
+
+double CrossSectionBounds::upper_bound(const ParticleData &data_a,
+                                       const ParticleData &data_b) const {
+  constexpr double no_bound = std::numeric_limits<double>::infinity();
+  const ParticleType *type_a = std::addressof(data_a.type());
+  const ParticleType *type_b = std::addressof(data_b.type());
+  int index_a = stable_index(*type_a);
+  int index_b = stable_index(*type_b);
+  if (index_a < 0 || index_b < 0 ||
+      std::abs(data_a.effective_mass() - type_a->mass()) > really_small ||
+      std::abs(data_b.effective_mass() - type_b->mass()) > really_small) {
+    return no_bound;
+  }
+  const double threshold = type_a->mass() + type_b->mass();
+  const double sqrts_above_threshold =
+      (data_a.momentum() + data_b.momentum()).abs() - threshold;
+  if (!(sqrts_above_threshold >= 0.)) {
+    return no_bound;
+  }
+  const auto bin = static_cast<std::size_t>(sqrts_above_threshold / bin_width);
+  if (bin >= n_bins) {
+    return no_bound;
+  }
+
+  // A pair and the swapped pair share their bins.
+  if (index_a > index_b) {
+    std::swap(index_a, index_b);
+    std::swap(type_a, type_b);
+  }
+  std::atomic<std::atomic<double> *> &slot =
+      pair_bins_[static_cast<std::size_t>(index_b) * (index_b + 1) / 2 +
+                 index_a];
+  std::atomic<double> *bins = slot.load(std::memory_order_acquire);
+  if (!bins) {
+    std::unique_ptr<std::atomic<double>[]> new_bins(
+        new std::atomic<double>[n_bins]);
+    for (std::size_t i = 0; i < n_bins; i++) {
+      new_bins[i].store(-1., std::memory_order_relaxed);
+    }
+    // Another thread may have been faster, then its bins are used.
+    if (slot.compare_exchange_strong(bins, new_bins.get(),
+                                     std::memory_order_acq_rel)) {
+      bins = new_bins.release();
+    }
+  }
+  double bound = bins[bin].load(std::memory_order_relaxed);
+  if (bound < 0.) {
+    /* Threads evaluating the same bin at the same time store the same value,
+     * since the evaluation does not depend on anything else. */
+    bound = evaluate_bin(*type_a, *type_b, threshold + bin * bin_width);
+    bins[bin].store(bound, std::memory_order_relaxed);
+  }
+  return bound;
+}
+
+double CrossSectionBounds::evaluate_bin(const ParticleType &type_a,
+                                        const ParticleType &type_b,
+                                        double sqrts_min) const {
+  /* The cross sections must not take random numbers from the simulation,
+   * otherwise its outcome would depend on which bins are evaluated first. */
+  random::Stream stream;
+  random::StreamScope stream_scope(stream);
+  // Exactly at the threshold the particles would be at rest.
+  const double sqrts_first =
+      std::max(sqrts_min, type_a.mass() + type_b.mass() + really_small);
+  const double sqrts_max = sqrts_min + bin_width;
+  std::vector<double> sample_points;
+  sample_points.reserve(n_samples + 1);
+  for (int i = 0; i <= n_samples; i++) {
+    sample_points.push_back(
+        std::max(sqrts_min + i * bin_width / n_samples, sqrts_first));
+  }
+  /* Resonances formed by the pair peak at their pole mass, which can be much
+   * narrower than the distance between two samples. */
+  for (const ParticleType &resonance : ParticleType::list_all()) {
+    if (resonance.mass() > sqrts_first && resonance.mass() < sqrts_max) {
+      sample_points.push_back(resonance.mass());
+    }
+  }
+  double max_cross_section = 0.;
+  for (const double sqrts : sample_points) {
+    const double cross_section = cross_section_(type_a, type_b, sqrts);
+    if (!(cross_section <= max_cross_section)) {
+      // Also catches NaN, which makes the bound infinite.
+      max_cross_section = std::isnan(cross_section)
+                              ? std::numeric_limits<double>::infinity()
+                              : cross_section;
+    }
+  }
+  return safety_factor * max_cross_section;
+}
+
+}  // namespace smash
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2020,2022
+ *    Copyright (c) 2014-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -9,6 +9,8 @@
 
 #include "smash/decayactionsfinder.h"
 
+#include <limits>
+
 #include "smash/constants.h"
 #include "smash/decayaction.h"
 #include "smash/decaymodes.h"
@@ -30,36 +32,31 @@ ActionList DecayActionsFinder::find_actions_in_cell(
       continue;  // particle doesn't decay
     }
 
-    DecayBranchList processes = p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Hadronic);
-    // total decay width (mass-dependent)
-    const double width = total_weight<DecayBranch>(processes);
-
-    // check if there are any (hadronic) decays
-    if (!(width > 0.0)) {
-      continue;
-    }
+    /* Use the decay time sampled once by schedule_decays, unless it has
+     * passed without the particle decaying. */
+    double decay_time = p.scheduled_decay_time() - p.position().x0();
+    if (!(decay_time >= 0.)) {
+      /* total decay width (mass-dependent), the branches are only needed for
+       * the few particles that decay in this time step */
+      const double width = p.type().get_total_width(
+          p.momentum(), p.position().threevec(), WhichDecaymodes::Hadronic,
+          tabulated_widths_);
 
-    constexpr double one_over_hbarc = 1. / hbarc;
-
-    /* The decay_time is sampled from an exponential distribution.
-     * Even though it may seem suspicious that it is sampled every
-     * timestep, it can be proven that this still overall obeys
-     * the exponential decay law.
-     */
-    double decay_time =
-        res_lifetime_factor_ * random::exponential<double>(
-                                   /* The clock goes slower in the rest
-                                    * frame of the resonance */
-                                   one_over_hbarc * p.inverse_gamma() * width);
-    /* If the particle is not yet formed, shift the decay time by the time it
-     * takes the particle to form */
-    if (p.xsec_scaling_factor() < 1.0) {
-      decay_time += p.formation_time() - p.position().x0();
+      // check if there are any (hadronic) decays
+      if (!(width > 0.0)) {
+        continue;
+      }
+      decay_time = sample_decay_time(p, width);
     }
     if (decay_time < dt) {
       /* => decay_time ∈ [0, dt[
        * => the particle decays in this timestep. */
+      DecayBranchList processes = p.type().get_partial_widths(
+          p.momentum(), p.position().threevec(), WhichDecaymodes::Hadronic);
+      // The tabulated width may be positive just below a threshold
+      if (processes.empty()) {
+        continue;
+      }
       auto act = std::make_unique<DecayAction>(p, decay_time);
       act->add_decays(std::move(processes));
       actions.emplace_back(std::move(act));
@@ -68,6 +65,44 @@ ActionList DecayActionsFinder::find_actions_in_cell(
   return actions;
 }
 
+void DecayActionsFinder::schedule_decays(Particles &particles) const {
+  for (ParticleData &p : particles) {
+    if (p.type().is_stable() ||
+        p.scheduled_decay_time() >= p.position().x0()) {
+      continue;
+    }
+    const double width = p.type().get_total_width(
+        p.momentum(), p.position().threevec(), WhichDecaymodes::Hadronic,
+        tabulated_widths_);
+    // Without hadronic decays the particle does not decay at this momentum
+    p.schedule_decay(width > 0.
+                         ? p.position().x0() + sample_decay_time(p, width)
+                         : std::numeric_limits<double>::infinity());
+  }
+}
+
+double DecayActionsFinder::sample_decay_time(const ParticleData &p,
+                                             double width) const {
+  constexpr double one_over_hbarc = 1. / hbarc;
+
+  /* The decay_time is sampled from an exponential distribution.
+   * Even though it may seem suspicious that it is sampled every
+   * timestep, it can be proven that this still overall obeys
+   * the exponential decay law.
+   */
+  double decay_time =
+      res_lifetime_factor_ * random::exponential<double>(
+                                 /* The clock goes slower in the rest
+                                  * frame of the resonance */
+                                 one_over_hbarc * p.inverse_gamma() * width);
+  /* If the particle is not yet formed, shift the decay time by the time it
+   * takes the particle to form */
+  if (p.xsec_scaling_factor() < 1.0) {
+    decay_time += p.formation_time() - p.position().x0();
+  }
+  return decay_time;
+}
+
 ActionList DecayActionsFinder::find_final_actions(const Particles &search_list,
                                                   bool /*only_res*/) const {
   ActionList actions;
@@ -140,12 +140,12 @@ double TwoBodyDecaySemistable::get_Lambda() {
 
 /// Number of tabulation points.
 constexpr size_t num_tab_pts = 200;
-static /*thread_local (see #3075)*/ Integrator integrate;
+static thread_local Integrator integrate;
 
 double TwoBodyDecaySemistable::rho(double mass) const {
   if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
+    /* Multi-threaded runs fill this beforehand via
+     * ParticleType::precompute_lazy_properties, to avoid race conditions. */
     const ParticleTypePtr res = particle_types_[1];
     const double tabulation_interval = std::max(2., 10. * res->width_at_pole());
     const double m_stable = particle_types_[0]->mass();
@@ -194,12 +194,12 @@ double TwoBodyDecayUnstable::get_Lambda() {
   return 0.6;
 }
 
-static /*thread_local*/ Integrator2d integrate2d(1E7);
+static thread_local Integrator2d integrate2d(1E7);
 
 double TwoBodyDecayUnstable::rho(double mass) const {
   if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
+    /* Multi-threaded runs fill this beforehand via
+     * ParticleType::precompute_lazy_properties, to avoid race conditions. */
     const ParticleTypePtr r1 = particle_types_[0];
     const ParticleTypePtr r2 = particle_types_[1];
     const double m1_min = r1->min_mass_kinematic();
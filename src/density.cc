@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2013-2022
+ *    Copyright (c) 2013-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -61,6 +61,73 @@ std::pair<double, ThreeVector> unnormalized_smearing_factor(
   return std::make_pair(sf, sf_grad);
 }
 
+void GaussianSmearingTable::prepare(const std::array<int, 3> &lower_bounds,
+                                    const std::array<int, 3> &upper_bounds,
+                                    const std::array<double, 3> &origin,
+                                    const std::array<double, 3> &cell_sizes,
+                                    const ThreeVector &pos, const FourVector &p,
+                                    double m_inv,
+                                    const DensityParameters &dens_par) {
+  lower_bounds_ = lower_bounds;
+  for (int i = 0; i < 3; i++) {
+    n_[i] = std::max(upper_bounds[i] - lower_bounds[i], 0);
+  }
+  cell_sizes_ = cell_sizes;
+  for (int i = 0; i < 3; i++) {
+    distances_[i].resize(n_[i]);
+    for (int j = 0; j < n_[i]; j++) {
+      // the same as pos - RectangularLattice::cell_center
+      distances_[i][j] =
+          pos[i] - (origin[i] + cell_sizes[i] * (lower_bounds[i] + j + 0.5));
+    }
+  }
+  u_ = p * m_inv;
+  r_cut_sqr_ = dens_par.r_cut_sqr();
+  two_sig_sqr_inv_ = dens_par.two_sig_sqr_inv();
+  /* The exponent is -(r^2 + (u r)^2) / (2 sigma^2), whose second difference
+   * along x is constant. */
+  const double ux = u_.x1();
+  second_ratio_ = std::exp(-2. * (1. + ux * ux) * cell_sizes_[0] *
+                           cell_sizes_[0] * two_sig_sqr_inv_);
+  exponentials_.resize(static_cast<std::size_t>(n_[0]) * n_[1] * n_[2]);
+  row_ready_.assign(static_cast<std::size_t>(n_[1]) * n_[2], false);
+}
+
+void GaussianSmearingTable::tabulate_row(int jy, int jz) {
+  const double ry = distances_[1][jy];
+  const double rz = distances_[2][jz];
+  const double r_perp_sqr = ry * ry + rz * rz;
+  const double ux = u_.x1();
+  const double u_r_perp = u_.x2() * ry + u_.x3() * rz;
+  auto exponent = [&](int jx) {
+    const double rx = distances_[0][0] - cell_sizes_[0] * jx;
+    const double u_r_scalar = ux * rx + u_r_perp;
+    return -(rx * rx + r_perp_sqr + u_r_scalar * u_r_scalar) *
+           two_sig_sqr_inv_;
+  };
+
+  // start at the cell closest to the maximum of the exponent
+  const double rx_max = -ux * u_r_perp / (1. + ux * ux);
+  const double jx_max_real = (distances_[0][0] - rx_max) / cell_sizes_[0];
+  const int jx_max = std::lround(
+      std::clamp(jx_max_real, 0., static_cast<double>(n_[0] - 1)));
+  double *row = &exponentials_[static_cast<std::size_t>(n_[0]) *
+                               (jy + static_cast<std::size_t>(n_[1]) * jz)];
+  const double exponent_max = exponent(jx_max);
+  row[jx_max] = std::exp(exponent_max);
+  double ratio = std::exp(exponent(jx_max + 1) - exponent_max);
+  for (int jx = jx_max + 1; jx < n_[0]; jx++) {
+    row[jx] = row[jx - 1] * ratio;
+    ratio *= second_ratio_;
+  }
+  ratio = std::exp(exponent(jx_max - 1) - exponent_max);
+  for (int jx = jx_max - 1; jx >= 0; jx--) {
+    row[jx] = row[jx + 1] * ratio;
+    ratio *= second_ratio_;
+  }
+  row_ready_[jy + static_cast<std::size_t>(n_[1]) * jz] = true;
+}
+
 /// \copydoc smash::current_eckart
 template <typename /*ParticlesContainer*/ T>
 std::tuple<double, FourVector, ThreeVector, ThreeVector, FourVector, FourVector,
@@ -191,34 +258,41 @@ void update_lattice(
     const LatticeUpdate update, const DensityType dens_type,
     const DensityParameters &par, const std::vector<Particles> &ensembles,
     const double time_step, const bool compute_gradient) {
-  // Do not proceed if lattice does not exists/update not required
-  if (lat == nullptr || lat->when_update() != update) {
-    return;
-  }
-  const std::array<int, 3> lattice_n_cells = lat->n_cells();
-  const int number_of_nodes =
-      lattice_n_cells[0] * lattice_n_cells[1] * lattice_n_cells[2];
-
-  /*
-   * Take the provided DensityOnLattice lattice and use the information about
-   * the current to create a lattice of current FourVectors. Because the lattice
-   * hasn't been updated at this point yet, it provides the t_0 time step
-   * information on the currents.
-   */
-  // copy values of jmu at t_0 onto old_jmu;
-  // proceed only if finite difference gradients are calculated
-  if (par.derivatives() == DerivativesMode::FiniteDifference) {
-    for (int i = 0; i < number_of_nodes; i++) {
-      old_jmu->assign_value(i, ((*lat)[i]).jmu_net());
-    }
-  }
-
-  update_lattice(lat, update, dens_type, par, ensembles, compute_gradient);
+  update_lattices({{lat, dens_type, true}}, old_jmu, new_jmu,
+                  four_grad_lattice, update, par, ensembles, time_step,
+                  compute_gradient);
+}  // void update_lattice()
 
+namespace {
+/**
+ * Calculate the derivatives on a freshly updated lattice of DensityOnLattice
+ * type, which are not obtained directly from the smearing.
+ *
+ * \param[out] lat The lattice whose derivatives are calculated
+ * \param[in] jmu_at_t0 Net currents on the lattice at t0, before the update.
+ *            Only used for finite difference derivatives.
+ * \param[in] old_jmu Auxiliary lattice, filled with current values at t0
+ * \param[in] new_jmu Auxiliary lattice, filled with current values at
+ *            t0 + dt
+ * \param[in] four_grad_lattice Auxiliary lattice for calculating the
+ *            fourgradient of the current
+ * \param[in] par a structure containing the derivatives modes
+ * \param[in] time_step Time step used in the simulation
+ */
+void compute_lattice_derivatives(
+    RectangularLattice<DensityOnLattice> *lat,
+    const std::vector<FourVector> &jmu_at_t0,
+    RectangularLattice<FourVector> *old_jmu,
+    RectangularLattice<FourVector> *new_jmu,
+    RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
+    const DensityParameters &par, const double time_step) {
+  const int number_of_nodes = lat->size();
   // calculate the gradients for finite difference derivatives
   if (par.derivatives() == DerivativesMode::FiniteDifference) {
-    // copy values of jmu FourVectors at t_0 + time_step onto new_jmu
+    // copy values of jmu FourVectors at t_0 and t_0 + time_step onto old_jmu
+    // and new_jmu
     for (int i = 0; i < number_of_nodes; i++) {
+      old_jmu->assign_value(i, jmu_at_t0[i]);
       new_jmu->assign_value(i, ((*lat)[i]).jmu_net());
     }
 
@@ -275,7 +349,77 @@ void update_lattice(
       node.overwrite_drho_dxnu(drho_dxnu);
     }
   }  // if (par.rho_derivatives() == RestFrameDensityDerivatives::On){
-}  // void update_lattice()
+}
+}  // namespace
+
+void update_lattices(
+    const std::vector<DensityLatticeTarget> &targets,
+    RectangularLattice<FourVector> *old_jmu,
+    RectangularLattice<FourVector> *new_jmu,
+    RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
+    const LatticeUpdate update, const DensityParameters &par,
+    const std::vector<Particles> &ensembles, const double time_step,
+    const bool compute_gradient, ThreadPool *pool) {
+  std::vector<std::pair<RectangularLattice<DensityOnLattice> *, DensityType>>
+      lattices;
+  // lattices whose derivatives are calculated after the update
+  std::vector<RectangularLattice<DensityOnLattice> *> with_derivatives;
+  // their net currents at t_0, one vector per lattice
+  std::vector<std::vector<FourVector>> jmu_at_t0;
+  for (const DensityLatticeTarget &target : targets) {
+    // Skip lattices which do not exist/need no update
+    if (target.lattice == nullptr || target.lattice->when_update() != update) {
+      continue;
+    }
+    lattices.emplace_back(target.lattice, target.dens_type);
+    if (!target.derivatives) {
+      continue;
+    }
+    with_derivatives.push_back(target.lattice);
+    /*
+     * Because the lattice hasn't been updated at this point yet, it provides
+     * the t_0 time step information on the currents, which is needed for the
+     * finite difference gradients.
+     */
+    jmu_at_t0.emplace_back();
+    if (par.derivatives() == DerivativesMode::FiniteDifference) {
+      jmu_at_t0.back().reserve(target.lattice->size());
+      for (const DensityOnLattice &node : *target.lattice) {
+        jmu_at_t0.back().push_back(node.jmu_net());
+      }
+    }
+  }
+
+  update_lattices(lattices, update, par, ensembles, compute_gradient, pool);
+
+  for (std::size_t k = 0; k < with_derivatives.size(); k++) {
+    compute_lattice_derivatives(with_derivatives[k], jmu_at_t0[k], old_jmu,
+                                new_jmu, four_grad_lattice, par, time_step);
+  }
+}
+
+void repeat_lattice_update(
+    RectangularLattice<DensityOnLattice> *lat,
+    RectangularLattice<FourVector> *old_jmu,
+    RectangularLattice<FourVector> *new_jmu,
+    RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
+    const LatticeUpdate update, const DensityParameters &par,
+    const double time_step) {
+  // Do not proceed if lattice does not exists/update not required
+  if (lat == nullptr || lat->when_update() != update) {
+    return;
+  }
+  // the currents at t_0 are those the lattice has already
+  std::vector<FourVector> jmu_at_t0;
+  if (par.derivatives() == DerivativesMode::FiniteDifference) {
+    jmu_at_t0.reserve(lat->size());
+    for (const DensityOnLattice &node : *lat) {
+      jmu_at_t0.push_back(node.jmu_net());
+    }
+  }
+  compute_lattice_derivatives(lat, jmu_at_t0, old_jmu, new_jmu,
+                              four_grad_lattice, par, time_step);
+}
 
 std::ostream &operator<<(std::ostream &os, DensityType dens_type) {
   switch (dens_type) {
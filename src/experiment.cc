@@ -20,7 +20,8 @@ namespace smash {
 
 /* ExperimentBase carries everything that is needed for the evolution */
 ExperimentPtr ExperimentBase::create(Configuration &config,
-                                     const std::filesystem::path &output_path) {
+                                     const std::filesystem::path &output_path,
+                                     int n_event_threads) {
   if (!std::filesystem::exists(output_path)) {
     throw NonExistingOutputPathRequest("The requested output path (" +
                                        output_path.string() +
@@ -31,22 +32,87 @@ ExperimentPtr ExperimentBase::create(Configuration &config,
   const std::string modus_chooser = config.read({"General", "Modus"});
   logg[LExperiment].debug() << "Modus for this calculation: " << modus_chooser;
 
+  if (n_event_threads < 1) {
+    throw std::invalid_argument("At least one event thread is needed, " +
+                                std::to_string(n_event_threads) +
+                                " were requested.");
+  }
+  if (n_event_threads > 1) {
+    /* Events can only be evolved concurrently if they do not depend on each
+     * other, apart from the random seed. */
+    auto refuse = [](const std::string &reason) {
+      throw std::invalid_argument("Events cannot be evolved concurrently " +
+                                  reason + ".");
+    };
+    if (modus_chooser == "List" || modus_chooser == "ListBox") {
+      refuse("in the " + modus_chooser +
+             " modus, which reads them one after the other from files");
+    }
+    if (config.has_value({"Modi", "Collider", "Projectile", "Custom"}) ||
+        config.has_value({"Modi", "Collider", "Target", "Custom"})) {
+      refuse("with custom nuclei, which are read one after the other from "
+             "files");
+    }
+    if (config.has_value({"General", "Minimum_Nonempty_Ensembles"})) {
+      refuse("if their number depends on the result of the previous events");
+    }
+    if (config.has_value({"Forced_Thermalization"})) {
+      refuse("with forced thermalization, whose output cannot be deferred");
+    }
+  }
+
   if (modus_chooser == "Box") {
-    return std::make_unique<Experiment<BoxModus>>(config, output_path);
+    return create_experiment<BoxModus>(config, output_path, n_event_threads);
   } else if (modus_chooser == "List") {
-    return std::make_unique<Experiment<ListModus>>(config, output_path);
+    return create_experiment<ListModus>(config, output_path, n_event_threads);
   } else if (modus_chooser == "ListBox") {
-    return std::make_unique<Experiment<ListBoxModus>>(config, output_path);
+    return create_experiment<ListBoxModus>(config, output_path,
+                                           n_event_threads);
   } else if (modus_chooser == "Collider") {
-    return std::make_unique<Experiment<ColliderModus>>(config, output_path);
+    return create_experiment<ColliderModus>(config, output_path,
+                                            n_event_threads);
   } else if (modus_chooser == "Sphere") {
-    return std::make_unique<Experiment<SphereModus>>(config, output_path);
+    return create_experiment<SphereModus>(config, output_path,
+                                          n_event_threads);
   } else {
     throw InvalidModusRequest("Invalid Modus (" + modus_chooser +
                               ") requested from ExperimentBase::create.");
   }
 }
 
+template <typename Modus>
+ExperimentPtr ExperimentBase::create_experiment(
+    Configuration &config, const std::filesystem::path &output_path,
+    int n_event_threads) {
+  if (n_event_threads == 1) {
+    return std::make_unique<Experiment<Modus>>(config, output_path);
+  }
+  // The workers get their own copy of the configuration
+  const std::string worker_yaml = config.to_string();
+  auto experiment = std::make_unique<Experiment<Modus>>(config, output_path);
+  logg[LExperiment].info("Evolving ", n_event_threads,
+                         " events at the same time.");
+  /* Evaluate everything that is lazily initialized on first use, so that
+   * the threads only read the shared particle types. */
+  ParticleType::precompute_lazy_properties();
+  for (int i = 0; i < n_event_threads; i++) {
+    Configuration worker_config(worker_yaml.c_str());
+    experiment->event_workers_.emplace_back(new Experiment<Modus>(
+        worker_config, output_path, &experiment->outputs_));
+    // Unused keys are already reported for the main configuration
+    worker_config.clear();
+  }
+  return experiment;
+}
+
+int64_t draw_next_event_seed(random::Stream &stream) {
+  int64_t r = stream();
+  while (r == INT64_MIN) {
+    r = stream();
+  }
+  return std::abs(r);
+}
+
 /*!\Userguide
  * \n
  * \page doxypage_output_conf_examples
@@ -294,10 +360,25 @@ ExperimentParameters create_experiment_parameters(Configuration &config) {
       config.take({"Collision_Term", "Maximum_Cross_Section"},
                   maximum_cross_section_default);
   maximum_cross_section *= scale_xs;
+
+  const int n_ensembles = config.take({"General", "Ensembles"}, 1);
+  const int n_ensemble_threads =
+      config.take({"General", "Ensemble_Threads"}, 1);
+  if (n_ensemble_threads < 1) {
+    throw std::invalid_argument(
+        "The number of ensemble threads has to be a positive integer.");
+  }
+  if (n_ensemble_threads > n_ensembles) {
+    logg[LExperiment].warn("More ensemble threads (", n_ensemble_threads,
+                           ") than ensembles (", n_ensembles,
+                           ") requested. Superfluous threads only help "
+                           "with the density smearing for the potentials.");
+  }
   return {
       std::make_unique<UniformClock>(0.0, dt, t_end),
       std::move(output_clock),
-      config.take({"General", "Ensembles"}, 1),
+      n_ensembles,
+      n_ensemble_threads,
       ntest,
       config.take({"General", "Derivatives_Mode"},
                   DerivativesMode::CovariantGaussian),
@@ -308,6 +389,7 @@ ExperimentParameters create_experiment_parameters(Configuration &config) {
                   FieldDerivativesMode::ChainRule),
       config.take({"General", "Smearing_Mode"},
                   SmearingMode::CovariantGaussian),
+      config.take({"General", "Gaussian_Smearing_Tables"}, false),
       config.take({"General", "Gaussian_Sigma"}, 1.),
       config.take({"General", "Gauss_Cutoff_In_Sigma"}, 4.),
       config.take({"General", "Discrete_Weight"}, 1. / 3.0),
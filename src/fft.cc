@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/fft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "smash/constants.h"
+
+namespace smash {
+
+FourierTransform3D::FourierTransform3D(const std::array<int, 3> &sizes)
+    : sizes_(sizes) {
+  int longest = 0;
+  for (int n : sizes_) {
+    if (n < 1) {
+      throw std::invalid_argument("Fourier transform of size " +
+                                  std::to_string(n) + " is not possible.");
+    }
+    transforms_.emplace_back(n);
+    longest = std::max(longest, n);
+  }
+  line_.resize(longest);
+}
+
+void FourierTransform3D::forward(std::vector<std::complex<double>> &data) {
+  const int nx = sizes_[0], ny = sizes_[1], nz = sizes_[2];
+  // Lines along x are contiguous and transformed directly.
+  for (std::size_t offset = 0; offset < data.size(); offset += nx) {
+    transforms_[0].forward(&data[offset]);
+  }
+  // Lines along y and z are gathered into line_.
+  for (int iz = 0; iz < nz; iz++) {
+    for (int ix = 0; ix < nx; ix++) {
+      const std::size_t offset = ix + static_cast<std::size_t>(nx) * ny * iz;
+      for (int iy = 0; iy < ny; iy++) {
+        line_[iy] = data[offset + static_cast<std::size_t>(nx) * iy];
+      }
+      transforms_[1].forward(line_.data());
+      for (int iy = 0; iy < ny; iy++) {
+        data[offset + static_cast<std::size_t>(nx) * iy] = line_[iy];
+      }
+    }
+  }
+  const std::size_t z_stride = static_cast<std::size_t>(nx) * ny;
+  for (std::size_t offset = 0; offset < z_stride; offset++) {
+    for (int iz = 0; iz < nz; iz++) {
+      line_[iz] = data[offset + z_stride * iz];
+    }
+    transforms_[2].forward(line_.data());
+    for (int iz = 0; iz < nz; iz++) {
+      data[offset + z_stride * iz] = line_[iz];
+    }
+  }
+}
+
+void FourierTransform3D::backward(std::vector<std::complex<double>> &data) {
+  // The backward transform is the conjugate of the forward transform of the
+  // conjugated data.
+  for (std::complex<double> &value : data) {
+    value = std::conj(value);
+  }
+  forward(data);
+  const double norm = 1. / size();
+  for (std::complex<double> &value : data) {
+    value = std::conj(value) * norm;
+  }
+}
+
+int FourierTransform3D::next_fast_size(int n) {
+  for (int size = std::max(n, 1);; size++) {
+    int rest = size;
+    for (int factor : {2, 3, 5}) {
+      while (rest % factor == 0) {
+        rest /= factor;
+      }
+    }
+    if (rest == 1) {
+      return size;
+    }
+  }
+}
+
+FourierTransform3D::Transform1D::Transform1D(int n)
+    : n_(n), twiddles_(n), input_(n) {
+  int rest = n;
+  for (int factor = 2; factor * factor <= rest; factor++) {
+    while (rest % factor == 0) {
+      factors_.push_back(factor);
+      rest /= factor;
+    }
+  }
+  if (rest > 1) {
+    factors_.push_back(rest);
+  }
+  butterfly_.resize(factors_.empty() ? 1 : factors_.back());
+  for (int j = 0; j < n; j++) {
+    twiddles_[j] = std::polar(1., -twopi * j / n);
+  }
+}
+
+void FourierTransform3D::Transform1D::forward(std::complex<double> *line) {
+  std::copy(line, line + n_, input_.begin());
+  transform(input_.data(), 1, line, n_, 0);
+}
+
+void FourierTransform3D::Transform1D::transform(
+    const std::complex<double> *in, std::size_t stride,
+    std::complex<double> *out, int n, std::size_t i_factor) {
+  if (n == 1) {
+    out[0] = in[0];
+    return;
+  }
+  /* Decimation in time: transform the p interleaved subsequences of length
+   * m and combine them with p-point butterflies. */
+  const int p = factors_[i_factor];
+  const int m = n / p;
+  for (int r = 0; r < p; r++) {
+    transform(in + r * stride, stride * p, out + r * m, m, i_factor + 1);
+  }
+  // The twiddles of this length are every (n_ / n)-th twiddle of length n_.
+  const std::size_t twiddle_stride = n_ / n;
+  for (int k = 0; k < m; k++) {
+    for (int r = 0; r < p; r++) {
+      butterfly_[r] = out[r * m + k];
+    }
+    for (int q = 0; q < p; q++) {
+      const std::size_t frequency = k + static_cast<std::size_t>(q) * m;
+      std::complex<double> sum = butterfly_[0];
+      for (int r = 1; r < p; r++) {
+        sum += butterfly_[r] * twiddles_[(r * frequency) % n * twiddle_stride];
+      }
+      out[q * m + k] = sum;
+    }
+  }
+}
+
+}  // namespace smash
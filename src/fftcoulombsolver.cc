@@ -0,0 +1,195 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/fftcoulombsolver.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "smash/constants.h"
+
+namespace smash {
+
+namespace {
+/**
+ * \param[in] i index
+ * \param[in] n period
+ * \return i modulo n in [0, n).
+ */
+int wrap(int i, int n) { return (i % n + n) % n; }
+
+/**
+ * Range of the cell offsets m = target - source contributing to the field of
+ * a cell. The source cells are found with the same expressions as in
+ * RectangularLattice::iterate_in_rectangle, for a target cell at its center,
+ * such that both select the same cells also when R_cut is a multiple of the
+ * cell size. Then the cells at exactly -R_cut are included and those at
+ * +R_cut are not.
+ *
+ * \param[in] cell_size edge length of the cells along the axis [fm]
+ * \param[in] r_cut half edge length of the integration volume [fm]
+ * \param[in] n_cells number of cells along the axis
+ * \param[in] periodic whether the lattice is periodic
+ * \return Smallest and largest offset. Offsets reaching beyond the lattice
+ *         only contribute if it is periodic.
+ */
+std::pair<int, int> offset_range(double cell_size, double r_cut, int n_cells,
+                                 bool periodic) {
+  /* The source cells s of target cell t = 0 are those with lower <= s <
+   * upper, as in iterate_in_rectangle for the center of t. */
+  const double center = 0.5 * cell_size;
+  const int lower =
+      static_cast<int>(std::ceil((center - r_cut) / cell_size - 0.5));
+  const int upper =
+      static_cast<int>(std::ceil((center + r_cut) / cell_size - 0.5));
+  int lowest = 1 - upper;
+  int highest = -lower;
+  if (!periodic) {
+    lowest = std::max(lowest, 1 - n_cells);
+    highest = std::min(highest, n_cells - 1);
+  }
+  return {lowest, highest};
+}
+
+/**
+ * Size of the grid the convolution is done on.
+ *
+ * \param[in] lattice lattice geometry
+ * \param[in] r_cut half edge length of the integration volume [fm]
+ * \return Number of cells for a periodic lattice, otherwise a fast size long
+ *         enough that the periodic convolution does not wrap around.
+ */
+std::array<int, 3> padded_sizes(const DensityLattice &lattice, double r_cut) {
+  std::array<int, 3> sizes = lattice.n_cells();
+  if (!lattice.periodic()) {
+    for (int i = 0; i < 3; i++) {
+      const auto range = offset_range(lattice.cell_sizes()[i], r_cut,
+                                      sizes[i], false);
+      sizes[i] = FourierTransform3D::next_fast_size(
+          sizes[i] + std::max(range.second - range.first, 0));
+    }
+  }
+  return sizes;
+}
+}  // namespace
+
+FFTCoulombSolver::FFTCoulombSolver(const DensityLattice &jmu_el_lat,
+                                   double r_cut)
+    : n_cells_(jmu_el_lat.n_cells()),
+      padded_sizes_(padded_sizes(jmu_el_lat, r_cut)),
+      fft_(padded_sizes_) {
+  const std::array<double, 3> &h = jmu_el_lat.cell_sizes();
+  const double cell_volume = h[0] * h[1] * h[2];
+  std::array<std::pair<int, int>, 3> ranges;
+  for (int i = 0; i < 3; i++) {
+    ranges[i] = offset_range(h[i], r_cut, n_cells_[i], jmu_el_lat.periodic());
+  }
+  for (auto &component : green_function_) {
+    component.assign(fft_.size(), 0.);
+  }
+  /* Green's function of the offsets, as in the integrands of Potentials.
+   * Offsets are stored modulo the grid size, which for a periodic lattice
+   * adds up the images of the cells within reach. */
+  for (int mz = ranges[2].first; mz <= ranges[2].second; mz++) {
+    for (int my = ranges[1].first; my <= ranges[1].second; my++) {
+      for (int mx = ranges[0].first; mx <= ranges[0].second; mx++) {
+        if (mx == 0 && my == 0 && mz == 0) {
+          continue;
+        }
+        const ThreeVector dr(mx * h[0], my * h[1], mz * h[2]);
+        const ThreeVector g =
+            elementary_charge * cell_volume * dr / std::pow(dr.abs(), 3);
+        const std::size_t index =
+            padded_index(wrap(mx, padded_sizes_[0]),
+                         wrap(my, padded_sizes_[1]),
+                         wrap(mz, padded_sizes_[2]));
+        for (int i = 0; i < 3; i++) {
+          green_function_[i][index] += g[i];
+        }
+      }
+    }
+  }
+  for (auto &component : green_function_) {
+    fft_.forward(component);
+  }
+  charge_.resize(fft_.size());
+  current_.resize(fft_.size());
+  for (auto &component : fields_) {
+    component.resize(fft_.size());
+  }
+}
+
+void FFTCoulombSolver::compute_fields(DensityLattice &jmu_el_lat,
+                                      FieldsLattice &em_lat) {
+  std::fill(charge_.begin(), charge_.end(), 0.);
+  std::fill(current_.begin(), current_.end(), 0.);
+  std::size_t i_cell = 0;
+  for (int iz = 0; iz < n_cells_[2]; iz++) {
+    for (int iy = 0; iy < n_cells_[1]; iy++) {
+      for (int ix = 0; ix < n_cells_[0]; ix++, i_cell++) {
+        DensityOnLattice &node = jmu_el_lat[i_cell];
+        const ThreeVector j = node.jmu_net().threevec();
+        const std::size_t index = padded_index(ix, iy, iz);
+        charge_[index] = {node.rho(), j.x1()};
+        current_[index] = {j.x2(), j.x3()};
+      }
+    }
+  }
+  fft_.forward(charge_);
+  fft_.forward(current_);
+
+  /* The transforms of the real parts a and imaginary parts b of a packed
+   * transform c are (c(k) + c*(-k)) / 2 and (c(k) - c*(-k)) / 2i. */
+  const std::complex<double> i_unit(0., 1.);
+  std::size_t index = 0;
+  for (int kz = 0; kz < padded_sizes_[2]; kz++) {
+    const int mkz = kz == 0 ? 0 : padded_sizes_[2] - kz;
+    for (int ky = 0; ky < padded_sizes_[1]; ky++) {
+      const int mky = ky == 0 ? 0 : padded_sizes_[1] - ky;
+      for (int kx = 0; kx < padded_sizes_[0]; kx++, index++) {
+        const int mkx = kx == 0 ? 0 : padded_sizes_[0] - kx;
+        const std::size_t mirrored = padded_index(mkx, mky, mkz);
+        const std::complex<double> c = charge_[index];
+        const std::complex<double> c_mirrored = std::conj(charge_[mirrored]);
+        const std::complex<double> d = current_[index];
+        const std::complex<double> d_mirrored = std::conj(current_[mirrored]);
+        const std::complex<double> rho = 0.5 * (c + c_mirrored);
+        const std::complex<double> jx = -0.5 * i_unit * (c - c_mirrored);
+        const std::complex<double> jy = 0.5 * (d + d_mirrored);
+        const std::complex<double> jz = -0.5 * i_unit * (d - d_mirrored);
+        const std::complex<double> gx = green_function_[0][index];
+        const std::complex<double> gy = green_function_[1][index];
+        const std::complex<double> gz = green_function_[2][index];
+        // E = rho G and B = j x G, packed pairwise since all fields are real.
+        fields_[0][index] = rho * gx + i_unit * rho * gy;
+        fields_[1][index] = rho * gz + i_unit * (jy * gz - jz * gy);
+        fields_[2][index] = (jz * gx - jx * gz) + i_unit * (jx * gy - jy * gx);
+      }
+    }
+  }
+  for (auto &component : fields_) {
+    fft_.backward(component);
+  }
+
+  i_cell = 0;
+  for (int iz = 0; iz < n_cells_[2]; iz++) {
+    for (int iy = 0; iy < n_cells_[1]; iy++) {
+      for (int ix = 0; ix < n_cells_[0]; ix++, i_cell++) {
+        const std::size_t padded = padded_index(ix, iy, iz);
+        em_lat[i_cell] = std::make_pair(
+            ThreeVector(fields_[0][padded].real(), fields_[0][padded].imag(),
+                        fields_[1][padded].real()),
+            ThreeVector(fields_[1][padded].imag(), fields_[2][padded].real(),
+                        fields_[2][padded].imag()));
+      }
+    }
+  }
+}
+
+}  // namespace smash
@@ -9,6 +9,7 @@
 
 #include "smash/grid.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "smash/algorithms.h"
@@ -118,8 +119,10 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
               const Particles &particles, double max_interaction_length,
               double timestep_duration, CellNumberLimitation limit,
               const bool include_unformed_particles, CellSizeStrategy strategy)
-    : length_(min_and_length.second) {
-  const auto min_position = min_and_length.first;
+    : length_(min_and_length.second),
+      min_position_(min_and_length.first),
+      time_(particles.is_empty() ? 0. : particles.time()) {
+  const auto &min_position = min_position_;
   const SizeType particle_count = particles.size();
 
   // very simple setup for non-periodic boundaries and largest cellsize strategy
@@ -203,6 +206,7 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
       assert(index_factor[i] * length_[i] < number_of_cells_[i]);
     }
   }
+  index_factor_ = index_factor;
 
   if (O == GridOptions::Normal &&
       all_of(number_of_cells_, [](SizeType n) { return n <= 2; })) {
@@ -232,6 +236,12 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
                      return p.xsec_scaling_factor(timestep_duration) > 0.0;
                    });
     }
+    for (const ParticleData &p : cells_.front()) {
+      if (cell_of_index_.size() <= p.index()) {
+        cell_of_index_.resize(p.index() + 1, -1);
+      }
+      cell_of_index_[p.index()] = 0;
+    }
   } else {
     // construct a normal grid
 
@@ -279,7 +289,7 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
         throw std::runtime_error("out-of-bounds grid access on construction");
       }
 #endif
-      cells_[idx].push_back(p);
+      sort_in(p, idx);
     }
   }
 
@@ -292,6 +302,100 @@ inline typename Grid<Options>::SizeType Grid<Options>::make_index(
   return (z * number_of_cells_[1] + y) * number_of_cells_[0] + x;
 }
 
+template <GridOptions Options>
+std::array<typename Grid<Options>::SizeType, 3>
+Grid<Options>::cell_coordinates_of(const ParticleData &p) const {
+  /* Follow the straight line trajectory back to the time of the construction.
+   * For the particles sorted in on construction this is their position. */
+  const ThreeVector position = p.position().threevec() -
+                               p.velocity() * (p.position().x0() - time_);
+  std::array<SizeType, 3> idx;
+  for (std::size_t i = 0; i < idx.size(); ++i) {
+    const double x = std::floor((position[i] - min_position_[i]) *
+                                index_factor_[i]);
+    if (x < 0.) {
+      idx[i] = 0;
+    } else if (x >= number_of_cells_[i]) {
+      idx[i] = number_of_cells_[i] - 1;
+    } else {
+      idx[i] = static_cast<SizeType>(x);
+    }
+  }
+  return idx;
+}
+
+template <GridOptions Options>
+void Grid<Options>::sort_in(const ParticleData &p, SizeType cell_index) {
+  cells_[cell_index].push_back(p);
+  if (cell_of_index_.size() <= p.index()) {
+    cell_of_index_.resize(p.index() + 1, -1);
+  }
+  cell_of_index_[p.index()] = cell_index;
+}
+
+template <GridOptions Options>
+void Grid<Options>::add_particles(const ParticleList &new_particles) {
+  for (const ParticleData &p : new_particles) {
+    if (p.index() < cell_of_index_.size() && cell_of_index_[p.index()] >= 0) {
+      /* Drop the old copy with the same index. Either it is the same particle
+       * before crossing a wall, or a particle that is gone anyway. */
+      ParticleList &old_cell = cells_[cell_of_index_[p.index()]];
+      const auto old = std::find_if(
+          old_cell.begin(), old_cell.end(),
+          [&p](const ParticleData &q) { return q.index() == p.index(); });
+      if (old != old_cell.end()) {
+        old_cell.erase(old);
+      }
+    }
+    sort_in(p, make_index(cell_coordinates_of(p)));
+  }
+}
+
+template <GridOptions Options>
+ParticleList Grid<Options>::surrounding_particles(
+    const ParticleList &search_list, const Particles &particles) const {
+  // Each cell is visited only once, even if it is close to several particles.
+  std::vector<SizeType> cell_indices;
+  cell_indices.reserve(27 * search_list.size());
+  for (const ParticleData &p : search_list) {
+    const std::array<SizeType, 3> center = cell_coordinates_of(p);
+    std::array<SizeType, 3> lower, upper;
+    for (std::size_t i = 0; i < center.size(); ++i) {
+      lower[i] = std::max(center[i] - 1, 0);
+      upper[i] = std::min(center[i] + 1, number_of_cells_[i] - 1);
+    }
+    for (SizeType z = lower[2]; z <= upper[2]; ++z) {
+      for (SizeType y = lower[1]; y <= upper[1]; ++y) {
+        for (SizeType x = lower[0]; x <= upper[0]; ++x) {
+          cell_indices.push_back(make_index(x, y, z));
+        }
+      }
+    }
+  }
+  std::sort(cell_indices.begin(), cell_indices.end());
+  cell_indices.erase(std::unique(cell_indices.begin(), cell_indices.end()),
+                     cell_indices.end());
+
+  ParticleList surrounding;
+  for (const SizeType cell_index : cell_indices) {
+    for (const ParticleData &p : cells_[cell_index]) {
+      // Particles which interacted since they were sorted in are gone.
+      if (!particles.is_valid(p)) {
+        continue;
+      }
+      /* A particle of the search list can be in the grid already, if it has
+       * only crossed a wall. */
+      const bool searched = std::any_of(
+          search_list.begin(), search_list.end(),
+          [&p](const ParticleData &q) { return q.index() == p.index(); });
+      if (!searched) {
+        surrounding.push_back(particles.lookup(p));
+      }
+    }
+  }
+  return surrounding;
+}
+
 static const std::initializer_list<GridBase::SizeType> ZERO{0};
 static const std::initializer_list<GridBase::SizeType> ZERO_ONE{0, 1};
 static const std::initializer_list<GridBase::SizeType> MINUS_ONE_ZERO{-1, 0};
@@ -499,4 +603,13 @@ template Grid<GridOptions::PeriodicBoundaries>::Grid(
     const Particles &particles, double max_interaction_length,
     double timestep_duration, CellNumberLimitation limit,
     const bool include_unformed_particles, CellSizeStrategy strategy);
+template void Grid<GridOptions::Normal>::add_particles(
+    const ParticleList &new_particles);
+template void Grid<GridOptions::PeriodicBoundaries>::add_particles(
+    const ParticleList &new_particles);
+template ParticleList Grid<GridOptions::Normal>::surrounding_particles(
+    const ParticleList &search_list, const Particles &particles) const;
+template ParticleList
+Grid<GridOptions::PeriodicBoundaries>::surrounding_particles(
+    const ParticleList &search_list, const Particles &particles) const;
 }  // namespace smash
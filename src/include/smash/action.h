@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2022
+ *    Copyright (c) 2014-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "lattice.h"
+#include "objectpool.h"
 #include "particles.h"
 #include "pauliblocking.h"
 #include "potentials.h"
@@ -31,8 +32,11 @@ static constexpr int LAction = LogArea::Action::id;
  * Currently such an action can be either a decay, a two-body collision, a
  * wallcrossing or a thermalization.
  * (see derived classes).
+ *
+ * Actions are allocated from a PoolAllocated pool, since a new one is created
+ * for every candidate interaction.
  */
-class Action {
+class Action : public PoolAllocated {
  public:
   /**
    * Construct an action object with incoming particles and relative time.
@@ -489,6 +493,9 @@ class Action {
     return out;
   }
 
+  /// RecordedAction copies the geometry information needed for the outputs.
+  friend class RecordedAction;
+
  private:
   /**
    * Get the type of a given particle
@@ -1,5 +1,5 @@
 /*
- *    Copyright (c) 2015-2018,2020
+ *    Copyright (c) 2015-2018,2020,2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -7,8 +7,9 @@
 #ifndef SRC_INCLUDE_SMASH_ACTIONS_H_
 #define SRC_INCLUDE_SMASH_ACTIONS_H_
 
-#include <algorithm>
-#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,17 @@ namespace smash {
  *
  * The Actions class abstracts the storage and manipulation of actions.
  *
+ * The actions are kept in slots, and a binary heap of their times and slots
+ * determines the order of execution, such that sorting compares plain numbers
+ * instead of calling Action::time_of_execution. Actions at the same time are
+ * executed in the order of insertion.
+ *
+ * Additionally the pending actions of every particle are indexed by its
+ * index in Particles. Once a particle has interacted, invalidate removes all
+ * of its other actions right away, instead of keeping them until they are
+ * found invalid when they are due. Their entries in the heap are removed once
+ * they reach the top or outnumber the pending actions.
+ *
  * \note
  * The Actions object cannot be copied, because it does not make sense
  * semantically. Move semantics make sense and can be implemented when needed.
@@ -33,15 +45,12 @@ class Actions {
   /**
    * Creates a new Actions object from an ActionList.
    *
-   * The actions are stored in a heap and not sorted. The entries of
-   * the ActionList are rendered invalid by this constructor.
+   * The entries of the ActionList are rendered invalid by this constructor.
    *
    * \param[in] action_list The ActionList from which to construct the Actions
    *                    object
    */
-  explicit Actions(ActionList&& action_list) : data_(std::move(action_list)) {
-    std::make_heap(data_.begin(), data_.end(), cmp);
-  }
+  explicit Actions(ActionList&& action_list) { insert(std::move(action_list)); }
 
   /// Cannot be copied
   Actions(const Actions&) = delete;
@@ -49,25 +58,17 @@ class Actions {
   Actions& operator=(const Actions&) = delete;
 
   /// \return whether the list of actions is empty.
-  bool is_empty() const { return data_.empty(); }
+  bool is_empty() const { return n_pending_ == 0; }
 
   /**
    * Return the first action in the list and removes it from the list.
    *
    * \throw RuntimeError if the list is empty.
    */
-  ActionPtr pop() {
-    if (data_.empty()) {
-      throw std::runtime_error("Empty actions list!");
-    }
-    std::pop_heap(data_.begin(), data_.end(), cmp);
-    ActionPtr act = std::move(data_.back());
-    data_.pop_back();
-    return act;
-  }
+  ActionPtr pop();
 
   /// Return time of execution of earliest action
-  double earliest_time() const { return data_.front()->time_of_execution(); }
+  double earliest_time() const { return heap_.front().time; }
 
   /**
    * Insert a list of actions into this object.
@@ -89,48 +90,98 @@ class Actions {
    *
    * \param[in] action The action to insert.
    */
-  void insert(ActionPtr&& action) {
-    data_.push_back(std::move(action));
-    std::push_heap(data_.begin(), data_.end(), cmp);
-  }
+  void insert(ActionPtr&& action);
+
+  /**
+   * Remove all pending actions of the given particles, which have become
+   * invalid since the particles interacted. Not to be called for wall
+   * crossings, after which the other actions of the particle stay valid.
+   *
+   * \param[in] particles incoming particles of a performed action
+   * \return Number of removed actions.
+   */
+  std::size_t invalidate(const ParticleList& particles);
 
   /// \return Number of actions.
-  ActionList::size_type size() const { return data_.size(); }
+  ActionList::size_type size() const { return n_pending_; }
 
   /// Delete all actions.
-  void clear() { data_.clear(); }
+  void clear();
 
-  /// \return an iterator to the earliest action.
-  std::vector<ActionPtr>::const_reverse_iterator begin() const {
-    return data_.crbegin();
-  }
+ private:
+  /// Time of an action and its slot, which are sorted in the heap
+  struct Key {
+    /// Time of execution of the action
+    double time;
+    /// Number of actions inserted before, to order actions at the same time
+    uint64_t order;
+    /// Slot of the action
+    uint32_t slot;
+    /// Generation of the slot, which is outdated if the action was removed
+    uint32_t generation;
+  };
+
+  /// Entry in the list of pending actions of a particle
+  struct Link {
+    /// Slot of the action
+    uint32_t slot;
+    /// Generation of the slot, which is outdated if the action was removed
+    uint32_t generation;
+    /// Next entry of the same particle, or no_link
+    uint32_t next;
+  };
+
+  /// Marks the end of the list of pending actions of a particle
+  static constexpr uint32_t no_link = std::numeric_limits<uint32_t>::max();
 
-  /// \return an iterator to the place following the last action.
-  std::vector<ActionPtr>::const_reverse_iterator end() const {
-    return data_.crend();
+  /**
+   * Compare two keys such that the maximum is the earliest action.
+   *
+   * \param[in] a First key
+   * \param[in] b Second key
+   * \return Whether the first action will be executed after the second.
+   */
+  static bool later(const Key& a, const Key& b) {
+    return a.time > b.time || (a.time == b.time && a.order > b.order);
   }
 
- private:
   /**
-   * Compare two action pointer such that the maximum is the most recent
-   * action.
-   *
-   * \param[in] a First action
-   * \param[in] b Second action
-   * \return Whether the first action will be executed later than the second.
+   * \param[in] key key in the heap
+   * \return Whether the action of the key is still pending.
    */
-  static bool cmp(const ActionPtr& a, const ActionPtr& b) {
-    return a->time_of_execution() > b->time_of_execution();
+  bool is_pending(const Key& key) const {
+    return generations_[key.slot] == key.generation;
   }
 
   /**
-   * Dynamic data.
+   * Delete the action in a slot and make the slot available for reuse.
    *
-   * Vector is likely the best container type here. Because std::sort requires
-   * random access iterators. Any linked data structure (e.g. list) thus
-   * requires a less efficient sort algorithm.
+   * \param[in] slot slot of a pending action
+   */
+  void release(uint32_t slot);
+
+  /**
+   * Remove the keys of removed actions from the top of the heap, and from the
+   * whole heap if they are the majority.
    */
-  std::vector<ActionPtr> data_;
+  void drop_removed_keys();
+
+  /// Heap of the keys of the actions, possibly also of removed ones
+  std::vector<Key> heap_;
+  /// Actions by slot, nullptr for free slots
+  std::vector<ActionPtr> slots_;
+  /// Generation of every slot, increased when its action is removed
+  std::vector<uint32_t> generations_;
+  /// Slots that are free for reuse
+  std::vector<uint32_t> free_slots_;
+  /// First entry in links_ for every particle index
+  std::vector<uint32_t> first_link_;
+  /// Lists of the pending actions of the particles
+  std::vector<Link> links_;
+  /// Number of pending actions
+  std::size_t n_pending_ = 0;
+  /// Number of inserted actions
+  uint64_t n_inserted_ = 0;
 };
 
 }  // namespace smash
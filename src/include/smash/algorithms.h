@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2015,2017-2018,2020
+ *    Copyright (c) 2014-2015,2017-2018,2020,2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -12,7 +12,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <iterator>
 #include <utility>
+#include <vector>
 
 /**
  * \file
@@ -98,6 +101,55 @@ inline UnaryFunction for_each(Container &&c, UnaryFunction &&f) {
                        std::forward<UnaryFunction>(f));
 }
 
+/**
+ * Call a function for every k-combination of the elements of a container,
+ * i.e. once for every subset of \p k elements.
+ *
+ * The elements of each combination are in the order of the container, and
+ * the combinations are visited in lexicographic order of their positions.
+ * The work is proportional to the number of combinations, so sorting out
+ * elements that cannot take part before is much cheaper than nested loops
+ * over all elements with a check in the innermost one.
+ *
+ * \tparam Container Type of the container, with random access iterators.
+ * \tparam Function Type of the function.
+ * \param c A container of the elements to combine.
+ * \param k Number of elements in each combination.
+ * \param f A function taking a \c std::vector of the elements of one
+ *          combination. The vector is reused for all calls.
+ */
+template <typename Container, typename Function>
+void for_each_combination(const Container &c, std::size_t k, Function &&f) {
+  const std::size_t n = std::size(c);
+  if (k == 0 || k > n) {
+    return;
+  }
+  using Element = typename std::decay_t<decltype(*std::begin(c))>;
+  std::vector<std::size_t> positions(k);
+  std::vector<Element> combination(k);
+  for (std::size_t i = 0; i < k; i++) {
+    positions[i] = i;
+  }
+  while (true) {
+    for (std::size_t i = 0; i < k; i++) {
+      combination[i] = std::begin(c)[positions[i]];
+    }
+    f(combination);
+    // Advance the last position that is not at its maximum n - k + i.
+    std::size_t i = k;
+    while (i > 0 && positions[i - 1] == n - k + i - 1) {
+      i--;
+    }
+    if (i == 0) {
+      return;
+    }
+    positions[i - 1]++;
+    for (std::size_t j = i; j < k; j++) {
+      positions[j] = positions[j - 1] + 1;
+    }
+  }
+}
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_ALGORITHMS_H_
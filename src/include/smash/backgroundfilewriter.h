@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_BACKGROUNDFILEWRITER_H_
+#define SRC_INCLUDE_SMASH_BACKGROUNDFILEWRITER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * Writes blocks of bytes to a file on a dedicated thread.
+ *
+ * Outputs serialize their records into a block in memory and hand over full
+ * blocks with submit, which returns right away, so that the simulation does
+ * not wait for the file system. The blocks are written in the order in which
+ * they were submitted. The bytes waiting to be written are limited by a
+ * memory budget: submit blocks while a new block would exceed it, until the
+ * writer thread has caught up. With a budget of zero no thread is started and
+ * submit writes the block itself.
+ *
+ * Errors while writing are reported by the next call to submit or finish on
+ * the calling thread.
+ */
+class BackgroundFileWriter {
+ public:
+  /**
+   * Transforms a block before it is written, e.g. compresses it. Encoders are
+   * called on the writer thread in the order of the blocks.
+   */
+  using Encoder = std::function<std::vector<char>(const std::vector<char> &)>;
+
+  /**
+   * Start the writer thread.
+   *
+   * \param[in] file File to write to, which must stay open until finish
+   *                 was called or the writer was destroyed.
+   * \param[in] memory_budget Largest number of bytes waiting to be written,
+   *                          0 to write on the calling thread.
+   */
+  BackgroundFileWriter(std::FILE *file, std::size_t memory_budget);
+
+  /// Write all submitted blocks and stop the thread, see finish.
+  ~BackgroundFileWriter();
+
+  /// Cannot be copied
+  BackgroundFileWriter(const BackgroundFileWriter &) = delete;
+  /// Cannot be copied
+  BackgroundFileWriter &operator=(const BackgroundFileWriter &) = delete;
+
+  /**
+   * Queue a block for writing.
+   *
+   * \param[in] block Bytes to append to the file.
+   * \param[in] flush Whether the file is flushed after the block was written,
+   *                  e.g. at the end of an event.
+   * \param[in] encoder Writes the result of the encoder instead of the block,
+   *                    if given. It counts against the budget with the size
+   *                    of the block.
+   * \throw std::runtime_error if writing a previous block failed
+   */
+  void submit(std::vector<char> &&block, bool flush, Encoder encoder = {});
+
+  /**
+   * Wait until all submitted blocks are written and stop the thread. Later
+   * blocks are written on the calling thread.
+   *
+   * \throw std::runtime_error if writing a block failed
+   */
+  void finish();
+
+  /**
+   * \return Size of the blocks [bytes] in which the outputs should hand over
+   *         their records, a quarter of the budget such that the writer
+   *         thread can work on one block while the next ones are filled.
+   */
+  std::size_t block_size() const;
+
+ private:
+  /// A block waiting to be written
+  struct Entry {
+    /// Bytes to write
+    std::vector<char> block;
+    /// Whether the file is flushed afterwards
+    bool flush;
+    /// Transformation applied before writing, if any
+    Encoder encoder;
+  };
+
+  /**
+   * Encode a block and append it to the file.
+   *
+   * \param[in] entry The block
+   * \throw std::runtime_error if the block could not be written
+   */
+  void write_block(const Entry &entry);
+
+  /// Function run by the writer thread.
+  void worker_loop();
+
+  /// Rethrow the error of the writer thread, if there was one.
+  void rethrow_error();
+
+  /// File the blocks are written to
+  std::FILE *file_;
+  /// Largest number of bytes in the queue
+  const std::size_t memory_budget_;
+  /// Guards all members below
+  std::mutex mutex_;
+  /// Notifies the writer thread of new blocks or the request to stop
+  std::condition_variable work_available_;
+  /// Notifies submit that a block was written
+  std::condition_variable block_written_;
+  /// Blocks waiting to be written
+  std::deque<Entry> queue_;
+  /// Bytes submitted but not yet written, including the current block
+  std::size_t queued_bytes_ = 0;
+  /// Whether the thread should stop once the queue is empty
+  bool stop_ = false;
+  /// Error of the writer thread which was not reported yet
+  std::exception_ptr error_;
+  /// Whether writing a block failed, after which no more blocks are written
+  bool failed_ = false;
+  /// The writer thread, started last
+  std::thread worker_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_BACKGROUNDFILEWRITER_H_
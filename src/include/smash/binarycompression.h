@@ -0,0 +1,76 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_BINARYCOMPRESSION_H_
+#define SRC_INCLUDE_SMASH_BINARYCOMPRESSION_H_
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+#include "forwarddeclarations.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * Whether chunks can be compressed and decompressed with a codec in this
+ * build. The built-in codec and no compression are always available, Zstd and
+ * LZ4 only if their libraries were found when SMASH was configured.
+ *
+ * \param[in] codec The codec
+ * \return Whether the codec is available.
+ */
+bool is_available(BinaryCompression codec);
+
+/**
+ * \ingroup output
+ *
+ * Compress a chunk of a binary output file.
+ *
+ * \param[in] codec Codec to use, which must be available.
+ * \param[in] data First byte of the chunk
+ * \param[in] size Number of bytes in the chunk
+ * \return The compressed bytes, which may be larger than the chunk for
+ *         incompressible data.
+ * \throw std::runtime_error if the codec is not available or fails.
+ */
+std::vector<char> compress_chunk(BinaryCompression codec, const char *data,
+                                 std::size_t size);
+
+/**
+ * \ingroup output
+ *
+ * Decompress a chunk of a binary output file.
+ *
+ * \param[in] codec Codec the chunk was compressed with
+ * \param[in] data First compressed byte
+ * \param[in] size Number of compressed bytes
+ * \param[out] out Buffer for the decompressed chunk
+ * \param[in] out_size Size of the decompressed chunk, as stored in the file
+ * \throw std::runtime_error if the codec is not available or the compressed
+ *        data is corrupt or does not decompress to exactly out_size bytes.
+ */
+void decompress_chunk(BinaryCompression codec, const char *data,
+                      std::size_t size, char *out, std::size_t out_size);
+
+/**
+ * \ingroup output
+ *
+ * Print the name of a codec, as given in the configuration.
+ *
+ * \param[in] out The ostream into which to output
+ * \param[in] codec The codec
+ */
+std::ostream &operator<<(std::ostream &out, BinaryCompression codec);
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_BINARYCOMPRESSION_H_
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2020,2022
+ *    Copyright (c) 2014-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -10,9 +10,13 @@
 #ifndef SRC_INCLUDE_SMASH_BINARYOUTPUT_H_
 #define SRC_INCLUDE_SMASH_BINARYOUTPUT_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "backgroundfilewriter.h"
+#include "binarycompression.h"
 #include "file.h"
 #include "forwarddeclarations.h"
 #include "numeric_cast.h"
@@ -24,8 +28,21 @@ namespace smash {
 /**
  * \ingroup output
  * Base class for SMASH binary output.
+ *
+ * The write functions serialize the records into a buffer in memory. Each
+ * output calls finish_record after a complete block ('p', 'i' or 'f'), which
+ * hands the buffer to a BackgroundFileWriter once it is full, so that the
+ * file is written on another thread in large blocks.
+ *
+ * With compression, the handed over buffers are the chunks of the compressed
+ * variant of the format. They are compressed on the writer thread, which also
+ * records the chunk index written at the end of the file.
  */
 class BinaryOutputBase : public OutputInterface {
+ public:
+  /// Write the remaining records and wait until they are on disk.
+  ~BinaryOutputBase() override;
+
  protected:
   /**
    * Create binary output base.
@@ -34,16 +51,30 @@ class BinaryOutputBase : public OutputInterface {
    * \param[in] mode Is used to determine the file access mode.
    * \param[in] name Name of the output.
    * \param[in] extended_format Is the written output extended.
+   * \param[in] buffer_size Memory budget [bytes] of the records waiting to be
+   *                        written, 0 to write on the simulation thread.
+   * \param[in] compression Codec of the chunks, None for the uncompressed
+   *                        format.
    */
   explicit BinaryOutputBase(const std::filesystem::path &path,
                             const std::string &mode, const std::string &name,
-                            bool extended_format);
+                            bool extended_format, std::size_t buffer_size,
+                            BinaryCompression compression);
+
+  /**
+   * Hand the buffered records to the writer thread if the buffer is full.
+   *
+   * \param[in] flush Hand them over in any case and flush the file after
+   *                  writing them. Must be used at the end of an event, so
+   *                  that no compressed chunk contains records of two events.
+   */
+  void finish_record(bool flush = false);
 
   /**
    * Write byte to binary output.
    * \param[in] c Value to be written.
    */
-  void write(const char c);
+  void write(const char c) { append(c); }
 
   /**
    * Write string to binary output.
@@ -55,7 +86,7 @@ class BinaryOutputBase : public OutputInterface {
    * Write double to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const double x);
+  void write(const double x) { append(x); }
 
   /**
    * Write four-vector to binary output.
@@ -67,25 +98,19 @@ class BinaryOutputBase : public OutputInterface {
    * Write integer (32 bit) to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const std::int32_t x) {
-    std::fwrite(&x, sizeof(x), 1, file_.get());
-  }
+  void write(const std::int32_t x) { append(x); }
 
   /**
    * Write unsigned integer (32 bit) to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const std::uint32_t x) {
-    std::fwrite(&x, sizeof(x), 1, file_.get());
-  }
+  void write(const std::uint32_t x) { append(x); }
 
   /**
    * Write unsigned integer (16 bit) to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const std::uint16_t x) {
-    std::fwrite(&x, sizeof(x), 1, file_.get());
-  }
+  void write(const std::uint16_t x) { append(x); }
 
   /**
    * Write a std::size_t to binary output.
@@ -115,10 +140,62 @@ class BinaryOutputBase : public OutputInterface {
   RenamingFilePtr file_;
 
  private:
+  /// Entry of the chunk index of compressed files
+  struct ChunkIndexEntry {
+    /// Position of the chunk in the file [bytes]
+    std::uint64_t offset;
+    /// Size of the compressed data of the chunk [bytes]
+    std::uint32_t compressed_size;
+    /// Size of the records in the chunk [bytes]
+    std::uint32_t uncompressed_size;
+    /// Number of events in the file before the one of the chunk
+    std::uint32_t event;
+  };
+
+  /// Largest size [bytes] of the records in a compressed chunk
+  static constexpr std::size_t max_chunk_size = 4 * 1024 * 1024;
+
+  /**
+   * Compress a chunk and add it to the chunk index. Called by the writer
+   * thread in the order of the chunks.
+   *
+   * \param[in] records The records of the chunk
+   * \param[in] event Number of events in the file before the one the records
+   *                  belong to
+   * \return The chunk as written to the file
+   */
+  std::vector<char> encode_chunk(const std::vector<char> &records,
+                                 std::uint32_t event);
+
+  /// Append the chunk index to a compressed file after the last chunk.
+  void write_chunk_index();
+
+  /**
+   * Append the bytes of a value to the buffer.
+   * \param[in] x Value to be written.
+   */
+  template <typename T>
+  void append(const T &x) {
+    const char *bytes = reinterpret_cast<const char *>(&x);
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+  }
+
   /// Binary file format version number
   const uint16_t format_version_ = 8;
   /// Option for extended output
   bool extended_;
+  /// Codec of the chunks, None for the uncompressed format
+  BinaryCompression compression_;
+  /// Number of events which were finished with finish_record
+  std::uint32_t events_finished_ = 0;
+  /// Size of the file [bytes] after the chunks encoded so far
+  std::uint64_t file_offset_ = 0;
+  /// Index of the chunks encoded so far
+  std::vector<ChunkIndexEntry> chunk_index_;
+  /// Writes the buffers to file_, destroyed before it
+  BackgroundFileWriter writer_;
+  /// Records not yet handed to writer_
+  std::vector<char> buffer_;
 };
 
 /**
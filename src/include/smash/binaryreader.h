@@ -0,0 +1,518 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_BINARYREADER_H_
+#define SRC_INCLUDE_SMASH_BINARYREADER_H_
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fourvector.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * View of a particle line of a binary output file.
+ *
+ * The view points to the line in the mapped file, or in the decompressed
+ * chunks of an event, and reads the fields only when they are accessed.
+ * It is valid as long as the BinaryEvent it was taken from.
+ */
+class BinaryParticleView {
+ public:
+  /// Size of a particle line [bytes]
+  static constexpr std::size_t size = 9 * sizeof(double) + 3 * 4;
+  /// Size of an extended particle line [bytes]
+  static constexpr std::size_t extended_size =
+      size + 6 * 4 + 3 * sizeof(double);
+
+  /**
+   * \param[in] line First byte of the particle line
+   * \param[in] extended Whether the line is extended
+   */
+  BinaryParticleView(const char *line, bool extended)
+      : line_(line), extended_(extended) {}
+
+  /// \return time [fm]
+  double t() const { return get<double>(0); }
+  /// \return x coordinate [fm]
+  double x() const { return get<double>(8); }
+  /// \return y coordinate [fm]
+  double y() const { return get<double>(16); }
+  /// \return z coordinate [fm]
+  double z() const { return get<double>(24); }
+  /// \return effective mass [GeV]
+  double mass() const { return get<double>(32); }
+  /// \return energy [GeV]
+  double p0() const { return get<double>(40); }
+  /// \return x momentum [GeV]
+  double px() const { return get<double>(48); }
+  /// \return y momentum [GeV]
+  double py() const { return get<double>(56); }
+  /// \return z momentum [GeV]
+  double pz() const { return get<double>(64); }
+  /// \return PDG code in decimal
+  std::int32_t pdg() const { return get<std::int32_t>(72); }
+  /// \return ID of the particle
+  std::int32_t id() const { return get<std::int32_t>(76); }
+  /// \return electric charge
+  std::int32_t charge() const { return get<std::int32_t>(80); }
+
+  /// \return position four-vector (t, x, y, z)
+  FourVector position() const { return {t(), x(), y(), z()}; }
+  /// \return momentum four-vector (p0, px, py, pz)
+  FourVector momentum() const { return {p0(), px(), py(), pz()}; }
+
+  /// \return whether the extended fields below are available
+  bool extended() const { return extended_; }
+  /// \return number of collisions of the particle
+  std::int32_t ncoll() const { return extended_get<std::int32_t>(84); }
+  /// \return formation time [fm]
+  double formation_time() const { return extended_get<double>(88); }
+  /// \return cross section scaling factor
+  double xsec_scaling_factor() const { return extended_get<double>(96); }
+  /// \return ID of the last process of the particle
+  std::int32_t process_id_origin() const {
+    return extended_get<std::int32_t>(104);
+  }
+  /// \return type of the last process of the particle, see ProcessType
+  std::int32_t process_type_origin() const {
+    return extended_get<std::int32_t>(108);
+  }
+  /// \return time of the last collision [fm]
+  double time_last_collision() const { return extended_get<double>(112); }
+  /// \return PDG code of the first mother in decimal
+  std::int32_t pdg_mother1() const { return extended_get<std::int32_t>(120); }
+  /// \return PDG code of the second mother in decimal
+  std::int32_t pdg_mother2() const { return extended_get<std::int32_t>(124); }
+  /// \return baryon number
+  std::int32_t baryon_number() const {
+    return extended_get<std::int32_t>(128);
+  }
+
+ private:
+  /**
+   * Read a field of the line. The lines are not aligned in the file.
+   *
+   * \param[in] offset Position of the field in the line [bytes]
+   * \return The field
+   */
+  template <typename T>
+  T get(std::size_t offset) const {
+    T value;
+    std::memcpy(&value, line_ + offset, sizeof(T));
+    return value;
+  }
+
+  /// Read a field which only extended lines have, see get.
+  template <typename T>
+  T extended_get(std::size_t offset) const {
+    assert(extended_);
+    return get<T>(offset);
+  }
+
+  /// First byte of the line
+  const char *line_;
+  /// Whether the line is extended
+  bool extended_;
+};
+
+/**
+ * \ingroup output
+ *
+ * Consecutive particle lines of a binary output file, see BinaryParticleView.
+ */
+class BinaryParticleRange {
+ public:
+  /// Iterator over the particle lines
+  class iterator {
+   public:
+    /// \cond
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = BinaryParticleView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = BinaryParticleView;
+    /// \endcond
+
+    /**
+     * \param[in] line First byte of the current line
+     * \param[in] extended Whether the lines are extended
+     */
+    iterator(const char *line, bool extended)
+        : line_(line), extended_(extended) {}
+    /// \return view of the current line
+    BinaryParticleView operator*() const { return {line_, extended_}; }
+    /// Advance to the next line. \return this iterator
+    iterator &operator++() {
+      line_ += extended_ ? BinaryParticleView::extended_size
+                         : BinaryParticleView::size;
+      return *this;
+    }
+    /// \return whether both iterators point to the same line
+    bool operator==(const iterator &other) const {
+      return line_ == other.line_;
+    }
+    /// \return whether the iterators point to different lines
+    bool operator!=(const iterator &other) const {
+      return line_ != other.line_;
+    }
+
+   private:
+    /// First byte of the current line
+    const char *line_;
+    /// Whether the lines are extended
+    bool extended_;
+  };
+
+  /// Empty range
+  BinaryParticleRange() = default;
+
+  /**
+   * \param[in] data First byte of the first line
+   * \param[in] n Number of lines
+   * \param[in] extended Whether the lines are extended
+   */
+  BinaryParticleRange(const char *data, std::uint32_t n, bool extended)
+      : data_(data), n_(n), extended_(extended) {}
+
+  /// \return number of particles
+  std::size_t size() const { return n_; }
+  /// \return whether there are no particles
+  bool empty() const { return n_ == 0; }
+  /**
+   * \param[in] i Index of a particle, smaller than size()
+   * \return view of the particle
+   */
+  BinaryParticleView operator[](std::size_t i) const {
+    assert(i < n_);
+    return {data_ + i * line_size(), extended_};
+  }
+  /// \return iterator to the first particle
+  iterator begin() const { return {data_, extended_}; }
+  /// \return iterator past the last particle
+  iterator end() const { return {data_ + n_ * line_size(), extended_}; }
+
+ private:
+  /// \return size of a line [bytes]
+  std::size_t line_size() const {
+    return extended_ ? BinaryParticleView::extended_size
+                     : BinaryParticleView::size;
+  }
+
+  /// First byte of the first line
+  const char *data_ = nullptr;
+  /// Number of lines
+  std::uint32_t n_ = 0;
+  /// Whether the lines are extended
+  bool extended_ = false;
+};
+
+/**
+ * \ingroup output
+ *
+ * A 'p' or 'i' block of a binary output file.
+ */
+struct BinaryBlock {
+  /// 'p' for a particle list, 'i' for an interaction
+  char type;
+  /// The particles of a 'p' block, empty for 'i'
+  BinaryParticleRange particles;
+  /// The incoming particles of an 'i' block, empty for 'p'
+  BinaryParticleRange incoming;
+  /// The outgoing particles of an 'i' block, empty for 'p'
+  BinaryParticleRange outgoing;
+  /// Density at the interaction point, only for 'i'
+  double density = 0.;
+  /// Total weight of the interaction, only for 'i'
+  double total_weight = 0.;
+  /// Partial weight of the interaction, only for 'i'
+  double partial_weight = 0.;
+  /// Type of the interaction, see ProcessType, only for 'i'
+  std::uint32_t process_type = 0;
+};
+
+/**
+ * \ingroup output
+ *
+ * The blocks of one event of a binary output file, up to its 'f' block.
+ *
+ * The particle views of the blocks point into the mapped file, or for
+ * compressed files into the decompressed chunks of the event, which are kept
+ * alive by all copies of the event. They are valid as long as a copy of the
+ * event and the BinaryReader exist.
+ */
+class BinaryEvent {
+ public:
+  /// \return position of the event among the events of the file
+  std::size_t index() const { return index_; }
+  /// \return number of the event as written in its 'f' block
+  std::int32_t number() const { return number_; }
+  /// \return impact parameter [fm] of the event
+  double impact_parameter() const { return impact_parameter_; }
+  /// \return whether projectile and target did not interact
+  bool empty_event() const { return empty_event_; }
+  /// \return the 'p' and 'i' blocks of the event in the order of the file
+  const std::vector<BinaryBlock> &blocks() const { return blocks_; }
+
+ private:
+  friend class BinaryReader;
+
+  /// Position of the event among the events of the file
+  std::size_t index_ = 0;
+  /// Number of the event as written in its 'f' block
+  std::int32_t number_ = 0;
+  /// Impact parameter [fm]
+  double impact_parameter_ = 0.;
+  /// Whether projectile and target did not interact
+  bool empty_event_ = false;
+  /// The blocks in the order of the file
+  std::vector<BinaryBlock> blocks_;
+  /// Decompressed chunks of the event, null for uncompressed files
+  std::shared_ptr<const std::vector<char>> records_;
+};
+
+/**
+ * \ingroup output
+ *
+ * Random access to the events of a SMASH binary output file.
+ *
+ * The reader maps the file into memory and locates its events with an event
+ * index, which holds the position and size of the blocks of every event in
+ * the file. The index is loaded from the index file next to the output file
+ * (see index_path), which is written by write_index or by
+ * \code
+ * smash --index-binary <file>
+ * \endcode
+ * If there is no index file, or it was written for a file of a different
+ * size, the index is built by scanning the file. For the compressed
+ * variant of the format (\ref doxypage_output_binary_compressed), the chunk
+ * index at the end of the file is used, so only the chunk headers and the
+ * last chunk are read.
+ * Otherwise, the blocks are skipped one after another, which for compressed
+ * files means decompressing all chunks. An unfinished last event, if SMASH
+ * did not finish, is not part of the index.
+ *
+ * All particle, collision and initial conditions outputs, extended or not,
+ * of format version 8 can be read. Reading events is thread-safe, and
+ * for_each_event processes them in parallel:
+ * \code
+ * BinaryReader reader("data/0/particles_binary.bin");
+ * reader.for_each_event([&](const BinaryEvent &event) {
+ *   for (const BinaryBlock &block : event.blocks()) {
+ *     for (BinaryParticleView p : block.particles) {
+ *       ...
+ *     }
+ *   }
+ * }, 8);
+ * \endcode
+ *
+ * **Index file**
+ * \code
+ * 4*char  uint16_t      uint16_t uint64_t  uint64_t
+ * "SBIX"  index_version 0        file_size n_events
+ * \endcode
+ * followed by \c n_events entries
+ * \code
+ * uint64_t uint64_t
+ * offset   size
+ * \endcode
+ * \li \c index_version is currently 1.
+ * \li \c file_size is the size of the indexed output file [bytes].
+ * \li \c offset and \c size give the bytes of the blocks of the event in the
+ * output file, up to and including its 'f' block, or for compressed files the
+ * bytes of its chunks.
+ */
+class BinaryReader {
+ public:
+  /**
+   * Map a binary output file and load or build its event index.
+   *
+   * \param[in] path Path of the binary output file
+   * \param[in] use_index_file Whether to load the index from the index file,
+   *                           if there is a valid one
+   * \throw std::runtime_error if the file cannot be mapped, is not a SMASH
+   *        binary file or has an unsupported format version
+   */
+  explicit BinaryReader(const std::filesystem::path &path,
+                        bool use_index_file = true);
+
+  /// Unmap the file. Events read from it become invalid.
+  ~BinaryReader();
+
+  /// Cannot be copied
+  BinaryReader(const BinaryReader &) = delete;
+  /// Cannot be copied
+  BinaryReader &operator=(const BinaryReader &) = delete;
+
+  /**
+   * \param[in] path Path of a binary output file
+   * \return Path of its index file, which has ".idx" appended.
+   */
+  static std::filesystem::path index_path(const std::filesystem::path &path);
+
+  /**
+   * Write the event index to the index file of the output file.
+   *
+   * \throw std::runtime_error if the index file cannot be written
+   */
+  void write_index() const;
+
+  /// \return format version of the file
+  std::uint16_t format_version() const { return format_version_; }
+  /// \return whether the particle lines are extended
+  bool extended() const { return extended_; }
+  /// \return whether the file is the compressed variant of the format
+  bool compressed() const { return compressed_; }
+  /// \return SMASH version which wrote the file
+  const std::string &smash_version() const { return smash_version_; }
+  /// \return whether the event index was loaded from the index file
+  bool index_loaded() const { return index_loaded_; }
+
+  /// \return number of complete events in the file
+  std::size_t n_events() const { return events_.size(); }
+
+  /**
+   * Read an event.
+   *
+   * \param[in] k Position of the event among the events of the file, smaller
+   *              than n_events()
+   * \return The event, with views of its particles
+   * \throw std::out_of_range if there is no such event
+   * \throw std::runtime_error if the event is corrupt
+   */
+  BinaryEvent event(std::size_t k) const;
+
+  /**
+   * Call a function for every event, on several threads.
+   *
+   * Event k is processed by thread k % n_threads, and each thread processes
+   * its events in increasing order. If the function throws, the remaining
+   * events are still processed and the exception of the first event that
+   * failed is rethrown afterwards.
+   *
+   * \param[in] function Called with every event, concurrently for different
+   *                     events
+   * \param[in] n_threads Number of threads including the calling one
+   */
+  void for_each_event(const std::function<void(const BinaryEvent &)> &function,
+                      int n_threads = 1) const;
+
+ private:
+  /// Bytes of the blocks or chunks of an event in the file
+  struct EventRange {
+    /// Position of the first byte [bytes]
+    std::uint64_t offset;
+    /// Number of bytes
+    std::uint64_t size;
+  };
+
+  /**
+   * Read the header of the file.
+   *
+   * \throw std::runtime_error if the header is not valid
+   */
+  void read_header();
+
+  /**
+   * Load the event index from the index file.
+   *
+   * \return Whether there was a valid index file for this output file.
+   */
+  bool load_index();
+
+  /// Build the event index of an uncompressed file by skipping its blocks.
+  void scan_blocks();
+
+  /**
+   * Build the event index of a compressed file from its chunk index.
+   *
+   * \return Whether the file has a valid chunk index.
+   */
+  bool read_chunk_index();
+
+  /// Build the event index of a compressed file by reading all its chunks.
+  void scan_chunks();
+
+  /**
+   * Check whether a decompressed chunk is the last one of its event.
+   *
+   * \param[in] records Records of the chunk
+   * \return Whether the last block of the chunk is an 'f' block.
+   * \throw std::runtime_error if the last block is incomplete
+   */
+  bool ends_event(const std::vector<char> &records) const;
+
+  /**
+   * Decompress a chunk.
+   *
+   * \param[in] offset Position of the chunk in the file [bytes]
+   * \param[inout] records Buffer to which the records are appended
+   * \return Size of the chunk in the file [bytes], or 0 if the chunk does not
+   *         fit into the file.
+   * \throw std::runtime_error if the chunk is corrupt
+   */
+  std::uint64_t decompress(std::uint64_t offset,
+                           std::vector<char> &records) const;
+
+  /**
+   * Size of the block starting at data.
+   *
+   * \param[in] data First byte of the block
+   * \param[in] available Number of bytes from data to the end of the records
+   * \return Size of the block [bytes], or 0 if the block does not fit.
+   * \throw std::runtime_error if the block type is unknown
+   */
+  std::size_t block_size(const char *data, std::size_t available) const;
+
+  /**
+   * Split records into blocks.
+   *
+   * \param[in] data First byte of the records of an event
+   * \param[in] size Size of the records [bytes]
+   * \param[out] event Event to which the blocks are added
+   * \throw std::runtime_error if the records do not end with the 'f' block
+   */
+  void parse_event(const char *data, std::size_t size,
+                   BinaryEvent &event) const;
+
+  /// Path of the file
+  std::filesystem::path path_;
+  /// First byte of the mapped file
+  const char *data_ = nullptr;
+  /// Size of the file [bytes]
+  std::size_t size_ = 0;
+  /// Size of the header [bytes]
+  std::size_t header_size_ = 0;
+  /// Format version of the file
+  std::uint16_t format_version_ = 0;
+  /// Whether the particle lines are extended
+  bool extended_ = false;
+  /// Whether the file is the compressed variant of the format
+  bool compressed_ = false;
+  /// SMASH version which wrote the file
+  std::string smash_version_;
+  /// Whether the event index was loaded from the index file
+  bool index_loaded_ = false;
+  /// The event index
+  std::vector<EventRange> events_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_BINARYREADER_H_
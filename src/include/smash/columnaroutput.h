@@ -0,0 +1,133 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_COLUMNAROUTPUT_H_
+#define SRC_INCLUDE_SMASH_COLUMNAROUTPUT_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "columnarreader.h"
+#include "file.h"
+#include "forwarddeclarations.h"
+#include "outputinterface.h"
+#include "outputparameters.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * \brief Writes the particle list at specific times as columns to a file
+ *
+ * Like BinaryOutputParticles, this output writes the particles at event
+ * start, at event end and at intermediate times, depending on the same
+ * options. Each such snapshot is written as one aligned array per property of
+ * the particles, so that analyses can map the file into memory and scan only
+ * the properties they need. The file ends with a table of the snapshots,
+ * which is referenced by the header.
+ *
+ * The layout is described in \ref doxypage_output_columnar and in
+ * columnarreader.h, which also provides a reader.
+ */
+class ColumnarOutput : public OutputInterface {
+ public:
+  /**
+   * Create columnar particles output.
+   *
+   * \param[in] path Output path.
+   * \param[in] name Name of the output.
+   * \param[in] out_par A structure containing the parameters of the output.
+   */
+  ColumnarOutput(const std::filesystem::path &path, std::string name,
+                 const OutputParameters &out_par);
+
+  /// Write the snapshot table and complete the header.
+  ~ColumnarOutput() override;
+
+  /**
+   * Writes the initial particles of an event, unless only final particles are
+   * written.
+   * \param[in] particles Current list of all particles.
+   * \param[in] event_number Number of event.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void at_eventstart(const Particles &particles, const int event_number,
+                     const EventInfo &event) override;
+
+  /**
+   * Writes the final particles of an event.
+   * \param[in] particles Current list of particles.
+   * \param[in] event_number Number of event.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void at_eventend(const Particles &particles, const int event_number,
+                   const EventInfo &event) override;
+
+  /**
+   * Writes the particles at an output time, unless only final particles are
+   * written.
+   * \param[in] particles Current list of particles.
+   * \param[in] clock Unused, needed since inherited.
+   * \param[in] dens_param Unused, needed since inherited.
+   * \param[in] event Event info, see \ref event_info.
+   */
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param,
+                            const EventInfo &event) override;
+
+ private:
+  /**
+   * Append a snapshot to the file and the table.
+   *
+   * \param[in] particles The particles
+   * \param[in] kind When the snapshot is taken
+   * \param[in] event Event info, see \ref event_info
+   */
+  void write_snapshot(const Particles &particles, columnar::SnapshotKind kind,
+                      const EventInfo &event);
+
+  /**
+   * Write bytes to the file.
+   *
+   * \param[in] data First byte
+   * \param[in] size Number of bytes
+   */
+  void write(const void *data, std::size_t size);
+
+  /// Write zeros up to the next aligned position.
+  void write_padding();
+
+  /// Output file
+  RenamingFilePtr file_;
+  /// Header of the file, completed at the end
+  columnar::FileHeader header_{};
+  /// Whether the extended columns are written
+  bool extended_;
+  /// Whether final- or initial-state particles should be written
+  OutputOnlyFinal only_final_;
+  /// Number of the current event
+  int event_number_ = 0;
+  /// Size of the file written so far [bytes]
+  std::uint64_t offset_ = 0;
+  /// Columns in the file
+  std::vector<columnar::ColumnDescriptor> columns_;
+  /// Snapshots written so far
+  std::vector<columnar::SnapshotEntry> snapshots_;
+  /// Columns of the current snapshot, reused for all snapshots
+  std::vector<char> buffer_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_COLUMNAROUTPUT_H_
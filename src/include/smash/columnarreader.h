@@ -0,0 +1,417 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_COLUMNARREADER_H_
+#define SRC_INCLUDE_SMASH_COLUMNARREADER_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/*
+ * This header only depends on the standard library and POSIX, so that
+ * analyses can read columnar output files without linking to SMASH.
+ */
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * Layout of the files of the columnar particles output, shared by the output
+ * and ColumnarReader. See \ref doxypage_output_columnar.
+ */
+namespace columnar {
+
+/// First bytes of each file
+constexpr char magic_number[8] = {'S', 'M', 'A', 'S', 'H', 'C', 'O', 'L'};
+
+/// Version of the layout
+constexpr std::uint32_t format_version = 1;
+
+/// Alignment [bytes] of the columns and the snapshot table in the file
+constexpr std::uint64_t alignment = 64;
+
+/**
+ * Round up to the alignment.
+ *
+ * \param[in] n Offset or size [bytes]
+ * \return Smallest multiple of alignment not less than n.
+ */
+constexpr std::uint64_t align(std::uint64_t n) {
+  return (n + alignment - 1) / alignment * alignment;
+}
+
+/// Types of the elements of a column
+enum class ColumnType : std::uint32_t {
+  /// double
+  Float64 = 0,
+  /// std::int32_t
+  Int32 = 1,
+};
+
+/// Moments at which the particles are written
+enum class SnapshotKind : std::uint32_t {
+  /// Event start, before the particles are propagated
+  EventStart = 0,
+  /// Output time during the event
+  Intermediate = 1,
+  /// Event end
+  EventEnd = 2,
+};
+
+/// Header at the start of the file
+struct FileHeader {
+  /// "SMASHCOL"
+  char magic[8];
+  /// Version of the layout
+  std::uint32_t format_version;
+  /// Number of column descriptors following the header
+  std::uint32_t n_columns;
+  /// Position of the snapshot table [bytes]
+  std::uint64_t table_offset;
+  /// Number of entries in the snapshot table
+  std::uint64_t n_snapshots;
+  /// SMASH version, padded with zeros
+  char smash_version[32];
+};
+static_assert(sizeof(FileHeader) == 64, "Unexpected padding of FileHeader");
+
+/// Name and type of a column, following the file header
+struct ColumnDescriptor {
+  /// Name of the column, padded with zeros
+  char name[24];
+  /// Type of the elements
+  ColumnType type;
+  /// Size of an element [bytes]
+  std::uint32_t element_size;
+};
+static_assert(sizeof(ColumnDescriptor) == 32,
+              "Unexpected padding of ColumnDescriptor");
+
+/// Entry of the snapshot table at the end of the file
+struct SnapshotEntry {
+  /// Position of the first column of the snapshot [bytes]
+  std::uint64_t offset;
+  /// Number of particles, i.e. of elements in each column
+  std::uint64_t n_particles;
+  /// Number of the event
+  std::int32_t event;
+  /// When the snapshot was taken
+  SnapshotKind kind;
+  /// Impact parameter of the event [fm]
+  double impact_parameter;
+  /// 1 if there was no interaction between projectile and target, else 0
+  std::uint32_t empty_event;
+  /// Unused, zero
+  std::uint32_t reserved;
+};
+static_assert(sizeof(SnapshotEntry) == 40,
+              "Unexpected padding of SnapshotEntry");
+
+/**
+ * \param[in] n_columns Number of columns
+ * \return Position of the first snapshot in the file [bytes].
+ */
+constexpr std::uint64_t data_offset(std::uint32_t n_columns) {
+  return align(sizeof(FileHeader) + n_columns * sizeof(ColumnDescriptor));
+}
+
+/**
+ * Positions of the columns of a snapshot.
+ *
+ * \param[in] columns First of the column descriptors
+ * \param[in] n_columns Number of columns
+ * \param[in] n_particles Number of particles in the snapshot
+ * \return Position of each column relative to the snapshot [bytes], followed
+ *         by the size of the snapshot.
+ */
+inline std::vector<std::uint64_t> column_offsets(
+    const ColumnDescriptor *columns, std::uint32_t n_columns,
+    std::uint64_t n_particles) {
+  std::vector<std::uint64_t> offsets(n_columns + 1);
+  std::uint64_t offset = 0;
+  for (std::uint32_t i = 0; i < n_columns; i++) {
+    offsets[i] = offset;
+    offset += align(n_particles * columns[i].element_size);
+  }
+  offsets[n_columns] = offset;
+  return offsets;
+}
+
+/// Read-only view of the elements of a column in a mapped file
+template <typename T>
+class ColumnView {
+ public:
+  /**
+   * \param[in] data First element
+   * \param[in] size Number of elements
+   */
+  ColumnView(const T *data, std::size_t size) : data_(data), size_(size) {}
+  /// \return First element
+  const T *data() const { return data_; }
+  /// \return Number of elements
+  std::size_t size() const { return size_; }
+  /// \return Iterator to the first element
+  const T *begin() const { return data_; }
+  /// \return Iterator past the last element
+  const T *end() const { return data_ + size_; }
+  /**
+   * \param[in] i Index of the particle
+   * \return Element of the particle
+   */
+  const T &operator[](std::size_t i) const { return data_[i]; }
+
+ private:
+  /// First element
+  const T *data_;
+  /// Number of elements
+  std::size_t size_;
+};
+
+}  // namespace columnar
+
+/**
+ * \ingroup output
+ *
+ * Memory-maps a file of the columnar particles output and gives access to the
+ * columns of its snapshots without copying them.
+ *
+ * \code
+ * smash::ColumnarReader reader("particles_columnar.bin");
+ * for (std::size_t s = 0; s < reader.n_snapshots(); s++) {
+ *   const auto pdg = reader.column<std::int32_t>(s, "pdg");
+ *   const auto pz = reader.column<double>(s, "pz");
+ *   ...
+ * }
+ * \endcode
+ *
+ * Reading is thread-safe, e.g. the snapshots can be processed in parallel.
+ */
+class ColumnarReader {
+ public:
+  /**
+   * Map a file and check its layout.
+   *
+   * \param[in] path Path of the file
+   * \throw std::runtime_error if the file cannot be mapped or is not a
+   *        complete columnar output file.
+   */
+  explicit ColumnarReader(const std::string &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Cannot open " + path + ": " +
+                               std::strerror(errno));
+    }
+    struct stat status;
+    if (::fstat(fd, &status) != 0 ||
+        status.st_size < static_cast<off_t>(sizeof(columnar::FileHeader))) {
+      ::close(fd);
+      throw std::runtime_error(path + " is not a columnar output file.");
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      throw std::runtime_error("Cannot map " + path + ": " +
+                               std::strerror(error));
+    }
+    data_ = static_cast<const char *>(mapping);
+    try {
+      check_layout(path);
+    } catch (...) {
+      ::munmap(const_cast<char *>(data_), size_);
+      throw;
+    }
+  }
+
+  /// Unmap the file. Views of its columns become invalid.
+  ~ColumnarReader() { ::munmap(const_cast<char *>(data_), size_); }
+
+  /// Cannot be copied
+  ColumnarReader(const ColumnarReader &) = delete;
+  /// Cannot be copied
+  ColumnarReader &operator=(const ColumnarReader &) = delete;
+
+  /// \return SMASH version which wrote the file.
+  std::string smash_version() const {
+    const char *version = header_->smash_version;
+    return std::string(version,
+                       strnlen(version, sizeof(header_->smash_version)));
+  }
+
+  /// \return The column descriptors.
+  columnar::ColumnView<columnar::ColumnDescriptor> columns() const {
+    return {columns_, header_->n_columns};
+  }
+
+  /**
+   * \param[in] name Name of a column
+   * \return Whether the file has the column, e.g. extended columns are only
+   *         present if the output was extended.
+   */
+  bool has_column(std::string_view name) const {
+    return find_column(name) < header_->n_columns;
+  }
+
+  /// \return Number of snapshots in the file.
+  std::size_t n_snapshots() const { return header_->n_snapshots; }
+
+  /**
+   * \param[in] i Index of the snapshot
+   * \return Table entry of the snapshot.
+   */
+  const columnar::SnapshotEntry &snapshot(std::size_t i) const {
+    return snapshots_[i];
+  }
+
+  /**
+   * \param[in] event Number of an event
+   * \return Indices of the snapshots of the event in the order of the file.
+   */
+  std::vector<std::size_t> snapshots_of_event(std::int32_t event) const {
+    std::vector<std::size_t> result;
+    for (std::size_t i = 0; i < n_snapshots(); i++) {
+      if (snapshots_[i].event == event) {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Elements of a column in a snapshot.
+   *
+   * \tparam T double or std::int32_t, must match the type of the column
+   * \param[in] snapshot Index of the snapshot
+   * \param[in] name Name of the column
+   * \return View of the elements, one per particle.
+   * \throw std::invalid_argument if the column does not exist or has a
+   *        different type.
+   */
+  template <typename T>
+  columnar::ColumnView<T> column(std::size_t snapshot,
+                                 std::string_view name) const {
+    static_assert(std::is_same_v<T, double> || std::is_same_v<T, std::int32_t>,
+                  "Columns contain double or std::int32_t.");
+    constexpr columnar::ColumnType type = std::is_same_v<T, double>
+                                              ? columnar::ColumnType::Float64
+                                              : columnar::ColumnType::Int32;
+    const std::size_t index = find_column(name);
+    if (index == header_->n_columns || columns_[index].type != type) {
+      throw std::invalid_argument("No column \"" + std::string(name) +
+                                  "\" of the requested type.");
+    }
+    const columnar::SnapshotEntry &entry = snapshots_[snapshot];
+    const std::vector<std::uint64_t> offsets = columnar::column_offsets(
+        columns_, header_->n_columns, entry.n_particles);
+    return {reinterpret_cast<const T *>(data_ + entry.offset + offsets[index]),
+            static_cast<std::size_t>(entry.n_particles)};
+  }
+
+ private:
+  /**
+   * \param[in] name Name of a column
+   * \return Index of the column, or the number of columns if there is none.
+   */
+  std::size_t find_column(std::string_view name) const {
+    for (std::size_t i = 0; i < header_->n_columns; i++) {
+      const char *column_name = columns_[i].name;
+      if (name == std::string_view(column_name,
+                                   strnlen(column_name,
+                                           sizeof(columns_[i].name)))) {
+        return i;
+      }
+    }
+    return header_->n_columns;
+  }
+
+  /**
+   * Set the pointers into the file and check that all snapshots are within
+   * the file.
+   *
+   * \param[in] path Path of the file, for error messages
+   * \throw std::runtime_error if the layout is broken
+   */
+  void check_layout(const std::string &path) {
+    const std::runtime_error corrupt(
+        path + " is not a complete columnar output file.");
+    header_ = reinterpret_cast<const columnar::FileHeader *>(data_);
+    if (std::memcmp(header_->magic, columnar::magic_number,
+                    sizeof(columnar::magic_number)) != 0) {
+      throw corrupt;
+    }
+    if (header_->format_version != columnar::format_version) {
+      throw std::runtime_error(
+          path + " has columnar format version " +
+          std::to_string(header_->format_version) + ", but only version " +
+          std::to_string(columnar::format_version) + " is supported.");
+    }
+    const std::uint64_t table_offset = header_->table_offset;
+    const std::uint64_t n_snapshots = header_->n_snapshots;
+    constexpr std::size_t entry_size = sizeof(columnar::SnapshotEntry);
+    if (columnar::data_offset(header_->n_columns) > table_offset ||
+        table_offset % columnar::alignment != 0 || table_offset > size_ ||
+        n_snapshots > (size_ - table_offset) / entry_size) {
+      throw corrupt;
+    }
+    columns_ = reinterpret_cast<const columnar::ColumnDescriptor *>(
+        data_ + sizeof(columnar::FileHeader));
+    snapshots_ =
+        reinterpret_cast<const columnar::SnapshotEntry *>(data_ + table_offset);
+    for (std::uint32_t i = 0; i < header_->n_columns; i++) {
+      const columnar::ColumnDescriptor &column = columns_[i];
+      if (column.element_size !=
+          (column.type == columnar::ColumnType::Float64 ? 8u : 4u)) {
+        throw corrupt;
+      }
+    }
+    for (std::size_t i = 0; i < n_snapshots; i++) {
+      const columnar::SnapshotEntry &entry = snapshots_[i];
+      // Bounds the sizes below, such that they cannot overflow.
+      if (entry.n_particles > table_offset ||
+          entry.offset % columnar::alignment != 0 ||
+          entry.offset > table_offset) {
+        throw corrupt;
+      }
+      const std::uint64_t size = columnar::column_offsets(
+          columns_, header_->n_columns, entry.n_particles)[header_->n_columns];
+      if (size > table_offset - entry.offset) {
+        throw corrupt;
+      }
+    }
+  }
+
+  /// First byte of the mapped file
+  const char *data_ = nullptr;
+  /// Size of the file [bytes]
+  std::size_t size_ = 0;
+  /// Header of the file
+  const columnar::FileHeader *header_ = nullptr;
+  /// Column descriptors of the file
+  const columnar::ColumnDescriptor *columns_ = nullptr;
+  /// Snapshot table of the file
+  const columnar::SnapshotEntry *snapshots_ = nullptr;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_COLUMNARREADER_H_
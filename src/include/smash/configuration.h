@@ -689,6 +689,44 @@ class Configuration {
           "\" should be \"Chain Rule\" or \"Direct\".");
     }
 
+    /**
+     * Set BinaryCompression.
+     */
+    operator BinaryCompression() const {
+      const std::string s = operator std::string();
+      if (s == "None") {
+        return BinaryCompression::None;
+      }
+      if (s == "Builtin") {
+        return BinaryCompression::Builtin;
+      }
+      if (s == "Zstd") {
+        return BinaryCompression::Zstd;
+      }
+      if (s == "LZ4") {
+        return BinaryCompression::LZ4;
+      }
+      throw IncorrectTypeInAssignment(
+          "The value for key \"" + std::string(key_) +
+          "\" should be \"None\", \"Builtin\", \"Zstd\" or \"LZ4\".");
+    }
+
+    /**
+     * Set CoulombSolver.
+     */
+    operator CoulombSolver() const {
+      const std::string s = operator std::string();
+      if (s == "Direct") {
+        return CoulombSolver::Direct;
+      }
+      if (s == "FFT") {
+        return CoulombSolver::FFT;
+      }
+      throw IncorrectTypeInAssignment("The value for key \"" +
+                                      std::string(key_) +
+                                      "\" should be \"Direct\" or \"FFT\".");
+    }
+
     /**
      * Set SmearingMode.
      */
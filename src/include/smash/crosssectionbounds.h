@@ -0,0 +1,135 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_CROSSSECTIONBOUNDS_H_
+#define SRC_INCLUDE_SMASH_CROSSSECTIONBOUNDS_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "forwarddeclarations.h"
+#include "particledata.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ * Table of upper bounds of the total cross section of a pair of particle
+ * types in bins of the center-of-mass energy.
+ *
+ * It allows rejecting particle pairs which are too far apart to collide even
+ * with the largest cross section possible at their \f$\sqrt{s}\f$, without
+ * building all collision channels. Only pairs of stable particles on their
+ * mass shell are bounded, since otherwise the cross section depends on more
+ * than the types and \f$\sqrt{s}\f$.
+ *
+ * The bound of a bin is the maximum of the cross section evaluated at
+ * n_samples + 1 equidistant points in the bin, including its edges, and at
+ * the pole masses of all particle types inside the bin, times a safety
+ * factor. This is not a proven bound: it relies on the cross sections
+ * varying by less than the safety factor between two samples, apart from
+ * resonance peaks, which are sampled at their pole masses. The test
+ * crosssectionbounds_actual checks this for the cross sections of SMASH by
+ * dense sampling, and ScatterActionsFinder warns if a pair which passed the
+ * bound has a larger cross section.
+ * The bins are evaluated lazily on first use, since only a small part of all
+ * type pairs and energies occurs in a simulation. The cross section has to
+ * be symmetric in the two types, since a pair shares its bins with the
+ * swapped pair.
+ *
+ * The table can be used from several threads concurrently without locking.
+ * The slots of all pairs of stable types are set up on construction, the
+ * bins of a pair are allocated on its first use.
+ */
+class CrossSectionBounds {
+ public:
+  /// Total cross section [mb] of two types at a \f$\sqrt{s}\f$ [GeV]
+  using CrossSectionFunction = std::function<double(
+      const ParticleType &, const ParticleType &, double)>;
+
+  /// Width of the \f$\sqrt{s}\f$ bins [GeV].
+  static constexpr double bin_width = 0.01;
+  /// Number of intervals the bins are sampled in.
+  static constexpr int n_samples = 10;
+  /// Factor applied to the largest sampled cross section of a bin.
+  static constexpr double safety_factor = 1.2;
+  /// Largest \f$\sqrt{s}\f$ above the threshold which is tabulated [GeV].
+  static constexpr double max_sqrts_above_threshold = 50.;
+  /// Number of bins of each pair
+  static constexpr std::size_t n_bins =
+      static_cast<std::size_t>(max_sqrts_above_threshold / bin_width);
+
+  /**
+   * Construct an empty table for the stable particle types.
+   *
+   * \param[in] cross_section Computes the total cross section, which is
+   *                          bounded. It must not depend on anything else
+   *                          than its arguments.
+   */
+  explicit CrossSectionBounds(CrossSectionFunction cross_section);
+
+  /// Frees the bins
+  ~CrossSectionBounds();
+
+  /// Cannot be copied, since the bins are owned
+  CrossSectionBounds(const CrossSectionBounds &) = delete;
+  /// Cannot be copied, since the bins are owned
+  CrossSectionBounds &operator=(const CrossSectionBounds &) = delete;
+
+  /**
+   * Upper bound of the total cross section of two particles.
+   *
+   * \param[in] data_a first particle
+   * \param[in] data_b second particle
+   * \return An upper bound of the total cross section [mb] or infinity, if
+   *         no bound is known for the pair.
+   */
+  double upper_bound(const ParticleData &data_a,
+                     const ParticleData &data_b) const;
+
+ private:
+  /**
+   * Evaluate the bound of one bin.
+   *
+   * \param[in] type_a type of the first particle
+   * \param[in] type_b type of the second particle
+   * \param[in] sqrts_min lower edge of the bin [GeV]
+   * \return Bound of the cross section in the bin [mb].
+   */
+  double evaluate_bin(const ParticleType &type_a, const ParticleType &type_b,
+                      double sqrts_min) const;
+
+  /**
+   * \param[in] type a particle type
+   * \return Index of the type among the stable types, -1 if it is not stable.
+   */
+  int stable_index(const ParticleType &type) const;
+
+  /// Function computing the bounded cross section.
+  CrossSectionFunction cross_section_;
+
+  /// Index of each particle type among the stable ones, -1 for other types
+  std::vector<int> stable_index_;
+
+  /**
+   * Bins of each unordered pair of stable types, nullptr until the pair is
+   * first used. The bins start at the threshold and are negative until they
+   * are evaluated.
+   */
+  std::unique_ptr<std::atomic<std::atomic<double> *>[]> pair_bins_;
+
+  /// Number of entries of pair_bins_
+  std::size_t n_pairs_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_CROSSSECTIONBOUNDS_H_
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2020,2022
+ *    Copyright (c) 2014-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -30,10 +30,15 @@ class DecayActionsFinder : public ActionFinderInterface {
    * \param[in] res_lifetime_factor The multiplicative factor to be applied to
    *                                resonance lifetimes; default is 1
    * \param[in] do_weak_decays whether to perform weak decays at the end
+   * \param[in] tabulated_widths whether to sample the decay times with the
+   *                             widths tabulated by
+   *                             ParticleType::tabulate_decay_widths
    */
-  explicit DecayActionsFinder(double res_lifetime_factor, bool do_weak_decays)
+  explicit DecayActionsFinder(double res_lifetime_factor, bool do_weak_decays,
+                              bool tabulated_widths = false)
       : res_lifetime_factor_(res_lifetime_factor),
-        do_final_weak_decays_(do_weak_decays) {}
+        do_final_weak_decays_(do_weak_decays),
+        tabulated_widths_(tabulated_widths) {}
 
   /**
    * Check the whole particle list for decays.
@@ -60,6 +65,21 @@ class DecayActionsFinder : public ActionFinderInterface {
     return {};
   }
 
+  /**
+   * Sample the decay times of the unstable particles once, instead of in every
+   * time step. The decay time of a particle is kept until its momentum or
+   * formation time change or the time passes without the particle decaying,
+   * e.g. due to Pauli blocking. Since the decays are exponentially
+   * distributed, this gives the same decay law as sampling in every time step.
+   *
+   * find_actions_in_cell uses the scheduled decay times, and samples one for
+   * the particles without, such that only the particles of the ensemble
+   * passed here need to be scheduled at the beginning of each time step.
+   *
+   * \param[inout] particles particles of an ensemble, which are scheduled
+   */
+  void schedule_decays(Particles &particles) const;
+
   /**
    * Force all resonances to decay at the end of the simulation.
    *
@@ -80,6 +100,19 @@ class DecayActionsFinder : public ActionFinderInterface {
    * so electro-magnetic decays are done as well.
    */
   const bool do_final_weak_decays_;
+
+  /// Sample the decay times with tabulated instead of exact widths?
+  const bool tabulated_widths_;
+
+ private:
+  /**
+   * Sample the time until a particle decays.
+   *
+   * \param[in] p decaying particle
+   * \param[in] width total width of its hadronic decays [GeV]
+   * \return Time from the time of the particle until its decay [fm].
+   */
+  double sample_decay_time(const ParticleData &p, double width) const;
 };
 
 }  // namespace smash
@@ -0,0 +1,469 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_DEFERREDOUTPUT_H_
+#define SRC_INCLUDE_SMASH_DEFERREDOUTPUT_H_
+
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "action.h"
+#include "clock.h"
+#include "outputinterface.h"
+#include "particles.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ * \brief Snapshot of an Action as it is seen by the outputs.
+ *
+ * It keeps the incoming and outgoing particles, the time, the type and the
+ * weights of the recorded action at the moment of the recording, so that the
+ * original action can be changed or destroyed afterwards.
+ */
+class RecordedAction : public Action {
+ public:
+  /**
+   * Record the given action.
+   *
+   * \param[in] action The action to be recorded
+   */
+  explicit RecordedAction(const Action &action)
+      : Action(action.incoming_particles(), action.outgoing_particles(),
+               action.time_of_execution(), action.get_type()),
+        total_weight_(action.get_total_weight()),
+        partial_weight_(action.get_partial_weight()) {
+    box_length_ = action.box_length_;
+    stochastic_position_idx_ = action.stochastic_position_idx_;
+  }
+
+  double get_total_weight() const override { return total_weight_; }
+  double get_partial_weight() const override { return partial_weight_; }
+
+  /// The final state is already known, there is nothing to generate.
+  void generate_final_state() override {}
+
+  /**
+   * Function for debug output of the recorded action.
+   * \param[in] out Location of the output stream
+   */
+  void format_debug_output(std::ostream &out) const override {
+    out << "Recorded action of " << incoming_particles_.size() << " to "
+        << outgoing_particles_.size() << " particles.";
+  }
+
+ private:
+  /// Total weight of the recorded action
+  const double total_weight_;
+  /// Partial weight of the recorded action
+  const double partial_weight_;
+};
+
+/**
+ * \ingroup output
+ * \brief Output that records all calls and hands them on later.
+ *
+ * When several ensembles or events are evolved concurrently, they cannot write
+ * directly to the outputs, since the outputs are shared and the order of the
+ * writes would depend on the thread scheduling. Instead every ensemble or event
+ * writes to its own DeferredOutput objects. All arguments of the calls are
+ * copied, and the calls are handed on to the actual outputs in the order of
+ * the ensembles or events once these are done. This reproduces the order in
+ * which the outputs are written when everything is evolved one after the
+ * other.
+ *
+ * The thermalizer output cannot be deferred, since the GrandCanThermalizer
+ * cannot be copied.
+ */
+class DeferredOutput : public OutputInterface {
+ public:
+  /// Recorded calls, bound to the actual output
+  using Calls = std::vector<std::function<void()>>;
+
+  /**
+   * Create a deferred output for the given output.
+   *
+   * \param[in] target Output to which the calls are handed on. It has to
+   *                   outlive the DeferredOutput object and the recorded calls.
+   */
+  explicit DeferredOutput(OutputInterface &target)
+      : OutputInterface(name_of(target)), target_(target) {}
+
+  void at_eventstart(const Particles &particles, const int event_number,
+                     const EventInfo &info) override {
+    record([particles = snapshot(particles), event_number,
+            info](OutputInterface &out) {
+      out.at_eventstart(*particles, event_number, info);
+    });
+  }
+
+  void at_eventstart(const std::vector<Particles> &ensembles,
+                     int event_number) override {
+    record([ensembles = snapshot(ensembles),
+            event_number](OutputInterface &out) {
+      out.at_eventstart(*ensembles, event_number);
+    });
+  }
+
+  void at_eventstart(const int event_number, const ThermodynamicQuantity tq,
+                     const DensityType dens_type,
+                     RectangularLattice<DensityOnLattice> lattice) override {
+    record([event_number, tq, dens_type,
+            lattice = std::move(lattice)](OutputInterface &out) {
+      out.at_eventstart(event_number, tq, dens_type, lattice);
+    });
+  }
+
+  void at_eventstart(
+      const int event_number, const ThermodynamicQuantity tq,
+      const DensityType dens_type,
+      RectangularLattice<EnergyMomentumTensor> lattice) override {
+    record([event_number, tq, dens_type,
+            lattice = std::move(lattice)](OutputInterface &out) {
+      out.at_eventstart(event_number, tq, dens_type, lattice);
+    });
+  }
+
+  void at_eventend(const int event_number, const ThermodynamicQuantity tq,
+                   const DensityType dens_type) override {
+    record([event_number, tq, dens_type](OutputInterface &out) {
+      out.at_eventend(event_number, tq, dens_type);
+    });
+  }
+
+  void at_eventend(const ThermodynamicQuantity tq) override {
+    record([tq](OutputInterface &out) { out.at_eventend(tq); });
+  }
+
+  void at_eventend(const Particles &particles, const int event_number,
+                   const EventInfo &info) override {
+    record([particles = snapshot(particles), event_number,
+            info](OutputInterface &out) {
+      out.at_eventend(*particles, event_number, info);
+    });
+  }
+
+  void at_eventend(const std::vector<Particles> &ensembles,
+                   const int event_number) override {
+    record([ensembles = snapshot(ensembles),
+            event_number](OutputInterface &out) {
+      out.at_eventend(*ensembles, event_number);
+    });
+  }
+
+  void at_interaction(const Action &action, const double density) override {
+    record([action = std::make_shared<const RecordedAction>(action),
+            density](OutputInterface &out) {
+      out.at_interaction(*action, density);
+    });
+  }
+
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param,
+                            const EventInfo &info) override {
+    record([particles = snapshot(particles), clock = snapshot(clock),
+            dens_param, info](OutputInterface &out) {
+      out.at_intermediate_time(*particles, *clock, dens_param, info);
+    });
+  }
+
+  void at_intermediate_time(const std::vector<Particles> &ensembles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param) override {
+    record([ensembles = snapshot(ensembles), clock = snapshot(clock),
+            dens_param](OutputInterface &out) {
+      out.at_intermediate_time(*ensembles, *clock, dens_param);
+    });
+  }
+
+  void thermodynamics_output(
+      const ThermodynamicQuantity tq, const DensityType dt,
+      RectangularLattice<DensityOnLattice> &lattice) override {
+    record([tq, dt, lattice = snapshot(lattice)](OutputInterface &out) {
+      out.thermodynamics_output(tq, dt, *lattice);
+    });
+  }
+
+  void thermodynamics_output(
+      const ThermodynamicQuantity tq, const DensityType dt,
+      RectangularLattice<EnergyMomentumTensor> &lattice) override {
+    record([tq, dt, lattice = snapshot(lattice)](OutputInterface &out) {
+      out.thermodynamics_output(tq, dt, *lattice);
+    });
+  }
+
+  void thermodynamics_lattice_output(
+      RectangularLattice<DensityOnLattice> &lattice,
+      const double current_time) override {
+    record([lattice = snapshot(lattice), current_time](OutputInterface &out) {
+      out.thermodynamics_lattice_output(*lattice, current_time);
+    });
+  }
+
+  void thermodynamics_lattice_output(
+      RectangularLattice<DensityOnLattice> &lattice, const double current_time,
+      const std::vector<Particles> &ensembles,
+      const DensityParameters &dens_param) override {
+    record([lattice = snapshot(lattice), current_time,
+            ensembles = snapshot(ensembles), dens_param](OutputInterface &out) {
+      out.thermodynamics_lattice_output(*lattice, current_time, *ensembles,
+                                        dens_param);
+    });
+  }
+
+  void thermodynamics_lattice_output(
+      const ThermodynamicQuantity tq,
+      RectangularLattice<EnergyMomentumTensor> &lattice,
+      const double current_time) override {
+    record([tq, lattice = snapshot(lattice),
+            current_time](OutputInterface &out) {
+      out.thermodynamics_lattice_output(tq, *lattice, current_time);
+    });
+  }
+
+  /**
+   * \throw std::logic_error, since the thermalizer cannot be copied.
+   */
+  void thermodynamics_output(const GrandCanThermalizer &) override {
+    throw std::logic_error("The thermalizer output cannot be deferred.");
+  }
+
+  void fields_output(
+      const std::string name1, const std::string name2,
+      RectangularLattice<std::pair<ThreeVector, ThreeVector>> &lat) override {
+    record([name1, name2, lat = snapshot(lat)](OutputInterface &out) {
+      out.fields_output(name1, name2, *lat);
+    });
+  }
+
+  /// Hand on all recorded calls to the actual output and forget them.
+  void flush() {
+    for (const auto &call : calls_) {
+      call();
+    }
+    calls_.clear();
+  }
+
+  /**
+   * Take the recorded calls out of this object, e.g. to hand them on later
+   * from another thread.
+   *
+   * \return The recorded calls, in the order in which they were made
+   */
+  Calls take_calls() { return std::exchange(calls_, {}); }
+
+ private:
+  /**
+   * \param[in] output Output whose kind should be reproduced
+   * \return Output name that leads to the same kind of output, see the
+   *         OutputInterface constructor
+   */
+  static std::string name_of(const OutputInterface &output) {
+    if (output.is_dilepton_output()) {
+      return "Dileptons";
+    } else if (output.is_photon_output()) {
+      return "Photons";
+    } else if (output.is_IC_output()) {
+      return "SMASH_IC";
+    }
+    return "Deferred";
+  }
+
+  /**
+   * Record a call.
+   *
+   * \param[in] call Function making the call on the given output
+   */
+  template <typename F>
+  void record(F &&call) {
+    calls_.emplace_back(
+        [&target = target_, call = std::forward<F>(call)]() { call(target); });
+  }
+
+  /**
+   * \param[in] particles Particles to be copied
+   * \return A copy of the particles, which can be shared by recorded calls
+   */
+  static std::shared_ptr<const Particles> snapshot(const Particles &particles) {
+    auto copy = std::make_shared<Particles>();
+    copy->copy_from(particles);
+    return copy;
+  }
+
+  /**
+   * \param[in] ensembles Ensembles to be copied
+   * \return A copy of the ensembles, which can be shared by recorded calls
+   */
+  static std::shared_ptr<const std::vector<Particles>> snapshot(
+      const std::vector<Particles> &ensembles) {
+    auto copy = std::make_shared<std::vector<Particles>>(ensembles.size());
+    for (size_t i = 0; i < ensembles.size(); i++) {
+      (*copy)[i].copy_from(ensembles[i]);
+    }
+    return copy;
+  }
+
+  /**
+   * The outputs only ask the clock for the current time and the timestep, so
+   * the copy is a UniformClock with these values.
+   *
+   * \param[in] clock Clock to be copied
+   * \return A copy of the clock, which can be shared by recorded calls
+   */
+  static std::shared_ptr<const std::unique_ptr<Clock>> snapshot(
+      const std::unique_ptr<Clock> &clock) {
+    return std::make_shared<const std::unique_ptr<Clock>>(
+        std::make_unique<UniformClock>(clock->current_time(),
+                                       clock->timestep_duration(),
+                                       clock->next_time()));
+  }
+
+  /**
+   * \param[in] lattice Lattice to be copied
+   * \return A copy of the lattice, which can be shared by recorded calls.
+   *         It is not const, since the outputs take the lattices by non-const
+   *         reference.
+   */
+  template <typename T>
+  static std::shared_ptr<RectangularLattice<T>> snapshot(
+      const RectangularLattice<T> &lattice) {
+    return std::make_shared<RectangularLattice<T>>(lattice);
+  }
+
+  /// The actual output
+  OutputInterface &target_;
+  /// Recorded calls, in the order in which they were made
+  Calls calls_;
+};
+
+/**
+ * \ingroup output
+ * \brief Hands on the recorded output of concurrently evolved events in the
+ * order of the event numbers.
+ *
+ * Events can be submitted in any order and from any thread. Whenever the
+ * recorded output of the next event in line is complete, it is written by the
+ * thread that submitted the last missing piece, together with all following
+ * events that are already complete. Only one thread writes at a time, so the
+ * outputs need not be thread-safe.
+ *
+ * A thread submitting an event too far ahead of the next one in line waits
+ * until the gap has closed. Otherwise a single slow event would let the
+ * recorded output of all other threads pile up in memory.
+ */
+class OutputSequencer {
+ public:
+  /**
+   * \param[in] first_event Number of the first event to be written
+   * \param[in] max_ahead Submitting an event at least this far ahead of the
+   *            next one in line waits until the gap is smaller. It has to be
+   *            positive. At most max_ahead events are then kept in memory.
+   */
+  explicit OutputSequencer(
+      int first_event = 0,
+      int max_ahead = std::numeric_limits<int>::max())
+      : next_event_(first_event), max_ahead_(max_ahead) {
+    if (max_ahead < 1) {
+      throw std::invalid_argument(
+          "OutputSequencer needs to accept at least the next event.");
+    }
+  }
+
+  /**
+   * Submit the recorded output of an event.
+   *
+   * The event with the number next in line is never held back, so a thread
+   * that submits its events in increasing order cannot block the others for
+   * good.
+   *
+   * \param[in] event_number Number of the event
+   * \param[in] calls Recorded calls of the event, see DeferredOutput
+   */
+  void submit(int event_number, DeferredOutput::Calls &&calls) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_.wait(lock, [&] {
+      return cancelled_ || event_number - next_event_ < max_ahead_;
+    });
+    if (cancelled_) {
+      return;
+    }
+    pending_.emplace(event_number, std::move(calls));
+    if (writing_) {
+      // The writing thread also picks up this event once it is next in line.
+      return;
+    }
+    writing_ = true;
+    for (auto next = pending_.find(next_event_); next != pending_.end();
+         next = pending_.find(next_event_)) {
+      DeferredOutput::Calls next_calls = std::move(next->second);
+      pending_.erase(next);
+      lock.unlock();
+      try {
+        for (const auto &call : next_calls) {
+          call();
+        }
+      } catch (...) {
+        lock.lock();
+        writing_ = false;
+        throw;
+      }
+      lock.lock();
+      next_event_++;
+      written_.notify_all();
+    }
+    writing_ = false;
+  }
+
+  /**
+   * Give up on writing further events, because one of them will never be
+   * submitted. Waiting and later submissions return without writing.
+   */
+  void cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_ = true;
+    pending_.clear();
+    written_.notify_all();
+  }
+
+  /// \return Number of submitted events that are not written yet
+  std::size_t n_pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+  }
+
+ private:
+  /// Protects all members below
+  mutable std::mutex mutex_;
+  /// Signals that the next event in line has been written
+  std::condition_variable written_;
+  /// Number of the next event to be written
+  int next_event_;
+  /// How far ahead of the next event in line an event may be submitted
+  const int max_ahead_;
+  /// Whether a thread is currently writing
+  bool writing_ = false;
+  /// Whether writing was given up, see cancel()
+  bool cancelled_ = false;
+  /// Recorded output of the events that cannot be written yet
+  std::map<int, DeferredOutput::Calls> pending_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_DEFERREDOUTPUT_H_
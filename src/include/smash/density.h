@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2022
+ *    Copyright (c) 2014-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -9,7 +9,11 @@
 #ifndef SRC_INCLUDE_SMASH_DENSITY_H_
 #define SRC_INCLUDE_SMASH_DENSITY_H_
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
 #include <tuple>
 #include <typeinfo>
 #include <utility>
@@ -23,6 +27,7 @@
 #include "particledata.h"
 #include "particles.h"
 #include "pdgcode.h"
+#include "threadpool.h"
 #include "threevector.h"
 
 namespace smash {
@@ -114,7 +119,8 @@ class DensityParameters {
    *            the cutoff factor \f$a\f$ where the cutoff radius
    *            \f$r_{\rm cut}=a\sigma\f$, the test-particle number, the number
    *            of ensembles, the mode of calculating the derivatives, the
-   *            smearing mode, the central weight for Discrete smearing, the
+   *            smearing mode, whether tables are used for the Gaussian
+   *            smearing, the central weight for Discrete smearing, the
    *            range (in units of lattice spacing) for Triangular smearing
    *            and the flag about using only participants or also spectators
    */
@@ -126,6 +132,7 @@ class DensityParameters {
         derivatives_(par.derivatives_mode),
         rho_derivatives_(par.rho_derivatives_mode),
         smearing_(par.smearing_mode),
+        gaussian_tables_(par.gaussian_smearing_tables),
         central_weight_(par.discrete_weight),
         triangular_range_(par.triangular_range),
         only_participants_(par.only_participants) {
@@ -149,6 +156,11 @@ class DensityParameters {
   }
   /// \return Smearing mode
   SmearingMode smearing() const { return smearing_; }
+  /**
+   * \return Whether the Gaussian smearing on the lattice uses
+   *         GaussianSmearingTable
+   */
+  bool gaussian_tables() const { return gaussian_tables_; }
   /// \return Weight of the central cell in the discrete smearing
   double central_weight() const { return central_weight_; }
   /// \return Range of the triangular smearing, in units of lattice spacing
@@ -189,6 +201,8 @@ class DensityParameters {
   const RestFrameDensityDerivativesMode rho_derivatives_;
   /// Mode of smearing
   const SmearingMode smearing_;
+  /// Whether the Gaussian smearing on the lattice uses GaussianSmearingTable
+  const bool gaussian_tables_;
   /// Weight of the central cell in the discrete smearing
   const double central_weight_;
   /// Range of the triangular smearing
@@ -218,6 +232,124 @@ std::pair<double, ThreeVector> unnormalized_smearing_factor(
     const ThreeVector &r, const FourVector &p, const double m_inv,
     const DensityParameters &dens_par, const bool compute_gradient = false);
 
+/**
+ * Gives the same smearing factors of one particle as
+ * unnormalized_smearing_factor on the cells of a lattice, but with far fewer
+ * exponentials.
+ *
+ * The exponent of the covariant Gaussian is a quadratic function of the cell
+ * index along each row of cells in x direction. Therefore the factors of a
+ * row follow from the one at its maximum by multiplying with the exponentials
+ * of the first differences of the exponent, which themselves change by a
+ * constant factor from cell to cell. This takes three exponentials per row
+ * instead of one per cell, i.e. \f$ \mathcal{O}(R_\mathrm{cut}^2) \f$ instead
+ * of \f$ \mathcal{O}(R_\mathrm{cut}^3) \f$ per particle. Starting from the
+ * maximum, all ratios are at most of order one, such that nothing overflows
+ * even for strongly boosted particles. The factors agree with
+ * unnormalized_smearing_factor up to rounding errors, which grow with the
+ * square of the number of cells in a row.
+ *
+ * The rows are tabulated when first needed, such that rows outside of the
+ * cut-off or skipped by the caller cost nothing.
+ */
+class GaussianSmearingTable {
+ public:
+  /**
+   * Prepare the table for a particle.
+   *
+   * \param[in] lower_bounds lowest indices of the cells in x, y and z
+   *            direction, see RectangularLattice::rectangle_bounds
+   * \param[in] upper_bounds indices after the highest ones
+   * \param[in] origin origin of the lattice [fm]
+   * \param[in] cell_sizes sizes of the lattice cells [fm]
+   * \param[in] pos position of the particle [fm]
+   * \param[in] p four-momentum of the particle [GeV]
+   * \param[in] m_inv inverse mass of the particle [GeV\f$^{-1}\f$]
+   * \param[in] dens_par object containing precomputed parameters for
+   *            density calculation.
+   */
+  void prepare(const std::array<int, 3> &lower_bounds,
+               const std::array<int, 3> &upper_bounds,
+               const std::array<double, 3> &origin,
+               const std::array<double, 3> &cell_sizes, const ThreeVector &pos,
+               const FourVector &p, double m_inv,
+               const DensityParameters &dens_par);
+
+  /**
+   * Look up the smearing factor of the prepared particle for a cell.
+   *
+   * \param[in] ix index of the cell in x direction, within the bounds
+   *            given to prepare
+   * \param[in] iy index of the cell in y direction
+   * \param[in] iz index of the cell in z direction
+   * \param[in] compute_gradient option, true - compute gradient, false - no
+   * \return (smearing factor, the gradient of the smearing factor or a zero
+   *         three vector), like unnormalized_smearing_factor for the vector
+   *         from the cell center to the particle
+   */
+  std::pair<double, ThreeVector> smearing_factor(int ix, int iy, int iz,
+                                                 bool compute_gradient) {
+    const int jx = ix - lower_bounds_[0];
+    const int jy = iy - lower_bounds_[1];
+    const int jz = iz - lower_bounds_[2];
+    const ThreeVector r(distances_[0][jx], distances_[1][jy],
+                        distances_[2][jz]);
+    const double r_sqr = r.sqr();
+    // Distance from particle to point of interest > r_cut
+    if (r_sqr > r_cut_sqr_) {
+      return std::make_pair(0.0, ThreeVector(0.0, 0.0, 0.0));
+    }
+    const double u_r_scalar = r * u_.threevec();
+    const double r_rest_sqr = r_sqr + u_r_scalar * u_r_scalar;
+    // Lorentz contracted distance from particle to point of interest > r_cut
+    if (r_rest_sqr > r_cut_sqr_) {
+      return std::make_pair(0.0, ThreeVector(0.0, 0.0, 0.0));
+    }
+
+    const std::size_t row_index = jy + static_cast<std::size_t>(n_[1]) * jz;
+    if (!row_ready_[row_index]) {
+      tabulate_row(jy, jz);
+    }
+    const double sf = exponentials_[jx + n_[0] * row_index] * u_.x0();
+    const ThreeVector sf_grad = compute_gradient
+                                    ? sf * (r + u_.threevec() * u_r_scalar) *
+                                          two_sig_sqr_inv_ * 2.0
+                                    : ThreeVector(0.0, 0.0, 0.0);
+
+    return std::make_pair(sf, sf_grad);
+  }
+
+ private:
+  /**
+   * Calculate the exponentials of a row of cells in x direction.
+   *
+   * \param[in] jy index of the row in y direction, relative to the lowest
+   * \param[in] jz index of the row in z direction, relative to the lowest
+   */
+  void tabulate_row(int jy, int jz);
+
+  /// Lowest indices of the cells
+  std::array<int, 3> lower_bounds_;
+  /// Number of cells in x, y and z direction
+  std::array<int, 3> n_;
+  /// Sizes of the lattice cells [fm]
+  std::array<double, 3> cell_sizes_;
+  /// Distances of the particle from the cell centers along each axis [fm]
+  std::array<std::vector<double>, 3> distances_;
+  /// Four-velocity of the particle
+  FourVector u_;
+  /// Squared cut-off radius [fm\f$^2\f$]
+  double r_cut_sqr_;
+  /// \f$ (2 \sigma^2)^{-1} \f$ [fm\f$^{-2}\f$]
+  double two_sig_sqr_inv_;
+  /// Ratio of successive ratios of the exponentials in a row
+  double second_ratio_;
+  /// Exponentials of all cells, row by row
+  std::vector<double> exponentials_;
+  /// Whether a row has been tabulated
+  std::vector<char> row_ready_;
+};
+
 /**
  * Calculates Eckart rest frame density and 4-current of a given density type
  * and optionally the gradient of the density in an arbitary frame (grad j0),
@@ -527,28 +659,60 @@ class DensityOnLattice {
 typedef RectangularLattice<DensityOnLattice> DensityLattice;
 
 /**
- * Updates the contents on the lattice.
+ * Updates the contents on several lattices with identical structure in a
+ * single sweep over the particles.
  *
- * \param[out] lat The lattice on which the content will be updated
+ * Gives the same lattices as calling update_lattice for each target, but the
+ * smearing kernel is evaluated only once for every particle and node and
+ * then added to all targets for which the particle has a non-zero density
+ * factor.
+ *
+ * If a thread pool is given, the lattices are split into slabs of planes in
+ * z direction. Each task sweeps over all particles, skipping the ones that do
+ * not reach its slab, and adds the contributions only to the nodes of its
+ * slab. As every node still receives the contributions in the order of the
+ * particles, the lattices are identical bit for bit to the ones of a serial
+ * update, for any number of threads.
+ *
+ * \param[in] targets the lattices on which the content will be updated,
+ *            together with the density type to be computed on each. Lattices
+ *            which are nullptr or not updated at \p update are skipped.
  * \param[in] update tells if called for update at printout or at timestep
- * \param[in] dens_type density type to be computed on the lattice
  * \param[in] par a structure containing testparticles number and gaussian
  *            smearing parameters.
  * \param[in] ensembles the particles vector for each ensemble
  * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] pool threads sharing the work, serial update if nullptr
  * \tparam T LatticeType
+ * \throw invalid_argument if the lattices have different structure
  */
 template <typename T>
-void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
-                    const DensityType dens_type, const DensityParameters &par,
-                    const std::vector<Particles> &ensembles,
-                    const bool compute_gradient) {
-  // Do not proceed if lattice does not exists/update not required
-  if (lat == nullptr || lat->when_update() != update) {
+void update_lattices(
+    const std::vector<std::pair<RectangularLattice<T> *, DensityType>> &targets,
+    const LatticeUpdate update, const DensityParameters &par,
+    const std::vector<Particles> &ensembles, const bool compute_gradient,
+    ThreadPool *pool = nullptr) {
+  // Do not proceed for lattices which do not exist/need no update
+  std::vector<std::pair<RectangularLattice<T> *, DensityType>> to_update;
+  for (const auto &target : targets) {
+    if (target.first != nullptr && target.first->when_update() == update) {
+      to_update.push_back(target);
+    }
+  }
+  if (to_update.empty()) {
     return;
   }
+  RectangularLattice<T> *lat = to_update[0].first;
+  for (const auto &target : to_update) {
+    if (!lat->identical_to_lattice(target.first)) {
+      throw std::invalid_argument(
+          "Lattices updated together should have the"
+          " same origin/dims/periodicity.");
+    }
+    target.first->reset();
+  }
+  const std::size_t n_targets = to_update.size();
 
-  lat->reset();
   // get the normalization factor for the covariant Gaussian smearing
   const double norm_factor_gaus = par.norm_factor_sf();
   // get the volume of the cell and weights for discrete smearing
@@ -568,78 +732,249 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
        triangular_radius[0] * triangular_radius[1] * triangular_radius[1] *
        triangular_radius[2] * triangular_radius[2]);
 
-  for (const Particles &particles : ensembles) {
-    for (const ParticleData &part : particles) {
-      if (par.only_participants()) {
-        // if this conditions holds, the hadron is a spectator
-        if (part.get_history().collisions_per_particle == 0) {
-          continue;
-        }
+  const int n_planes = lat->n_cells()[2];
+  const int nodes_per_plane = lat->n_cells()[0] * lat->n_cells()[1];
+  const double z_origin = lat->origin()[2];
+  const double z_cell = lat->cell_sizes()[2];
+  const double z_length = lat->lattice_sizes()[2];
+  /* Largest distance in z direction of a node from a particle contributing to
+   * it, with a margin of one cell against rounding. */
+  const double z_reach =
+      z_cell +
+      (par.smearing() == SmearingMode::CovariantGaussian ? par.r_cut()
+       : par.smearing() == SmearingMode::Triangular     ? triangular_radius[2]
+                                                        : 1.5 * z_cell);
+
+  /* Add the contributions of all particles to the planes
+   * [first_plane, end_plane) of the lattices. */
+  auto smear_onto_planes = [&](int first_plane, int end_plane) {
+    const bool all_planes = first_plane == 0 && end_plane == n_planes;
+    const double z_min = z_origin + first_plane * z_cell - z_reach;
+    const double z_max = z_origin + end_plane * z_cell + z_reach;
+    // whether a particle at z can contribute to the planes
+    auto reaches_planes = [&](double z) {
+      if (all_planes) {
+        return true;
       }
-      const double dens_factor = density_factor(part.type(), dens_type);
-      if (std::abs(dens_factor) < really_small) {
-        continue;
+      if (!lat->periodic()) {
+        return z >= z_min && z <= z_max;
       }
-      const FourVector p_mu = part.momentum();
-      const ThreeVector pos = part.position().threevec();
-
-      // act accordingly to which smearing is used
-      if (par.smearing() == SmearingMode::CovariantGaussian) {
-        const double m = p_mu.abs();
-        if (unlikely(m < really_small)) {
-          logg[LDensity].warn("Gaussian smearing is undefined for momentum ",
-                              p_mu);
+      if (2 * z_reach >= z_length) {
+        return true;
+      }
+      z = z_origin + std::fmod(z - z_origin, z_length);
+      if (z < z_origin) {
+        z += z_length;
+      }
+      return (z >= z_min && z <= z_max) ||
+             (z - z_length >= z_min && z - z_length <= z_max) ||
+             (z + z_length >= z_min && z + z_length <= z_max);
+    };
+    // whether the node with the given index is on the planes
+    auto on_planes = [&](std::size_t index) {
+      const int plane = index / nodes_per_plane;
+      return plane >= first_plane && plane < end_plane;
+    };
+    // density factors of the current particle for each target
+    std::vector<double> dens_factors(n_targets);
+    // smearing factors of the current particle for Gaussian smearing
+    GaussianSmearingTable gaussian_table;
+    // weights of the current particle along each axis for triangular smearing
+    std::array<std::vector<double>, 3> triangular_weights;
+
+    for (const Particles &particles : ensembles) {
+      for (const ParticleData &part : particles) {
+        if (par.only_participants()) {
+          // if this conditions holds, the hadron is a spectator
+          if (part.get_history().collisions_per_particle == 0) {
+            continue;
+          }
+        }
+        const ThreeVector pos = part.position().threevec();
+        if (!reaches_planes(pos.x3())) {
+          continue;
+        }
+        bool contributes = false;
+        for (std::size_t k = 0; k < n_targets; k++) {
+          dens_factors[k] = density_factor(part.type(), to_update[k].second);
+          if (std::abs(dens_factors[k]) < really_small) {
+            dens_factors[k] = 0.;
+          } else {
+            contributes = true;
+          }
+        }
+        if (!contributes) {
           continue;
         }
-        const double m_inv = 1.0 / m;
-
-        // unweighted contribution to density
-        const double common_weight = dens_factor * norm_factor_gaus;
-        lat->iterate_in_cube(
-            pos, par.r_cut(), [&](T &node, int ix, int iy, int iz) {
-              // find the weight for smearing
-              const ThreeVector r = lat->cell_center(ix, iy, iz);
-              const auto sf = unnormalized_smearing_factor(
-                  pos - r, p_mu, m_inv, par, compute_gradient);
-              node.add_particle(part, sf.first * common_weight);
-              if (par.derivatives() == DerivativesMode::CovariantGaussian) {
-                node.add_particle_for_derivatives(part, dens_factor,
-                                                  sf.second * norm_factor_gaus);
-              }
-            });
-      } else if (par.smearing() == SmearingMode::Discrete) {
-        // unweighted contribution to density
-        const double common_weight =
-            dens_factor / (par.ntest() * par.nensembles() * V_cell);
-        lat->iterate_nearest_neighbors(
-            pos, [&](T &node, int iterated_index, int center_index) {
-              node.add_particle(
-                  part, common_weight *
-                            // the contribution to density is weighted depending
-                            // on what node it is added to
-                            (iterated_index == center_index ? big : small));
-            });
-      } else if (par.smearing() == SmearingMode::Triangular) {
-        // unweighted contribution to density
-        const double common_weight = dens_factor * prefactor_triangular;
-        lat->iterate_in_rectangle(
-            pos, triangular_radius, [&](T &node, int ix, int iy, int iz) {
-              // compute the position of the node
-              const ThreeVector cell_center = lat->cell_center(ix, iy, iz);
-              // compute smearing weight
-              const double weight_x =
-                  triangular_radius[0] - std::abs(cell_center[0] - pos[0]);
-              const double weight_y =
-                  triangular_radius[1] - std::abs(cell_center[1] - pos[1]);
-              const double weight_z =
-                  triangular_radius[2] - std::abs(cell_center[2] - pos[2]);
-              // add the contribution to the node
-              node.add_particle(part,
-                                common_weight * weight_x * weight_y * weight_z);
-            });
+        const FourVector p_mu = part.momentum();
+
+        // act accordingly to which smearing is used
+        if (par.smearing() == SmearingMode::CovariantGaussian) {
+          const double m = p_mu.abs();
+          if (unlikely(m < really_small)) {
+            // with several slabs, the warning is logged before smearing
+            if (all_planes) {
+              logg[LDensity].warn(
+                  "Gaussian smearing is undefined for momentum ", p_mu);
+            }
+            continue;
+          }
+          const double m_inv = 1.0 / m;
+          if (par.gaussian_tables()) {
+            const auto [lower, upper] = lat->rectangle_bounds(
+                pos, {par.r_cut(), par.r_cut(), par.r_cut()});
+            gaussian_table.prepare(lower, upper, lat->origin(),
+                                   lat->cell_sizes(), pos, p_mu, m_inv, par);
+          }
+
+          lat->iterate_in_cube(
+              pos, par.r_cut(), [&](T &node, int ix, int iy, int iz) {
+                const std::size_t index = lat->index_of(node);
+                if (!on_planes(index)) {
+                  return;
+                }
+                // find the weight for smearing, common to all targets
+                const auto sf =
+                    par.gaussian_tables()
+                        ? gaussian_table.smearing_factor(ix, iy, iz,
+                                                         compute_gradient)
+                        : unnormalized_smearing_factor(
+                              pos - lat->cell_center(ix, iy, iz), p_mu, m_inv,
+                              par, compute_gradient);
+                for (std::size_t k = 0; k < n_targets; k++) {
+                  if (dens_factors[k] == 0.) {
+                    continue;
+                  }
+                  T &target_node = (*to_update[k].first)[index];
+                  // unweighted contribution to density
+                  const double common_weight =
+                      dens_factors[k] * norm_factor_gaus;
+                  target_node.add_particle(part, sf.first * common_weight);
+                  if (par.derivatives() == DerivativesMode::CovariantGaussian) {
+                    target_node.add_particle_for_derivatives(
+                        part, dens_factors[k], sf.second * norm_factor_gaus);
+                  }
+                }
+              });
+        } else if (par.smearing() == SmearingMode::Discrete) {
+          lat->iterate_nearest_neighbors(
+              pos, [&](T &, int iterated_index, int center_index) {
+                if (!on_planes(iterated_index)) {
+                  return;
+                }
+                // the contribution to density is weighted depending on what
+                // node it is added to
+                const double weight =
+                    iterated_index == center_index ? big : small;
+                for (std::size_t k = 0; k < n_targets; k++) {
+                  if (dens_factors[k] == 0.) {
+                    continue;
+                  }
+                  // unweighted contribution to density
+                  const double common_weight =
+                      dens_factors[k] /
+                      (par.ntest() * par.nensembles() * V_cell);
+                  (*to_update[k].first)[iterated_index].add_particle(
+                      part, common_weight * weight);
+                }
+              });
+        } else if (par.smearing() == SmearingMode::Triangular) {
+          /* The weight factorizes into one per axis, which only depend on the
+           * distance of the cell centers in that direction. */
+          const auto bounds = lat->rectangle_bounds(pos, triangular_radius);
+          const std::array<int, 3> &lower = bounds.first;
+          for (int i = 0; i < 3; i++) {
+            triangular_weights[i].clear();
+            for (int j = lower[i]; j < bounds.second[i]; j++) {
+              const double cell_center =
+                  lat->origin()[i] + lat->cell_sizes()[i] * (j + 0.5);
+              triangular_weights[i].push_back(triangular_radius[i] -
+                                              std::abs(cell_center - pos[i]));
+            }
+          }
+          lat->iterate_in_rectangle(
+              pos, triangular_radius, [&](T &node, int ix, int iy, int iz) {
+                const std::size_t index = lat->index_of(node);
+                if (!on_planes(index)) {
+                  return;
+                }
+                // look up the smearing weight
+                const double weight_x = triangular_weights[0][ix - lower[0]];
+                const double weight_y = triangular_weights[1][iy - lower[1]];
+                const double weight_z = triangular_weights[2][iz - lower[2]];
+                for (std::size_t k = 0; k < n_targets; k++) {
+                  if (dens_factors[k] == 0.) {
+                    continue;
+                  }
+                  // unweighted contribution to density
+                  const double common_weight =
+                      dens_factors[k] * prefactor_triangular;
+                  // add the contribution to the node
+                  (*to_update[k].first)[index].add_particle(
+                      part, common_weight * weight_x * weight_y * weight_z);
+                }
+              });
+        }
+      }  // end of for (const ParticleData &part : particles)
+    }    // end of for (const Particles &particles : ensembles)
+  };
+
+  if (pool == nullptr || pool->size() == 1 || n_planes == 1) {
+    smear_onto_planes(0, n_planes);
+  } else {
+    /* A particle is only seen by the slabs it reaches, so warn once about
+     * every particle with undefined Gaussian smearing before. */
+    if (par.smearing() == SmearingMode::CovariantGaussian) {
+      for (const Particles &particles : ensembles) {
+        for (const ParticleData &part : particles) {
+          if (par.only_participants() &&
+              part.get_history().collisions_per_particle == 0) {
+            continue;
+          }
+          const FourVector p_mu = part.momentum();
+          if (likely(p_mu.abs() >= really_small)) {
+            continue;
+          }
+          for (const auto &target : to_update) {
+            if (std::abs(density_factor(part.type(), target.second)) >=
+                really_small) {
+              logg[LDensity].warn(
+                  "Gaussian smearing is undefined for momentum ", p_mu);
+              break;
+            }
+          }
+        }
       }
-    }  // end of for (const ParticleData &part : particles)
-  }    // end of for (const Particles &particles : ensembles)
+    }
+    // more slabs than threads to balance the load of dense regions
+    const int n_slabs = std::min(n_planes, 4 * pool->size());
+    pool->parallel_for(n_slabs, [&](int slab) {
+      smear_onto_planes(slab * n_planes / n_slabs,
+                        (slab + 1) * n_planes / n_slabs);
+    });
+  }
+}
+
+/**
+ * Updates the contents on the lattice.
+ *
+ * \param[out] lat The lattice on which the content will be updated
+ * \param[in] update tells if called for update at printout or at timestep
+ * \param[in] dens_type density type to be computed on the lattice
+ * \param[in] par a structure containing testparticles number and gaussian
+ *            smearing parameters.
+ * \param[in] ensembles the particles vector for each ensemble
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] pool threads sharing the work, serial update if nullptr
+ * \tparam T LatticeType
+ */
+template <typename T>
+void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
+                    const DensityType dens_type, const DensityParameters &par,
+                    const std::vector<Particles> &ensembles,
+                    const bool compute_gradient, ThreadPool *pool = nullptr) {
+  update_lattices<T>({{lat, dens_type}}, update, par, ensembles,
+                     compute_gradient, pool);
 }
 
 /**
@@ -669,6 +1004,81 @@ void update_lattice(
     const LatticeUpdate update, const DensityType dens_type,
     const DensityParameters &par, const std::vector<Particles> &ensembles,
     const double time_step, const bool compute_gradient);
+
+/**
+ * A lattice of DensityOnLattice type to be updated by update_lattices together
+ * with others.
+ */
+struct DensityLatticeTarget {
+  /// Lattice on which the content will be updated
+  RectangularLattice<DensityOnLattice> *lattice;
+  /// Density type to be computed on the lattice
+  DensityType dens_type;
+  /**
+   * Whether the finite difference and rest frame density derivatives are
+   * calculated afterwards, as done by update_lattice with the auxiliary
+   * lattices.
+   */
+  bool derivatives;
+};
+
+/**
+ * Updates the contents on several lattices of DensityOnLattice type with
+ * identical structure in a single sweep over the particles, see the template
+ * version of update_lattices. The targets with derivatives are the same as
+ * after update_lattice with the auxiliary lattices, the others as after
+ * update_lattice without them.
+ *
+ * \param[in] targets The lattices on which the content will be updated
+ * \param[in] old_jmu Auxiliary lattice, needed for calculating time
+ *            derivatives
+ * \param[in] new_jmu Auxiliary lattice, needed for calculating time
+ *            derivatives
+ * \param[in] four_grad_lattice Auxiliary lattice for calculating the
+ *            fourgradient of the current
+ * \param[in] update Tells if called for update at printout or at timestep
+ * \param[in] par a structure containing testparticles number and gaussian
+ *            smearing parameters.
+ * \param[in] ensembles The particles vector for each ensemble
+ * \param[in] time_step Time step used in the simulation
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] pool threads sharing the smearing, serial update if nullptr
+ */
+void update_lattices(
+    const std::vector<DensityLatticeTarget> &targets,
+    RectangularLattice<FourVector> *old_jmu,
+    RectangularLattice<FourVector> *new_jmu,
+    RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
+    const LatticeUpdate update, const DensityParameters &par,
+    const std::vector<Particles> &ensembles, const double time_step,
+    const bool compute_gradient, ThreadPool *pool = nullptr);
+
+/**
+ * Gives a lattice of DensityOnLattice type the content of updating it again
+ * with update_lattice and the auxiliary lattices, while the particles did not
+ * change since the last update, without smearing them again. The currents and
+ * spatial derivatives stay the same, while the finite difference time
+ * derivatives vanish, because the currents at t0 and t0 + dt are the same.
+ *
+ * \param[out] lat The lattice of DensityOnLattice type on which the content
+ *             will be updated
+ * \param[in] old_jmu Auxiliary lattice, needed for calculating time
+ *            derivatives
+ * \param[in] new_jmu Auxiliary lattice, needed for calculating time
+ *            derivatives
+ * \param[in] four_grad_lattice Auxiliary lattice for calculating the
+ *            fourgradient of the current
+ * \param[in] update Tells if called for update at printout or at timestep
+ * \param[in] par a structure containing the derivatives modes
+ * \param[in] time_step Time step used in the simulation
+ */
+void repeat_lattice_update(
+    RectangularLattice<DensityOnLattice> *lat,
+    RectangularLattice<FourVector> *old_jmu,
+    RectangularLattice<FourVector> *new_jmu,
+    RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
+    const LatticeUpdate update, const DensityParameters &par,
+    const double time_step);
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_DENSITY_H_
@@ -8,9 +8,14 @@
 #define SRC_INCLUDE_SMASH_EXPERIMENT_H_
 
 #include <algorithm>
+#include <exception>
+#include <functional>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -20,7 +25,9 @@
 #include "chrono.h"
 #include "decayactionsfinder.h"
 #include "decayactionsfinderdilepton.h"
+#include "deferredoutput.h"
 #include "energymomentumtensor.h"
+#include "fftcoulombsolver.h"
 #include "fields.h"
 #include "fourvector.h"
 #include "grandcan_thermalizer.h"
@@ -36,8 +43,10 @@
 #include "scatteractionsfinder.h"
 #include "stringprocess.h"
 #include "thermalizationaction.h"
+#include "threadpool.h"
 // Output
 #include "binaryoutput.h"
+#include "columnaroutput.h"
 #ifdef SMASH_USE_HEPMC
 #include "hepmcoutput.h"
 #endif
@@ -113,6 +122,9 @@ class ExperimentBase {
    * \param[inout] config The configuration object that sets all initial
    * conditions of the experiment. \param[in] output_path The directory where
    * the output files are written.
+   * \param[in] n_event_threads Number of events that are evolved at the same
+   *            time, each on its own thread. With more than one thread, the
+   *            output is identical to the one of a serial run.
    *
    * \return An owning pointer to the Experiment object, using the
    *         ExperimentBase interface.
@@ -120,12 +132,15 @@ class ExperimentBase {
    * \throws InvalidModusRequest This exception is thrown if the \p
    *         Modus string in the \p config object does not contain a valid
    *         string.
+   * \throws std::invalid_argument if \p n_event_threads is smaller than 1 or
+   *         if the \p config cannot be run with several event threads.
    *
    * Most of the Configuration values are read starting from this function. The
    * configuration itself is documented in \ref doxypage_input_conf_general
    */
   static std::unique_ptr<ExperimentBase> create(
-      Configuration &config, const std::filesystem::path &output_path);
+      Configuration &config, const std::filesystem::path &output_path,
+      int n_event_threads = 1);
 
   /**
    * Runs the experiment.
@@ -152,6 +167,21 @@ class ExperimentBase {
   struct NonExistingOutputPathRequest : public std::invalid_argument {
     using std::invalid_argument::invalid_argument;
   };
+
+ private:
+  /**
+   * Create an Experiment<Modus> together with the experiments that evolve its
+   * events concurrently, see ExperimentBase::create.
+   *
+   * \param[inout] config The configuration object of the experiment
+   * \param[in] output_path The directory where the output files are written
+   * \param[in] n_event_threads Number of events evolved at the same time
+   * \return An owning pointer to the Experiment object
+   */
+  template <typename Modus>
+  static std::unique_ptr<ExperimentBase> create_experiment(
+      Configuration &config, const std::filesystem::path &output_path,
+      int n_event_threads);
 };
 
 template <typename Modus>
@@ -210,7 +240,8 @@ class Experiment : public ExperimentBase {
    * \param[in] output_path The directory where the output files are written.
    */
   explicit Experiment(Configuration &config,
-                      const std::filesystem::path &output_path);
+                      const std::filesystem::path &output_path)
+      : Experiment(config, output_path, nullptr) {}
 
   /**
    * This is called in the beginning of each event. It initializes particles
@@ -270,6 +301,37 @@ class Experiment : public ExperimentBase {
   void increase_event_number();
 
  private:
+  /**
+   * Create a new Experiment, possibly one that evolves events for another
+   * experiment.
+   *
+   * \param[inout] config The Configuration object, see the public constructor
+   * \param[in] output_path The directory where the output files are written.
+   * \param[in] main_outputs If not null, no output files are created. Instead
+   *            all output calls are recorded for the given outputs of the main
+   *            experiment, see run_events_concurrently.
+   */
+  Experiment(Configuration &config, const std::filesystem::path &output_path,
+             OutputsList *main_outputs);
+
+  /// Evolve a single event from its initial conditions to the final output.
+  void run_event();
+
+  /**
+   * Evolve all events with the experiments in event_workers_, each on its own
+   * thread. Each worker evolves every n-th event, where n is the number of
+   * workers. The recorded output of the events is written to the outputs of
+   * this experiment in the order of the event numbers, such that the output
+   * is identical to the one of a serial run.
+   */
+  void run_events_concurrently();
+
+  /**
+   * Make the potentials of this experiment accessible to the actions that are
+   * evaluated on the calling thread, see potential_globals.h.
+   */
+  void set_potential_globals() const;
+
   /**
    * Perform the given action.
    *
@@ -297,13 +359,47 @@ class Experiment : public ExperimentBase {
                      const OutputParameters &par);
 
   /**
-   * Propagate all particles until time to_time without any interactions
-   * and shine dileptons.
+   * Propagate all particles of an ensemble until time to_time without any
+   * interactions and shine dileptons.
    *
    * \param[in] to_time Time at the end of propagation [fm]
-   * \param[in, out] particles Particles to be propagated
+   * \param[in] i_ensemble index of ensemble to be propagated
+   */
+  void propagate_and_shine(double to_time, int i_ensemble);
+
+  /**
+   * Run the given task for every ensemble.
+   *
+   * With ensemble threads (see \ref key_gen_ensemble_threads_) each task uses
+   * the random number engine of its ensemble and, if requested, the tasks run
+   * concurrently. Afterwards the results of the ensembles are merged in
+   * ensemble order by merge_ensemble_results.
+   *
+   * \param[in] task Function taking the ensemble index
+   * \param[in] concurrently Whether the tasks may run at the same time. This
+   *                         is only allowed if a task exclusively changes the
+   *                         state of its own ensemble.
+   */
+  void for_each_ensemble(const std::function<void(int)> &task,
+                         bool concurrently);
+
+  /**
+   * Add the interaction counters of an ensemble to the event totals and write
+   * its deferred interactions to the outputs.
+   *
+   * \param[in] i_ensemble index of the ensemble
    */
-  void propagate_and_shine(double to_time, Particles &particles);
+  void merge_ensemble_results(int i_ensemble);
+
+  /**
+   * \param[in] i_ensemble index of an ensemble
+   * \return The outputs that the interactions of the given ensemble are
+   *         written to. With ensemble threads these defer the writing until
+   *         merge_ensemble_results is called.
+   */
+  const OutputsList &outputs_of(int i_ensemble) const {
+    return ensemble_threads_ ? deferred_outputs_[i_ensemble] : outputs_;
+  }
 
   /**
    * Performs all the propagations and actions during a certain time interval
@@ -408,6 +504,79 @@ class Experiment : public ExperimentBase {
    */
   std::vector<bool> projectile_target_interact_;
 
+  /**
+   * Interaction bookkeeping of a single ensemble.
+   *
+   * perform_action() and run_time_evolution_timestepless() only change the
+   * counters of the ensemble they act on, such that several ensembles can be
+   * evolved at the same time. The counters are added to the event totals by
+   * merge_ensemble_results().
+   */
+  struct EnsembleCounters {
+    /// Number of performed actions since the last merge
+    uint64_t interactions = 0;
+    /// Number of wall crossings since the last merge
+    uint64_t wall_actions = 0;
+    /// Number of Pauli-blocked actions since the last merge
+    uint64_t pauli_blocked = 0;
+    /// Number of hypersurface crossings since the last merge
+    uint64_t hypersurface_crossing_actions = 0;
+    /// Number of discarded actions since the last merge
+    uint64_t discarded_interactions = 0;
+    /// Energy removed in hypersurface crossings since the last merge
+    double energy_removed = 0.0;
+    /// Energy violation introduced by Pythia since the last merge
+    double energy_violated_by_Pythia = 0.0;
+    /// Whether the projectile and the target collided since the last merge
+    bool projectile_target_interact = false;
+    /// Number of performed actions in the current event, never merged
+    uint64_t interactions_in_event = 0;
+  };
+
+  /// Interaction counters, one for each ensemble
+  std::vector<EnsembleCounters> ensemble_counters_;
+
+  /// Type of the grid created by the modus
+  using ModusGrid = decltype(std::declval<const Modus &>().create_grid(
+      std::declval<const Particles &>(), 0., 0., CollisionCriterion::Geometric,
+      false));
+
+  /**
+   * Grids of the ensembles, one for each ensemble. They are created at the
+   * beginning of each time step and kept until its end, such that particles
+   * produced during the time step only need to be compared with the particles
+   * in the neighboring cells. A nullptr if no actions were searched in the
+   * current time step.
+   */
+  std::vector<std::unique_ptr<ModusGrid>> ensemble_grids_;
+
+  /**
+   * Threads evolving the ensembles concurrently and sharing the density
+   * smearing for the potentials, only present if more than one ensemble
+   * thread is requested.
+   */
+  std::unique_ptr<ThreadPool> ensemble_threads_;
+
+  /**
+   * Random number streams of the ensembles, only used with ensemble threads.
+   * They are split off the stream of the event at its start, so that each
+   * ensemble has its own random numbers, independent of the thread it runs on.
+   */
+  std::vector<random::Stream> ensemble_streams_;
+
+  /**
+   * Outputs deferring the interactions of each ensemble, only used with
+   * ensemble threads. Same order as outputs_.
+   */
+  std::vector<OutputsList> deferred_outputs_;
+
+  /**
+   * Experiments evolving the events of this one concurrently, one per event
+   * thread. Empty if this experiment evolves its events itself. They are
+   * declared after outputs_, since they hand on their output to it.
+   */
+  std::vector<std::unique_ptr<Experiment>> event_workers_;
+
   /**
    * The initial nucleons in the ColliderModus propagate with
    * beam_momentum_, if Fermi motion is frozen. It's only valid in
@@ -421,6 +590,13 @@ class Experiment : public ExperimentBase {
   /// The Dilepton Action Finder
   std::unique_ptr<DecayActionsFinderDilepton> dilepton_finder_;
 
+  /**
+   * The decay finder in action_finders_, if the decay times are sampled once
+   * per particle at the beginning of the time steps instead of in every time
+   * step, nullptr otherwise
+   */
+  const DecayActionsFinder *decay_scheduler_ = nullptr;
+
   /// The (Scatter) Actions Finder for Direct Photons
   std::unique_ptr<ActionFinderInterface> photon_finder_;
 
@@ -481,6 +657,9 @@ class Experiment : public ExperimentBase {
   std::unique_ptr<RectangularLattice<std::pair<ThreeVector, ThreeVector>>>
       EM_lat_;
 
+  /// Solver of the fields in EM_lat_, if they are calculated by FFT
+  std::unique_ptr<FFTCoulombSolver> fft_coulomb_solver_;
+
   /// Lattices of energy-momentum tensors for printout
   std::unique_ptr<RectangularLattice<EnergyMomentumTensor>> Tmn_;
 
@@ -531,10 +710,10 @@ class Experiment : public ExperimentBase {
   std::unique_ptr<GrandCanThermalizer> thermalizer_;
 
   /**
-   * Pointer to the string process class object,
-   * which is used to set the random seed for PYTHIA objects in each event.
+   * Pointers to the string process class objects (one per ensemble thread),
+   * which are used to set the random seed for PYTHIA objects in each event.
    */
-  StringProcess *process_string_ptr_;
+  std::vector<StringProcess *> process_string_ptrs_;
 
   /**
    * Number of events.
@@ -756,6 +935,9 @@ void Experiment<Modus>::create_output(const std::string &format,
       outputs_.emplace_back(std::make_unique<BinaryOutputInitialConditions>(
           output_path, content, out_par));
     }
+  } else if (format == "Columnar" && content == "Particles") {
+    outputs_.emplace_back(
+        std::make_unique<ColumnarOutput>(output_path, content, out_par));
   } else if (format == "Oscar1999" || format == "Oscar2013") {
     outputs_.emplace_back(
         create_oscar_output(format, content, output_path, out_par));
@@ -870,7 +1052,8 @@ ExperimentParameters create_experiment_parameters(Configuration &config);
 
 template <typename Modus>
 Experiment<Modus>::Experiment(Configuration &config,
-                              const std::filesystem::path &output_path)
+                              const std::filesystem::path &output_path,
+                              OutputsList *main_outputs)
     : parameters_(create_experiment_parameters(config)),
       density_param_(DensityParameters(parameters_)),
       modus_(std::invoke([&]() {
@@ -971,6 +1154,10 @@ Experiment<Modus>::Experiment(Configuration &config,
     n_fractional_photons_ =
         config.take({"Collision_Term", "Photons", "Fractional_Photons"}, 100);
   }
+  const bool decay_width_tables =
+      config.take({"Collision_Term", "Decay_Width_Tables"}, false);
+  const bool persistent_decay_times =
+      config.take({"Collision_Term", "Persistent_Decay_Times"}, false);
   if (parameters_.two_to_one) {
     if (parameters_.res_lifetime_factor < 0.) {
       throw std::invalid_argument(
@@ -983,8 +1170,16 @@ Experiment<Modus>::Experiment(Configuration &config,
           "inelastically (e.g. resonance chains), else SMASH is known to "
           "hang.");
     }
-    action_finders_.emplace_back(std::make_unique<DecayActionsFinder>(
-        parameters_.res_lifetime_factor, parameters_.do_weak_decays));
+    if (decay_width_tables) {
+      ParticleType::tabulate_decay_widths();
+    }
+    auto decay_finder = std::make_unique<DecayActionsFinder>(
+        parameters_.res_lifetime_factor, parameters_.do_weak_decays,
+        decay_width_tables);
+    if (persistent_decay_times) {
+      decay_scheduler_ = decay_finder.get();
+    }
+    action_finders_.emplace_back(std::move(decay_finder));
   }
   bool no_coll = config.take({"Collision_Term", "No_Collisions"}, false);
   if ((parameters_.two_to_one || parameters_.included_2to2.any() ||
@@ -996,12 +1191,11 @@ Experiment<Modus>::Experiment(Configuration &config,
         std::make_unique<ScatterActionsFinder>(config, parameters_);
     max_transverse_distance_sqr_ =
         scat_finder->max_transverse_distance_sqr(parameters_.testparticles);
-    process_string_ptr_ = scat_finder->get_process_string_ptr();
+    process_string_ptrs_ = scat_finder->get_process_string_ptrs();
     action_finders_.emplace_back(std::move(scat_finder));
   } else {
     max_transverse_distance_sqr_ =
         parameters_.maximum_cross_section / M_PI * fm2_mb;
-    process_string_ptr_ = NULL;
   }
   if (modus_.is_box()) {
     action_finders_.emplace_back(
@@ -1143,6 +1337,7 @@ Experiment<Modus>::Experiment(Configuration &config,
    *                 computational frame or (optionally) only at the event end.
    *   - Available formats: \ref doxypage_output_oscar_particles,
    *                        \ref doxypage_output_binary, \ref
+   *                        doxypage_output_columnar, \ref
    *                        doxypage_output_root, \ref doxypage_output_vtk, \ref
    *                        doxypage_output_hepmc
    * - \b Collisions List of interactions: collisions, decays, box wall
@@ -1195,6 +1390,11 @@ Experiment<Modus>::Experiment(Configuration &config,
    *   - Saves coordinates and momenta with the full double precision
    *   - General file structure is similar to \ref doxypage_output_oscar
    *   - Detailed description: \ref doxypage_output_binary
+   * - \b "Columnar" - binary output of the particle lists as one array per
+   *   property, for "Particles" content
+   *   - Can be memory-mapped, such that analyses read only the properties
+   *     they need
+   *   - Detailed description: \ref doxypage_output_columnar
    * - \b "Root" - binary output in the format used by ROOT software
    *     (http://root.cern.ch)
    *   - Even faster to read and write, requires less disk space
@@ -1353,6 +1553,10 @@ Experiment<Modus>::Experiment(Configuration &config,
   dens_type_ = config.take({"Output", "Density_Type"}, DensityType::None);
   logg[LExperiment].debug()
       << "Density type printed to headers: " << dens_type_;
+  const int binary_buffer_mib =
+      config.take({"Output", "Binary_Buffer_Size"}, 16);
+  const BinaryCompression binary_compression =
+      config.take({"Output", "Binary_Compression"}, BinaryCompression::None);
 
   /* Parse configuration about output contents and formats, doing all logical
    * checks about specified formats, creating all needed output objects. */
@@ -1378,7 +1582,21 @@ Experiment<Modus>::Experiment(Configuration &config,
         return output_conf.take({content.c_str(), "Format"},
                                 std::vector<std::string>{});
       });
-  const OutputParameters output_parameters(std::move(output_conf));
+  OutputParameters output_parameters(std::move(output_conf));
+  if (binary_buffer_mib < 0) {
+    throw std::invalid_argument(
+        "Binary_Buffer_Size must not be negative, but is " +
+        std::to_string(binary_buffer_mib) + ".");
+  }
+  output_parameters.binary_buffer_size =
+      static_cast<std::size_t>(binary_buffer_mib) * 1024 * 1024;
+  if (!is_available(binary_compression)) {
+    std::ostringstream message;
+    message << "Binary_Compression \"" << binary_compression
+            << "\" is not available, because SMASH was built without it.";
+    throw std::invalid_argument(message.str());
+  }
+  output_parameters.binary_compression = binary_compression;
   std::size_t total_number_of_requested_formats = 0;
   auto abort_because_of_invalid_input_file = []() {
     throw std::invalid_argument("Invalid configuration input file.");
@@ -1403,10 +1621,18 @@ Experiment<Modus>::Experiment(Configuration &config,
       }
     }
     for (const auto &format : list_of_formats[i]) {
-      create_output(format, output_contents[i], output_path, output_parameters);
+      if (!main_outputs) {
+        create_output(format, output_contents[i], output_path,
+                      output_parameters);
+      }
       ++total_number_of_requested_formats;
     }
   }
+  if (main_outputs) {
+    for (const auto &output : *main_outputs) {
+      outputs_.emplace_back(std::make_unique<DeferredOutput>(*output));
+    }
+  }
   if (outputs_.size() != total_number_of_requested_formats) {
     logg[LExperiment].fatal()
         << "At least one invalid output format has been provided.";
@@ -1698,6 +1924,10 @@ Experiment<Modus>::Experiment(Configuration &config,
         EM_lat_ = std::make_unique<
             RectangularLattice<std::pair<ThreeVector, ThreeVector>>>(
             l, n, origin, periodic, LatticeUpdate::EveryTimestep);
+        if (potentials_->coulomb_solver() == CoulombSolver::FFT) {
+          fft_coulomb_solver_ = std::make_unique<FFTCoulombSolver>(
+              *jmu_el_lat_, potentials_->coulomb_r_cut());
+        }
       }
       if (potentials_->use_vdf()) {
         jmu_B_lat_ = std::make_unique<DensityLattice>(
@@ -1757,11 +1987,7 @@ Experiment<Modus>::Experiment(Configuration &config,
   }
 
   // Store pointers to potential and lattice accessible for Action
-  if (parameters_.potential_affect_threshold) {
-    UB_lat_pointer = UB_lat_.get();
-    UI3_lat_pointer = UI3_lat_.get();
-    pot_pointer = potentials_.get();
-  }
+  set_potential_globals();
 
   // Throw fatal if DerivativesMode == FiniteDifference and lattice is not on.
   if ((parameters_.derivatives_mode == DerivativesMode::FiniteDifference) &&
@@ -1777,6 +2003,28 @@ Experiment<Modus>::Experiment(Configuration &config,
     thermalizer_ = modus_.create_grandcan_thermalizer(th_conf);
   }
 
+  if (parameters_.n_ensemble_threads > 1) {
+    logg[LExperiment].info("Evolving the ensembles with ",
+                           parameters_.n_ensemble_threads, " threads.");
+    if (pauli_blocker_) {
+      logg[LExperiment].info(
+          "Pauli blocking needs all ensembles, only the action finding is "
+          "done concurrently.");
+    }
+    /* Evaluate everything that is lazily initialized on first use, so that
+     * the threads only read the shared particle types. */
+    ParticleType::precompute_lazy_properties();
+    ensemble_threads_ =
+        std::make_unique<ThreadPool>(parameters_.n_ensemble_threads);
+    ensemble_streams_.resize(parameters_.n_ensembles);
+    deferred_outputs_.resize(parameters_.n_ensembles);
+    for (OutputsList &deferred : deferred_outputs_) {
+      for (const auto &output : outputs_) {
+        deferred.emplace_back(std::make_unique<DeferredOutput>(*output));
+      }
+    }
+  }
+
   /* Take the seed setting only after the configuration was stored to a file
    * in smash.cc */
   seed_ = config.take({"General", "Randomseed"});
@@ -1856,6 +2104,19 @@ EventInfo fill_event_info(const std::vector<Particles> &ensembles,
                           bool projectile_target_interact,
                           bool kinematic_cut_for_SMASH_IC);
 
+/**
+ * Draw the seed of the next event from the stream of the current event.
+ *
+ * The seed has to be positive, so it can be entered in the config. We have to
+ * be careful about the minimal integer, whose absolute value cannot be
+ * represented.
+ *
+ * \param[inout] stream The random number stream of the current event, right
+ *                      after it was seeded
+ * \return The seed of the next event
+ */
+int64_t draw_next_event_seed(random::Stream &stream);
+
 template <typename Modus>
 void Experiment<Modus>::initialize_new_event() {
   random::set_seed(seed_);
@@ -1865,17 +2126,22 @@ void Experiment<Modus>::initialize_new_event() {
    *
    * We have to be careful about the minimal integer, whose absolute value
    * cannot be represented. */
-  int64_t r = random::advance();
-  while (r == INT64_MIN) {
-    r = random::advance();
-  }
-  seed_ = std::abs(r);
+  seed_ = draw_next_event_seed(random::current_stream());
   /* Set the random seed used in PYTHIA hadronization
    * to be same with the SMASH one.
    * In this way we ensure that the results are reproducible
    * for every event if one knows SMASH random seed. */
-  if (process_string_ptr_ != NULL) {
-    process_string_ptr_->init_pythia_hadron_rndm();
+  for (StringProcess *string_process : process_string_ptrs_) {
+    string_process->init_pythia_hadron_rndm();
+  }
+  /* The adaptive maxima of the resonance mass sampling start anew in every
+   * event on every thread, such that an event does not depend on the events
+   * evolved before it, which differ between serial and concurrent events. */
+  ParticleType::reset_max_factors();
+  if (ensemble_threads_) {
+    ensemble_threads_->parallel_for(ensemble_threads_->size(), [](int) {
+      ParticleType::reset_max_factors();
+    });
   }
 
   for (Particles &particles : ensembles_) {
@@ -1901,6 +2167,12 @@ void Experiment<Modus>::initialize_new_event() {
   for (Particles &particles : ensembles_) {
     modus_.impose_boundary_conditions(&particles, outputs_);
   }
+  /* Every ensemble gets its own random numbers during the evolution, derived
+   * from the event seed, such that the result does not depend on which thread
+   * evolves which ensemble. */
+  for (size_t i_ens = 0; i_ens < ensemble_streams_.size(); i_ens++) {
+    ensemble_streams_[i_ens] = random::current_stream().split(i_ens);
+  }
   // Reset the simulation clock
   double timestep = delta_time_startup_;
 
@@ -1946,6 +2218,9 @@ void Experiment<Modus>::initialize_new_event() {
   discarded_interactions_total_ = 0;
   total_pauli_blocked_ = 0;
   projectile_target_interact_.assign(parameters_.n_ensembles, false);
+  ensemble_counters_.assign(parameters_.n_ensembles, EnsembleCounters{});
+  ensemble_grids_.clear();
+  ensemble_grids_.resize(parameters_.n_ensembles);
   total_hypersurface_crossing_actions_ = 0;
   total_energy_removed_ = 0.0;
   total_energy_violated_by_Pythia_ = 0.0;
@@ -2053,13 +2328,28 @@ void Experiment<Modus>::initialize_new_event() {
   }
 }
 
+/**
+ * Make sure `interactions_total` can be represented as a 32-bit integer.
+ * This is necessary for converting to a `id_process`. The latter is 32-bit
+ * integer, because it is written like this to binary output.
+ *
+ * \param[in] interactions_total Total interaction number
+ */
+inline void check_interactions_total(uint64_t interactions_total) {
+  constexpr uint64_t max_uint32 = std::numeric_limits<uint32_t>::max();
+  if (interactions_total >= max_uint32) {
+    throw std::runtime_error("Integer overflow in total interaction number!");
+  }
+}
+
 template <typename Modus>
 bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
                                        bool include_pauli_blocking) {
   Particles &particles = ensembles_[i_ensemble];
+  EnsembleCounters &counters = ensemble_counters_[i_ensemble];
   // Make sure to skip invalid and Pauli-blocked actions.
   if (!action.is_valid(particles)) {
-    discarded_interactions_total_++;
+    counters.discarded_interactions++;
     logg[LExperiment].debug(~einhard::DRed(), "✘ ", action,
                             " (discarded: invalid)");
     return false;
@@ -2068,7 +2358,7 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
   logg[LExperiment].debug("Process Type is: ", action.get_type());
   if (include_pauli_blocking && pauli_blocker_ &&
       action.is_pauli_blocked(ensembles_, *pauli_blocker_)) {
-    total_pauli_blocked_++;
+    counters.pauli_blocked++;
     return false;
   }
 
@@ -2084,23 +2374,35 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
       }
     }
     if (count_target > 0 && count_projectile > 0) {
-      projectile_target_interact_[i_ensemble] = true;
+      counters.projectile_target_interact = true;
     }
   }
 
   /* Make sure to pick a non-zero integer, because 0 is reserved for "no
-   * interaction yet". */
-  const auto id_process = static_cast<uint32_t>(interactions_total_ + 1);
+   * interaction yet". With ensemble threads the ensembles interleave their
+   * process ids, which keeps them unique and independent of the scheduling. */
+  const uint64_t id_process =
+      ensemble_threads_
+          ? counters.interactions_in_event * parameters_.n_ensembles +
+                i_ensemble + 1
+          : interactions_total_ + counters.interactions + 1;
+  check_interactions_total(id_process);
   // we perform the action and collect possible energy violations by Pythia
-  total_energy_violated_by_Pythia_ += action.perform(&particles, id_process);
+  counters.energy_violated_by_Pythia +=
+      action.perform(&particles, static_cast<uint32_t>(id_process));
 
-  interactions_total_++;
+  if (pauli_blocker_) {
+    pauli_blocker_->add_to_index(action.outgoing_particles(), i_ensemble);
+  }
+
+  counters.interactions++;
+  counters.interactions_in_event++;
   if (action.get_type() == ProcessType::Wall) {
-    wall_actions_total_++;
+    counters.wall_actions++;
   }
   if (action.get_type() == ProcessType::HyperSurfaceCrossing) {
-    total_hypersurface_crossing_actions_++;
-    total_energy_removed_ += action.incoming_particles()[0].momentum().x0();
+    counters.hypersurface_crossing_actions++;
+    counters.energy_removed += action.incoming_particles()[0].momentum().x0();
   }
   // Calculate Eckart rest frame density at the interaction point
   double rho = 0.0;
@@ -2129,7 +2431,7 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
    * their x coordinates would be 0.1 and 9.9 fm and interaction point
    * position could be either at 10 fm or at 5 fm.
    */
-  for (const auto &output : outputs_) {
+  for (const auto &output : outputs_of(i_ensemble)) {
     if (!output->is_dilepton_output() && !output->is_photon_output()) {
       if (output->is_IC_output() &&
           action.get_type() == ProcessType::HyperSurfaceCrossing) {
@@ -2171,7 +2473,7 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
     // Now add the actual photon reaction channel.
     photon_act.add_single_process();
 
-    photon_act.perform_photons(outputs_);
+    photon_act.perform_photons(outputs_of(i_ensemble));
   }
 
   if (bremsstrahlung_switch_ &&
@@ -2201,7 +2503,7 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
     // Now add the actual bremsstrahlung reaction channel.
     brems_act.add_single_process();
 
-    brems_act.perform_bremsstrahlung(outputs_);
+    brems_act.perform_bremsstrahlung(outputs_of(i_ensemble));
   }
 
   logg[LExperiment].debug(~einhard::Green(), "✔ ", action);
@@ -2239,6 +2541,7 @@ void Experiment<Modus>::run_time_evolution(const double t_end,
       auto action_add_particles = std::make_unique<FreeforallAction>(
           ParticleList{}, add_plist, action_time);
       perform_action(*action_add_particles, 0);
+      merge_ensemble_results(0);
     }
     if (!remove_plist.empty()) {
       validate_and_adjust_particle_list(remove_plist);
@@ -2269,6 +2572,7 @@ void Experiment<Modus>::run_time_evolution(const double t_end,
       auto action_remove_particles = std::make_unique<FreeforallAction>(
           remove_plist, ParticleList{}, action_time);
       perform_action(*action_remove_particles, 0);
+      merge_ensemble_results(0);
     }
   }
 
@@ -2285,70 +2589,102 @@ void Experiment<Modus>::run_time_evolution(const double t_end,
       thermalizer_->update_thermalizer_lattice(ensembles_, density_param_,
                                                ignore_cells_under_treshold);
       const double current_t = parameters_.labclock->current_time();
-      for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-        thermalizer_->thermalize(ensembles_[i_ens], current_t,
-                                 parameters_.testparticles);
-        ThermalizationAction th_act(*thermalizer_, current_t);
-        if (th_act.any_particles_thermalized()) {
-          perform_action(th_act, i_ens);
-        }
-      }
+      // The thermalizer is shared by all ensembles
+      constexpr bool concurrently = false;
+      for_each_ensemble(
+          [&](int i_ens) {
+            thermalizer_->thermalize(ensembles_[i_ens], current_t,
+                                     parameters_.testparticles);
+            ThermalizationAction th_act(*thermalizer_, current_t);
+            if (th_act.any_particles_thermalized()) {
+              perform_action(th_act, i_ens);
+            }
+          },
+          concurrently);
+    }
+
+    /* Pauli blocking looks at the phase-space density of all ensembles, so
+     * then the ensembles can only be evolved one after the other. The action
+     * finding only reads the own ensemble and can always run concurrently. */
+    const bool evolve_concurrently = !pauli_blocker_;
+    if (pauli_blocker_) {
+      pauli_blocker_->build_index(
+          ensembles_, parameters_.labclock->current_time(), dt);
     }
-
     std::vector<Actions> actions(parameters_.n_ensembles);
-    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-      actions[i_ens].clear();
-      if (ensembles_[i_ens].size() > 0 && action_finders_.size() > 0) {
-        /* (1.a) Create grid. */
-        const double min_cell_length = compute_min_cell_length(dt);
-        logg[LExperiment].debug("Creating grid with minimal cell length ",
-                                min_cell_length);
-        /* For the hyper-surface-crossing actions also unformed particles are
-         * searched and therefore needed on the grid. */
-        const bool include_unformed_particles = IC_output_switch_;
-        const auto &grid =
-            use_grid_ ? modus_.create_grid(ensembles_[i_ens], min_cell_length,
-                                           dt, parameters_.coll_crit,
-                                           include_unformed_particles)
-                      : modus_.create_grid(ensembles_[i_ens], min_cell_length,
-                                           dt, parameters_.coll_crit,
-                                           include_unformed_particles,
-                                           CellSizeStrategy::Largest);
-
-        const double gcell_vol = grid.cell_volume();
-        /* (1.b) Iterate over cells and find actions. */
-        grid.iterate_cells(
-            [&](const ParticleList &search_list) {
-              for (const auto &finder : action_finders_) {
-                actions[i_ens].insert(finder->find_actions_in_cell(
-                    search_list, dt, gcell_vol, beam_momentum_));
-              }
-            },
-            [&](const ParticleList &search_list,
-                const ParticleList &neighbors_list) {
-              for (const auto &finder : action_finders_) {
-                actions[i_ens].insert(finder->find_actions_with_neighbors(
-                    search_list, neighbors_list, dt, beam_momentum_));
-              }
-            });
-      }
-    }
+    constexpr bool find_concurrently = true;
+    for_each_ensemble(
+        [&](int i_ens) {
+          ensemble_grids_[i_ens].reset();
+          if (ensembles_[i_ens].size() == 0 || action_finders_.size() == 0) {
+            return;
+          }
+          if (decay_scheduler_) {
+            decay_scheduler_->schedule_decays(ensembles_[i_ens]);
+          }
+          /* (1.a) Create grid. */
+          const double min_cell_length = compute_min_cell_length(dt);
+          logg[LExperiment].debug("Creating grid with minimal cell length ",
+                                  min_cell_length);
+          /* For the hyper-surface-crossing actions also unformed particles
+           * are searched and therefore needed on the grid. */
+          const bool include_unformed_particles = IC_output_switch_;
+          ensemble_grids_[i_ens] = std::make_unique<ModusGrid>(
+              use_grid_ ? modus_.create_grid(ensembles_[i_ens],
+                                             min_cell_length, dt,
+                                             parameters_.coll_crit,
+                                             include_unformed_particles)
+                        : modus_.create_grid(ensembles_[i_ens],
+                                             min_cell_length, dt,
+                                             parameters_.coll_crit,
+                                             include_unformed_particles,
+                                             CellSizeStrategy::Largest));
+          const ModusGrid &grid = *ensemble_grids_[i_ens];
+
+          const double gcell_vol = grid.cell_volume();
+          /* (1.b) Iterate over cells and find actions. */
+          grid.iterate_cells(
+              [&](const ParticleList &search_list) {
+                for (const auto &finder : action_finders_) {
+                  actions[i_ens].insert(finder->find_actions_in_cell(
+                      search_list, dt, gcell_vol, beam_momentum_));
+                }
+              },
+              [&](const ParticleList &search_list,
+                  const ParticleList &neighbors_list) {
+                for (const auto &finder : action_finders_) {
+                  actions[i_ens].insert(finder->find_actions_with_neighbors(
+                      search_list, neighbors_list, dt, beam_momentum_));
+                }
+              });
+        },
+        find_concurrently);
 
     /* \todo (optimizations) Adapt timestep size here */
 
     /* (2) Propagate from action to action until next output or timestep end */
     const double end_timestep_time = parameters_.labclock->next_time();
     while (next_output_time() < end_timestep_time) {
-      for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-        run_time_evolution_timestepless(actions[i_ens], i_ens,
-                                        next_output_time());
-      }
+      const double output_time = next_output_time();
+      for_each_ensemble(
+          [&](int i_ens) {
+            run_time_evolution_timestepless(actions[i_ens], i_ens,
+                                            output_time);
+          },
+          evolve_concurrently);
       ++(*parameters_.outputclock);
 
       intermediate_output();
     }
-    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-      run_time_evolution_timestepless(actions[i_ens], i_ens, end_timestep_time);
+    for_each_ensemble(
+        [&](int i_ens) {
+          run_time_evolution_timestepless(actions[i_ens], i_ens,
+                                          end_timestep_time);
+        },
+        evolve_concurrently);
+    if (pauli_blocker_) {
+      // The momenta are changed by the potentials below
+      pauli_blocker_->clear_index();
     }
 
     /* (3) Update potentials (if computed on the lattice) and
@@ -2394,28 +2730,67 @@ void Experiment<Modus>::run_time_evolution(const double t_end,
 }
 
 template <typename Modus>
-void Experiment<Modus>::propagate_and_shine(double to_time,
-                                            Particles &particles) {
+void Experiment<Modus>::propagate_and_shine(double to_time, int i_ensemble) {
+  Particles &particles = ensembles_[i_ensemble];
   const double dt =
       propagate_straight_line(&particles, to_time, beam_momentum_);
   if (dilepton_finder_ != nullptr) {
-    for (const auto &output : outputs_) {
+    for (const auto &output : outputs_of(i_ensemble)) {
       dilepton_finder_->shine(particles, output.get(), dt);
     }
   }
 }
 
-/**
- * Make sure `interactions_total` can be represented as a 32-bit integer.
- * This is necessary for converting to a `id_process`. The latter is 32-bit
- * integer, because it is written like this to binary output.
- *
- * \param[in] interactions_total Total interaction number
- */
-inline void check_interactions_total(uint64_t interactions_total) {
-  constexpr uint64_t max_uint32 = std::numeric_limits<uint32_t>::max();
-  if (interactions_total >= max_uint32) {
-    throw std::runtime_error("Integer overflow in total interaction number!");
+template <typename Modus>
+void Experiment<Modus>::for_each_ensemble(const std::function<void(int)> &task,
+                                          bool concurrently) {
+  const int n_ensembles = parameters_.n_ensembles;
+  if (!ensemble_threads_) {
+    for (int i_ens = 0; i_ens < n_ensembles; i_ens++) {
+      task(i_ens);
+      merge_ensemble_results(i_ens);
+    }
+    return;
+  }
+  // Use the random number stream of the ensemble on the executing thread
+  const auto task_with_ensemble_stream = [&](int i_ens) {
+    random::StreamScope stream_scope(ensemble_streams_[i_ens]);
+    set_potential_globals();
+    task(i_ens);
+  };
+  if (concurrently) {
+    ensemble_threads_->parallel_for(n_ensembles, task_with_ensemble_stream);
+  } else {
+    for (int i_ens = 0; i_ens < n_ensembles; i_ens++) {
+      task_with_ensemble_stream(i_ens);
+    }
+  }
+  for (int i_ens = 0; i_ens < n_ensembles; i_ens++) {
+    merge_ensemble_results(i_ens);
+  }
+}
+
+template <typename Modus>
+void Experiment<Modus>::merge_ensemble_results(int i_ensemble) {
+  EnsembleCounters &counters = ensemble_counters_[i_ensemble];
+  interactions_total_ += counters.interactions;
+  wall_actions_total_ += counters.wall_actions;
+  total_pauli_blocked_ += counters.pauli_blocked;
+  total_hypersurface_crossing_actions_ +=
+      counters.hypersurface_crossing_actions;
+  discarded_interactions_total_ += counters.discarded_interactions;
+  total_energy_removed_ += counters.energy_removed;
+  total_energy_violated_by_Pythia_ += counters.energy_violated_by_Pythia;
+  if (counters.projectile_target_interact) {
+    projectile_target_interact_[i_ensemble] = true;
+  }
+  const uint64_t interactions_in_event = counters.interactions_in_event;
+  counters = EnsembleCounters{};
+  counters.interactions_in_event = interactions_in_event;
+  if (ensemble_threads_) {
+    for (const auto &output : deferred_outputs_[i_ensemble]) {
+      static_cast<DeferredOutput &>(*output).flush();
+    }
   }
 }
 
@@ -2426,6 +2801,14 @@ void Experiment<Modus>::run_time_evolution_timestepless(
   logg[LExperiment].debug(
       "Timestepless propagation: ", "Actions size = ", actions.size(),
       ", end time = ", end_time_propagation);
+  /* Particles are only propagated when they are involved in an action or in
+   * the search for new actions, unless all particles are needed at the time
+   * of each action, for shining dileptons, the density at the interaction
+   * point or the phase-space density of the Pauli blocking. The remaining
+   * particles are propagated at the end. */
+  const bool propagate_lazily = dilepton_finder_ == nullptr &&
+                                dens_type_ == DensityType::None &&
+                                !pauli_blocker_;
 
   // iterate over all actions
   while (!actions.is_empty()) {
@@ -2435,7 +2818,7 @@ void Experiment<Modus>::run_time_evolution_timestepless(
     // get next action
     ActionPtr act = actions.pop();
     if (!act->is_valid(particles)) {
-      discarded_interactions_total_++;
+      ensemble_counters_[i_ensemble].discarded_interactions++;
       logg[LExperiment].debug(~einhard::DRed(), "✘ ", act,
                               " (discarded: invalid)");
       continue;
@@ -2444,7 +2827,13 @@ void Experiment<Modus>::run_time_evolution_timestepless(
                             ", action time = ", act->time_of_execution());
 
     /* (1) Propagate to the next action. */
-    propagate_and_shine(act->time_of_execution(), particles);
+    if (propagate_lazily) {
+      ParticleList incoming = act->incoming_particles();
+      propagate_straight_line(&particles, incoming, act->time_of_execution(),
+                              beam_momentum_);
+    } else {
+      propagate_and_shine(act->time_of_execution(), i_ensemble);
+    }
 
     /* (2) Perform action.
      *
@@ -2459,6 +2848,13 @@ void Experiment<Modus>::run_time_evolution_timestepless(
     if (!performed) {
       continue;
     }
+    /* The other actions of the incoming particles have become invalid and
+     * are discarded right away. A wall crossing keeps the id and process id
+     * of the particle, so its other actions stay valid and are performed. */
+    if (act->get_type() != ProcessType::Wall) {
+      ensemble_counters_[i_ensemble].discarded_interactions +=
+          actions.invalidate(act->incoming_particles());
+    }
 
     /* (3) Update actions for newly-produced particles. */
 
@@ -2468,19 +2864,41 @@ void Experiment<Modus>::run_time_evolution_timestepless(
     const ParticleList &outgoing_particles = act->outgoing_particles();
     // Grid cell volume set to zero, since there is no grid
     const double gcell_vol = 0.0;
+    /* Only the particles in the grid cells around the outgoing particles can
+     * collide with them until the end of the time step. */
+    ModusGrid *grid = ensemble_grids_[i_ensemble].get();
+    ParticleList surrounding_particles =
+        grid ? grid->surrounding_particles(outgoing_particles, particles)
+             : ParticleList{};
+    if (propagate_lazily) {
+      if (grid) {
+        propagate_straight_line(&particles, surrounding_particles,
+                                act->time_of_execution(), beam_momentum_);
+      } else {
+        propagate_straight_line(&particles, act->time_of_execution(),
+                                beam_momentum_);
+      }
+    }
     for (const auto &finder : action_finders_) {
       // Outgoing particles can still decay, cross walls...
       actions.insert(finder->find_actions_in_cell(outgoing_particles, time_left,
                                                   gcell_vol, beam_momentum_));
       // ... and collide with other particles.
-      actions.insert(finder->find_actions_with_surrounding_particles(
-          outgoing_particles, particles, time_left, beam_momentum_));
+      if (grid) {
+        actions.insert(finder->find_actions_with_neighbors(
+            outgoing_particles, surrounding_particles, time_left,
+            beam_momentum_));
+      } else {
+        actions.insert(finder->find_actions_with_surrounding_particles(
+            outgoing_particles, particles, time_left, beam_momentum_));
+      }
+    }
+    if (grid) {
+      grid->add_particles(outgoing_particles);
     }
-
-    check_interactions_total(interactions_total_);
   }
 
-  propagate_and_shine(end_time_propagation, particles);
+  propagate_and_shine(end_time_propagation, i_ensemble);
 }
 
 template <typename Modus>
@@ -2632,20 +3050,30 @@ void Experiment<Modus>::intermediate_output() {
 template <typename Modus>
 void Experiment<Modus>::update_potentials() {
   if (potentials_) {
+    /* Update all densities needed for the potentials in a single sweep over
+     * the particles, which evaluates the smearing kernel only once. */
+    std::vector<DensityLatticeTarget> density_targets;
     if (potentials_->use_symmetry() && jmu_I3_lat_ != nullptr) {
-      update_lattice(jmu_I3_lat_.get(), old_jmu_auxiliary_.get(),
-                     new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
-                     LatticeUpdate::EveryTimestep, DensityType::BaryonicIsospin,
-                     density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+      density_targets.push_back(
+          {jmu_I3_lat_.get(), DensityType::BaryonicIsospin, true});
+    }
+    if ((potentials_->use_skyrme() || potentials_->use_symmetry() ||
+         potentials_->use_vdf()) &&
+        jmu_B_lat_ != nullptr) {
+      density_targets.push_back({jmu_B_lat_.get(), DensityType::Baryon, true});
     }
+    if (potentials_->use_coulomb()) {
+      density_targets.push_back(
+          {jmu_el_lat_.get(), DensityType::Charge, false});
+    }
+    update_lattices(density_targets, old_jmu_auxiliary_.get(),
+                    new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
+                    LatticeUpdate::EveryTimestep, density_param_, ensembles_,
+                    parameters_.labclock->timestep_duration(), true,
+                    ensemble_threads_.get());
+
     if ((potentials_->use_skyrme() || potentials_->use_symmetry()) &&
         jmu_B_lat_ != nullptr) {
-      update_lattice(jmu_B_lat_.get(), old_jmu_auxiliary_.get(),
-                     new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
-                     LatticeUpdate::EveryTimestep, DensityType::Baryon,
-                     density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
       const size_t UBlattice_size = UB_lat_->size();
       for (size_t i = 0; i < UBlattice_size; i++) {
         auto jB = (*jmu_B_lat_)[i];
@@ -2679,27 +3107,34 @@ void Experiment<Modus>::update_potentials() {
       }
     }
     if (potentials_->use_coulomb()) {
-      update_lattice(jmu_el_lat_.get(), LatticeUpdate::EveryTimestep,
-                     DensityType::Charge, density_param_, ensembles_, true);
-      for (size_t i = 0; i < EM_lat_->size(); i++) {
-        ThreeVector electric_field = {0., 0., 0.};
-        ThreeVector position = jmu_el_lat_->cell_center(i);
-        jmu_el_lat_->integrate_volume(electric_field,
-                                      Potentials::E_field_integrand,
-                                      potentials_->coulomb_r_cut(), position);
-        ThreeVector magnetic_field = {0., 0., 0.};
-        jmu_el_lat_->integrate_volume(magnetic_field,
-                                      Potentials::B_field_integrand,
-                                      potentials_->coulomb_r_cut(), position);
-        (*EM_lat_)[i] = std::make_pair(electric_field, magnetic_field);
+      if (fft_coulomb_solver_) {
+        fft_coulomb_solver_->compute_fields(*jmu_el_lat_, *EM_lat_);
+      } else {
+        for (size_t i = 0; i < EM_lat_->size(); i++) {
+          ThreeVector electric_field = {0., 0., 0.};
+          ThreeVector position = jmu_el_lat_->cell_center(i);
+          jmu_el_lat_->integrate_volume(electric_field,
+                                        Potentials::E_field_integrand,
+                                        potentials_->coulomb_r_cut(), position);
+          ThreeVector magnetic_field = {0., 0., 0.};
+          jmu_el_lat_->integrate_volume(magnetic_field,
+                                        Potentials::B_field_integrand,
+                                        potentials_->coulomb_r_cut(), position);
+          (*EM_lat_)[i] = std::make_pair(electric_field, magnetic_field);
+        }
       }
     }  // if ((potentials_->use_skyrme() || ...
     if (potentials_->use_vdf() && jmu_B_lat_ != nullptr) {
-      update_lattice(jmu_B_lat_.get(), old_jmu_auxiliary_.get(),
-                     new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
-                     LatticeUpdate::EveryTimestep, DensityType::Baryon,
-                     density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+      if (potentials_->use_skyrme() || potentials_->use_symmetry()) {
+        /* The VDF potentials get the baryon density of a second update in
+         * this time step, with vanishing finite difference time derivatives,
+         * without smearing the particles again. */
+        repeat_lattice_update(jmu_B_lat_.get(), old_jmu_auxiliary_.get(),
+                              new_jmu_auxiliary_.get(),
+                              four_gradient_auxiliary_.get(),
+                              LatticeUpdate::EveryTimestep, density_param_,
+                              parameters_.labclock->timestep_duration());
+      }
       if (parameters_.field_derivatives_mode == FieldDerivativesMode::Direct) {
         update_fields_lattice(
             fields_lat_.get(), old_fields_auxiliary_.get(),
@@ -2738,28 +3173,32 @@ void Experiment<Modus>::do_final_decays() {
   do {
     decays_found = false;
     interactions_old = interactions_total_;
-    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-      Actions actions;
-
-      // Dileptons: shining of remaining resonances
-      if (dilepton_finder_ != nullptr) {
-        for (const auto &output : outputs_) {
-          dilepton_finder_->shine_final(ensembles_[i_ens], output.get(), true);
-        }
-      }
-      // Find actions.
-      for (const auto &finder : action_finders_) {
-        auto found_actions = finder->find_final_actions(ensembles_[i_ens]);
-        if (!found_actions.empty()) {
-          actions.insert(std::move(found_actions));
-          decays_found = true;
-        }
-      }
-      // Perform actions.
-      while (!actions.is_empty()) {
-        perform_action(*actions.pop(), i_ens, false);
-      }
-    }
+    constexpr bool concurrently = false;
+    for_each_ensemble(
+        [&](int i_ens) {
+          Actions actions;
+
+          // Dileptons: shining of remaining resonances
+          if (dilepton_finder_ != nullptr) {
+            for (const auto &output : outputs_of(i_ens)) {
+              dilepton_finder_->shine_final(ensembles_[i_ens], output.get(),
+                                            true);
+            }
+          }
+          // Find actions.
+          for (const auto &finder : action_finders_) {
+            auto found_actions = finder->find_final_actions(ensembles_[i_ens]);
+            if (!found_actions.empty()) {
+              actions.insert(std::move(found_actions));
+              decays_found = true;
+            }
+          }
+          // Perform actions.
+          while (!actions.is_empty()) {
+            perform_action(*actions.pop(), i_ens, false);
+          }
+        },
+        concurrently);
     actions_performed = interactions_total_ > interactions_old;
     // Throw an error if actions were found but not performed
     if (decays_found && !actions_performed) {
@@ -2971,22 +3410,93 @@ void Experiment<Modus>::increase_event_number() {
 }
 
 template <typename Modus>
-void Experiment<Modus>::run() {
-  const auto &mainlog = logg[LMain];
-  for (event_ = 0; !is_finished(); event_++) {
-    mainlog.info() << "Event " << event_;
+void Experiment<Modus>::run_event() {
+  logg[LMain].info() << "Event " << event_;
+
+  // Sample initial particles, start clock, some printout and book-keeping
+  initialize_new_event();
 
-    // Sample initial particles, start clock, some printout and book-keeping
-    initialize_new_event();
+  run_time_evolution(end_time_);
 
-    run_time_evolution(end_time_);
+  if (force_decays_) {
+    do_final_decays();
+  }
 
-    if (force_decays_) {
-      do_final_decays();
+  // Output at event end
+  final_output();
+}
+
+template <typename Modus>
+void Experiment<Modus>::run() {
+  if (!event_workers_.empty()) {
+    run_events_concurrently();
+    return;
+  }
+  for (event_ = 0; !is_finished(); event_++) {
+    run_event();
+  }
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_events_concurrently() {
+  /* The seed of an event only depends on the seed of the previous one, so the
+   * seeds of all events are known beforehand. */
+  std::vector<int64_t> seeds(nevents_);
+  for (int64_t &seed : seeds) {
+    seed = seed_;
+    random::Stream event_stream(seed_);
+    seed_ = draw_next_event_seed(event_stream);
+  }
+
+  const int n_workers = event_workers_.size();
+  /* Workers finishing their events quickly wait for a slow one, such that the
+   * recorded output of at most a few events per worker is kept in memory. */
+  OutputSequencer sequencer(0, 2 * n_workers);
+  std::vector<std::exception_ptr> errors(n_workers);
+  std::vector<std::thread> threads;
+  threads.reserve(n_workers);
+  for (int i_worker = 0; i_worker < n_workers; i_worker++) {
+    threads.emplace_back([&, i_worker]() {
+      try {
+        Experiment &worker = *event_workers_[i_worker];
+        worker.set_potential_globals();
+        for (int event = i_worker; event < nevents_; event += n_workers) {
+          worker.event_ = event;
+          worker.seed_ = seeds[event];
+          worker.run_event();
+          DeferredOutput::Calls calls;
+          for (const auto &output : worker.outputs_) {
+            DeferredOutput::Calls output_calls =
+                static_cast<DeferredOutput &>(*output).take_calls();
+            std::move(output_calls.begin(), output_calls.end(),
+                      std::back_inserter(calls));
+          }
+          sequencer.submit(event, std::move(calls));
+        }
+      } catch (...) {
+        errors[i_worker] = std::current_exception();
+        // The other workers must not wait for the events of this one.
+        sequencer.cancel();
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  event_ = nevents_;
+  for (const std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
     }
+  }
+}
 
-    // Output at event end
-    final_output();
+template <typename Modus>
+void Experiment<Modus>::set_potential_globals() const {
+  if (parameters_.potential_affect_threshold) {
+    UB_lat_pointer = UB_lat_.get();
+    UI3_lat_pointer = UI3_lat_.get();
+    pot_pointer = potentials_.get();
   }
 }
 
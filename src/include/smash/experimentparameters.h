@@ -32,6 +32,9 @@ struct ExperimentParameters {
   /// Number of parallel ensembles
   int n_ensembles;
 
+  /// Number of threads used to evolve the ensembles concurrently
+  int n_ensemble_threads;
+
   /// Number of test-particles
   int testparticles;
 
@@ -45,6 +48,9 @@ struct ExperimentParameters {
   /// mode of smearing for density calculation
   const SmearingMode smearing_mode;
 
+  /// Whether the Gaussian smearing on the lattice uses tabulated factors
+  bool gaussian_smearing_tables;
+
   /// Width of gaussian Wigner density of particles
   double gaussian_sigma;
 
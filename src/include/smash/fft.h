@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_FFT_H_
+#define SRC_INCLUDE_SMASH_FFT_H_
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup data
+ * Discrete Fourier transform of complex data on a three-dimensional grid.
+ *
+ * The transform is computed by one-dimensional transforms along each axis,
+ * which use a mixed-radix Cooley-Tukey algorithm. Any grid size is possible,
+ * but sizes with only small prime factors (see next_fast_size) are much
+ * faster, since each prime factor p costs \f$ \mathcal{O}(p) \f$ operations
+ * per point.
+ *
+ * The data is stored with the x index running fastest, like in
+ * RectangularLattice. The forward transform is
+ * \f[
+ * \tilde{f}(\mathbf{k}) = \sum_{\mathbf{n}} f(\mathbf{n})
+ *     \exp\left(-2\pi i \sum_a \frac{k_a n_a}{N_a}\right)
+ * \f]
+ * and the backward transform has the opposite sign in the exponent and is
+ * normalized by the number of points, such that it inverts the forward
+ * transform.
+ *
+ * A transform object holds scratch space, so it must not be used from
+ * several threads at once.
+ */
+class FourierTransform3D {
+ public:
+  /**
+   * Prepare the transforms for a grid.
+   *
+   * \param[in] sizes number of points in x, y and z direction
+   * \throw std::invalid_argument if a size is not positive
+   */
+  explicit FourierTransform3D(const std::array<int, 3> &sizes);
+
+  /// \return Number of points in x, y and z direction.
+  const std::array<int, 3> &sizes() const { return sizes_; }
+
+  /// \return Total number of points.
+  std::size_t size() const {
+    return static_cast<std::size_t>(sizes_[0]) * sizes_[1] * sizes_[2];
+  }
+
+  /**
+   * Transform data in place from position to wave number space.
+   *
+   * \param[in,out] data values on the grid, of length size()
+   */
+  void forward(std::vector<std::complex<double>> &data);
+
+  /**
+   * Transform data in place from wave number to position space, inverse of
+   * forward.
+   *
+   * \param[in,out] data values on the grid, of length size()
+   */
+  void backward(std::vector<std::complex<double>> &data);
+
+  /**
+   * Smallest number not below n without prime factors other than 2, 3 and 5.
+   *
+   * \param[in] n minimal size
+   * \return Size which can be transformed fast.
+   */
+  static int next_fast_size(int n);
+
+ private:
+  /// One-dimensional transform of a fixed length.
+  class Transform1D {
+   public:
+    /**
+     * Prepare the transform.
+     *
+     * \param[in] n length of the transform
+     */
+    explicit Transform1D(int n);
+
+    /**
+     * Forward transform of a contiguous line in place.
+     *
+     * \param[in,out] line first of the n values
+     */
+    void forward(std::complex<double> *line);
+
+   private:
+    /**
+     * Recursive step of the transform.
+     *
+     * \param[in] in first input value
+     * \param[in] stride distance of the input values
+     * \param[out] out first of n output values
+     * \param[in] n length of this sub-transform
+     * \param[in] i_factor index of the first prime factor of n in factors_
+     */
+    void transform(const std::complex<double> *in, std::size_t stride,
+                   std::complex<double> *out, int n, std::size_t i_factor);
+
+    /// Length of the transform
+    int n_;
+    /// Prime factors of n_ in ascending order
+    std::vector<int> factors_;
+    /// \f$ \exp(-2\pi i j / n) \f$ for \f$ j = 0, \ldots, n - 1 \f$
+    std::vector<std::complex<double>> twiddles_;
+    /// Copy of the input line
+    std::vector<std::complex<double>> input_;
+    /// Values combined in one butterfly
+    std::vector<std::complex<double>> butterfly_;
+  };
+
+  /// Number of points in x, y and z direction
+  std::array<int, 3> sizes_;
+  /// Transforms along the x, y and z axis
+  std::vector<Transform1D> transforms_;
+  /// Line gathered from the grid for a transform along y or z
+  std::vector<std::complex<double>> line_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_FFT_H_
@@ -0,0 +1,99 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_FFTCOULOMBSOLVER_H_
+#define SRC_INCLUDE_SMASH_FFTCOULOMBSOLVER_H_
+
+#include <array>
+#include <complex>
+#include <utility>
+#include <vector>
+
+#include "density.h"
+#include "fft.h"
+#include "lattice.h"
+#include "threevector.h"
+
+namespace smash {
+
+/**
+ * \ingroup data
+ * Calculates the electric and magnetic fields of the charge density and
+ * current on a lattice by a convolution with the Green's function, which is
+ * evaluated with fast Fourier transforms.
+ *
+ * It gives the same fields as integrating Potentials::E_field_integrand and
+ * Potentials::B_field_integrand with RectangularLattice::integrate_volume
+ * for each cell, up to rounding, but in
+ * \f$ \mathcal{O}(N\log N) \f$ instead of
+ * \f$ \mathcal{O}(N (R_\mathrm{cut}/\Delta x)^3) \f$ operations for a lattice
+ * of N cells. Therefore the same cells contribute to the field of a cell:
+ * those inside the box of half edge length \f$ R_\mathrm{cut} \f$ around it,
+ * wrapped around the lattice if it is periodic and cut at its edges
+ * otherwise. In the latter case the lattice is padded with zeros, such that
+ * the periodic convolution of the Fourier transform gives the open boundary
+ * conditions.
+ */
+class FFTCoulombSolver {
+ public:
+  /// Lattice of the electric and magnetic fields
+  using FieldsLattice = RectangularLattice<std::pair<ThreeVector, ThreeVector>>;
+
+  /**
+   * Prepare the Green's function for a lattice geometry.
+   *
+   * \param[in] jmu_el_lat lattice of the charge density whose fields are
+   *                       calculated
+   * \param[in] r_cut half edge length of the integration volume [fm]
+   */
+  FFTCoulombSolver(const DensityLattice &jmu_el_lat, double r_cut);
+
+  /**
+   * Calculate the fields of a charge density and current.
+   *
+   * \param[in] jmu_el_lat lattice of the electric charge density, with the
+   *                       geometry given to the constructor
+   * \param[out] em_lat lattice of the electric and magnetic field
+   *                    [fm\f$^{-2}\f$], with the same geometry
+   */
+  void compute_fields(DensityLattice &jmu_el_lat, FieldsLattice &em_lat);
+
+ private:
+  /**
+   * Index on the padded grid.
+   *
+   * \param[in] ix index in x direction, in [0, padded_sizes_[0])
+   * \param[in] iy index in y direction, in [0, padded_sizes_[1])
+   * \param[in] iz index in z direction, in [0, padded_sizes_[2])
+   * \return 1D index into the arrays of the padded grid.
+   */
+  std::size_t padded_index(int ix, int iy, int iz) const {
+    return ix + static_cast<std::size_t>(padded_sizes_[0]) *
+                    (iy + static_cast<std::size_t>(padded_sizes_[1]) * iz);
+  }
+
+  /// Number of lattice cells in x, y and z direction
+  std::array<int, 3> n_cells_;
+  /// Size of the padded grid, equal to n_cells_ for a periodic lattice
+  std::array<int, 3> padded_sizes_;
+  /// Fourier transform on the padded grid
+  FourierTransform3D fft_;
+  /// Fourier transforms of the x, y and z component of the Green's function
+  std::array<std::vector<std::complex<double>>, 3> green_function_;
+  /// \f$ \rho + i j_x \f$, packed to save a transform since both are real
+  std::vector<std::complex<double>> charge_;
+  /// \f$ j_y + i j_z \f$
+  std::vector<std::complex<double>> current_;
+  /// \f$ E_x + i E_y \f$, \f$ E_z + i B_x \f$ and \f$ B_y + i B_z \f$
+  std::array<std::vector<std::complex<double>>, 3> fields_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_FFTCOULOMBSOLVER_H_
@@ -13,6 +13,7 @@
 /// @cond
 // exclude most content here from documentation
 
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <vector>
@@ -131,6 +132,12 @@ enum class FieldDerivativesMode {
   Direct,
 };
 
+/// Methods of calculating the electromagnetic fields of the Coulomb potential
+enum class CoulombSolver {
+  Direct,
+  FFT,
+};
+
 /// Modes of smearing
 enum class SmearingMode {
   CovariantGaussian,
@@ -233,6 +240,21 @@ enum class CollisionCriterion {
   Covariant
 };
 
+/**
+ * Codecs of the chunks of compressed binary output. The values are stored in
+ * the files and must not change.
+ */
+enum class BinaryCompression : std::uint8_t {
+  /// Chunks are stored as they are.
+  None = 0,
+  /// Built-in LZ77-style codec, which is always available.
+  Builtin = 1,
+  /// Zstandard, if SMASH was built with it.
+  Zstd = 2,
+  /// LZ4, if SMASH was built with it.
+  LZ4 = 3,
+};
+
 /// Whether and when only final state particles should be printed.
 enum class OutputOnlyFinal {
   /// Print only final-state particles.
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2015,2017-2022
+ *    Copyright (c) 2014-2015,2017-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -171,6 +171,42 @@ class Grid : public GridBase {
    */
   double cell_volume() const { return cell_volume_; }
 
+  /**
+   * Sorts particles which were created after the construction of the grid
+   * into the cells. A particle is placed in the cell where its straight line
+   * trajectory was at the time of the construction, such that it can be
+   * found in the same neighborhood as the particles sorted in on construction.
+   * Positions outside of the grid are assigned to the closest cell.
+   *
+   * A particle that is already in the grid under the same index in Particles
+   * is taken out of its old cell. This way a particle crossing a wall, which
+   * keeps its id and process id, is only found once.
+   *
+   * \param[in] new_particles The particles to be added to the grid.
+   */
+  void add_particles(const ParticleList &new_particles);
+
+  /**
+   * Looks up the particles which can interact with any of the given particles
+   * until the end of the time step, for which the grid was constructed.
+   * These are the particles in the cell of each particle in \p search_list
+   * and in the (up to 26) directly adjacent cells. The periodic boundaries are
+   * not wrapped around, since the collision search with surrounding particles
+   * does not shift positions either.
+   *
+   * Particles which were removed from \p particles since they were sorted in
+   * are skipped. Removing particles from the grid is hence never needed.
+   *
+   * \param[in] search_list The particles whose surroundings are searched.
+   *                        They themselves are never part of the result.
+   * \param[in] particles The current state of all particles; the returned
+   *                      particles are taken from here.
+   * \return The current state of all valid particles in the cells around the
+   *         particles in \p search_list.
+   */
+  ParticleList surrounding_particles(const ParticleList &search_list,
+                                     const Particles &particles) const;
+
  private:
   /**
    * \return the one-dimensional cell-index from the 3-dim index \p x, \p y, \p
@@ -186,9 +222,33 @@ class Grid : public GridBase {
     return make_index(idx[0], idx[1], idx[2]);
   }
 
+  /**
+   * \return the 3-dim index of the cell where \p p was at the time of the
+   * grid construction. Indices outside of the grid are clamped to the closest
+   * cell.
+   */
+  std::array<SizeType, 3> cell_coordinates_of(const ParticleData &p) const;
+
+  /**
+   * Sort a particle into a cell and remember the cell for its index.
+   *
+   * \param[in] p The particle to be sorted in.
+   * \param[in] cell_index The one-dimensional index of its cell.
+   */
+  void sort_in(const ParticleData &p, SizeType cell_index);
+
   /// The 3 lengths of the complete grid. Used for periodic boundary wrapping.
   const std::array<double, 3> length_;
 
+  /// The minimal position of the grid in x, y, and z direction.
+  std::array<double, 3> min_position_ = {{0., 0., 0.}};
+
+  /// The factors converting positions into cell indices in x, y, and z.
+  std::array<double, 3> index_factor_ = {{0., 0., 0.}};
+
+  /// The time of the particle positions the grid was constructed with.
+  double time_ = 0.;
+
   /// The volume of a single cell.
   double cell_volume_;
 
@@ -197,6 +257,12 @@ class Grid : public GridBase {
 
   /// The cell storage.
   std::vector<ParticleList> cells_;
+
+  /**
+   * The cell of the particle last sorted in with a given index in Particles,
+   * -1 if there is none.
+   */
+  std::vector<SizeType> cell_of_index_;
 };
 
 }  // namespace smash
@@ -1160,6 +1160,37 @@ struct InputKeys {
   inline static const Key<int> gen_ensembles{
       {"General", "Ensembles"}, 1, {"1.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_ensemble_threads_,Ensemble_Threads,int,1}
+   *
+   * Number of threads used to evolve the parallel ensembles concurrently.
+   *
+   * If larger than 1, the grid construction, the action finding and the
+   * propagation from action to action of different ensembles run at the same
+   * time. Ensemble \f$i\f$ is always assigned to thread \f$i\f$ modulo the
+   * number of threads and has its own stream of random numbers, which is
+   * derived from the event seed. Results are therefore reproducible for a
+   * fixed <tt>\ref key_gen_randomseed_ "Randomseed"</tt> and number of
+   * threads, but they differ from the ones of a run with a different number
+   * of threads. The threads also share the smearing of the densities for the
+   * mean-field potentials onto the lattice, which gives the same densities
+   * for any number of threads. The rest of the potentials, the thermalization
+   * and the output are handled by one thread in between. If Pauli blocking
+   * is enabled, only the grid construction and the action finding are done
+   * concurrently, because the phase-space density is computed from all
+   * ensembles.
+   *
+   * Apart from the density smearing, threading only helps if
+   * <tt>\ref key_gen_ensembles_ "Ensembles"</tt> is larger than 1. It costs
+   * one copy of the PYTHIA objects per thread.
+   */
+  /**
+   * \see_key{key_gen_ensemble_threads_}
+   */
+  inline static const Key<int> gen_ensembleThreads{
+      {"General", "Ensemble_Threads"}, 1, {"3.1"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_expansion_rate_,Expansion_Rate,double,0.1}
@@ -1235,6 +1266,23 @@ struct InputKeys {
   inline static const Key<double> gen_smearingGaussianSigma{
       {"General", "Gaussian_Sigma"}, 1.0, {"1.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_gaussian_smearing_tables_,Gaussian_Smearing_Tables,
+   * bool,false}
+   *
+   * Parameter for Covariant Gaussian smearing: Whether the smearing factors of
+   * a particle on the lattice are calculated row by row with recurrences,
+   * which need only a few exponentials per row of cells instead of one per
+   * cell. The densities agree with the direct calculation up to rounding
+   * errors, but not bit for bit.
+   */
+  /**
+   * \see_key{key_gen_gaussian_smearing_tables_}
+   */
+  inline static const Key<bool> gen_smearingGaussianTables{
+      {"General", "Gaussian_Smearing_Tables"}, false, {"3.1"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_metric_type_,Metric_Type,string,"NoExpansion"}
@@ -1898,6 +1946,23 @@ struct InputKeys {
   inline static const Key<double> collTerm_crossSectionScaling{
       {"Collision_Term", "Cross_Section_Scaling"}, 1.0, {"1.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_decay_width_tables_,Decay_Width_Tables,bool,false}
+   *
+   * Whether the decay widths of the resonances, which determine in every time
+   * step whether they decay, are interpolated in tables on a mass grid instead
+   * of being calculated from all decay modes. This is faster for resonances
+   * with many decay modes, but the widths agree with the exact ones only up to
+   * the interpolation error. The branching ratios of the decays are always
+   * calculated exactly.
+   */
+  /**
+   * \see_key{key_CT_decay_width_tables_}
+   */
+  inline static const Key<bool> collTerm_decayWidthTables{
+      {"Collision_Term", "Decay_Width_Tables"}, false, {"3.1"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_collision_term
    * \optional_key{key_CT_elastic_cross_section_,Elastic_Cross_Section,double,-1.0}
@@ -2149,6 +2214,24 @@ struct InputKeys {
   inline static const Key<bool> collTerm_onlyWarnForHighProbability{
       {"Collision_Term", "Only_Warn_For_High_Probability"}, false, {"1.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_persistent_decay_times_,Persistent_Decay_Times,bool,
+   * false}
+   *
+   * Whether the decay time of a resonance is sampled only once, instead of in
+   * every time step. It is sampled again only when the momentum of the
+   * resonance changes, e.g. by the potentials, or when it did not decay at the
+   * sampled time, e.g. due to Pauli blocking. Since the lifetimes are
+   * exponentially distributed, both give the same decay law, but different
+   * events for the same random seed.
+   */
+  /**
+   * \see_key{key_CT_persistent_decay_times_}
+   */
+  inline static const Key<bool> collTerm_persistentDecayTimes{
+      {"Collision_Term", "Persistent_Decay_Times"}, false, {"3.1"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_collision_term
    * \optional_key{key_CT_res_lifetime_mod_,Resonance_Lifetime_Modifier,double,1.0}
@@ -4008,6 +4091,44 @@ struct InputKeys {
   inline static const Key<std::vector<double>> output_outputTimes{
       {"Output", "Output_Times"}, {"1.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key{key_output_binary_buffer_size_,Binary_Buffer_Size,int,16}
+   *
+   * Memory \unit{in MiB} that each \ref doxypage_output_binary "binary output"
+   * may use for records which are waiting to be written. The records are
+   * written to disk on a separate thread, so that the simulation does not wait
+   * for the file system as long as the buffer is not full. With `0`, the
+   * records are written by the simulation itself. The content of the files
+   * does not depend on this value.
+   */
+  /**
+   * \see_key{key_output_binary_buffer_size_}
+   */
+  inline static const Key<int> output_binaryBufferSize{
+      {"Output", "Binary_Buffer_Size"}, 16, {"3.1"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key{key_output_binary_compression_,Binary_Compression,string,
+   * "None"}
+   *
+   * Codec with which the \ref doxypage_output_binary "binary outputs" compress
+   * their records. Compressed files are a variant of the binary format, see
+   * \ref doxypage_output_binary_compressed.
+   * - `"None"` &rarr; The records are written uncompressed.
+   * - `"Builtin"` &rarr; A simple LZ77-style codec, which is always available.
+   * - `"Zstd"` &rarr; Zstandard, available if the library was found when SMASH
+   *   was configured. It gives the smallest files.
+   * - `"LZ4"` &rarr; LZ4, available if the library was found when SMASH was
+   *   configured. It is the fastest codec.
+   */
+  /**
+   * \see_key{key_output_binary_compression_}
+   */
+  inline static const Key<BinaryCompression> output_binaryCompression{
+      {"Output", "Binary_Compression"}, BinaryCompression::None, {"3.1"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_output
    * <hr>
@@ -4815,6 +4936,24 @@ struct InputKeys {
   inline static const Key<std::vector<double>> potentials_coulomb_rCut{
       {"Potentials", "Coulomb", "R_Cut"}, {"1.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_pot_coulomb
+   * \optional_key{key_potentials_coulomb_solver_,Solver,string,"Direct"}
+   *
+   * Method used to calculate the fields on the lattice.
+   * - `"Direct"` &rarr; For each cell, the contributions of all cells within
+   *   the integration volume are summed up.
+   * - `"FFT"` &rarr; The charge density and current are convolved with the
+   *   Green's function by fast Fourier transforms. The fields are the same as
+   *   with `"Direct"` up to rounding errors, but they are obtained much faster
+   *   for large lattices or a large \f$ R_\mathrm{cut} \f$.
+   */
+  /**
+   * \see_key{key_potentials_coulomb_solver_}
+   */
+  inline static const Key<CoulombSolver> potentials_coulomb_solver{
+      {"Potentials", "Coulomb", "Solver"}, CoulombSolver::Direct, {"3.1"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_forced_therm
    * <hr>
@@ -4956,9 +5095,11 @@ struct InputKeys {
       std::reference_wrapper<const Key<std::map<PdgCode, int>>>,
       std::reference_wrapper<const Key<std::map<std::string, std::string>>>,
       std::reference_wrapper<const Key<einhard::LogLevel>>,
+      std::reference_wrapper<const Key<BinaryCompression>>,
       std::reference_wrapper<const Key<BoxInitialCondition>>,
       std::reference_wrapper<const Key<CalculationFrame>>,
       std::reference_wrapper<const Key<CollisionCriterion>>,
+      std::reference_wrapper<const Key<CoulombSolver>>,
       std::reference_wrapper<const Key<DensityType>>,
       std::reference_wrapper<const Key<DerivativesMode>>,
       std::reference_wrapper<const Key<ExpansionMode>>,
@@ -4990,10 +5131,12 @@ struct InputKeys {
       std::cref(gen_derivativesMode),
       std::cref(gen_smearingDiscreteWeight),
       std::cref(gen_ensembles),
+      std::cref(gen_ensembleThreads),
       std::cref(gen_expansionRate),
       std::cref(gen_fieldDerivativesMode),
       std::cref(gen_smearingGaussCutoffInSigma),
       std::cref(gen_smearingGaussianSigma),
+      std::cref(gen_smearingGaussianTables),
       std::cref(gen_metricType),
       std::cref(gen_restFrameDensityDerivativeMode),
       std::cref(gen_smearingMode),
@@ -5037,6 +5180,7 @@ struct InputKeys {
       std::cref(collTerm_additionalElasticCrossSection),
       std::cref(collTerm_collisionCriterion),
       std::cref(collTerm_crossSectionScaling),
+      std::cref(collTerm_decayWidthTables),
       std::cref(collTerm_elasticCrossSection),
       std::cref(collTerm_elasticNNCutoffSqrts),
       std::cref(collTerm_fixedMinCellLength),
@@ -5049,6 +5193,7 @@ struct InputKeys {
       std::cref(collTerm_nnbarTreatment),
       std::cref(collTerm_noCollisions),
       std::cref(collTerm_onlyWarnForHighProbability),
+      std::cref(collTerm_persistentDecayTimes),
       std::cref(collTerm_resonanceLifetimeModifier),
       std::cref(collTerm_strings),
       std::cref(collTerm_stringsWithProbability),
@@ -5172,6 +5317,8 @@ struct InputKeys {
       std::cref(modi_listBox_filePrefix),
       std::cref(modi_listBox_length),
       std::cref(modi_listBox_shiftId),
+      std::cref(output_binaryBufferSize),
+      std::cref(output_binaryCompression),
       std::cref(output_densityType),
       std::cref(output_outputInterval),
       std::cref(output_outputTimes),
@@ -5226,6 +5373,7 @@ struct InputKeys {
       std::cref(potentials_vdf_powers),
       std::cref(potentials_vdf_satRhoB),
       std::cref(potentials_coulomb_rCut),
+      std::cref(potentials_coulomb_solver),
       std::cref(forcedThermalization_cellNumber),
       std::cref(forcedThermalization_criticalEDensity),
       std::cref(forcedThermalization_startTime),
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2015-2021
+ *    Copyright (c) 2015-2021,2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -187,6 +187,15 @@ class RectangularLattice {
   /// \return Size of lattice.
   std::size_t size() const { return lattice_.size(); }
 
+  /**
+   * Return the index of a node of this lattice, which is also the index of the
+   * same cell in any lattice with identical structure.
+   *
+   * \param[in] node reference to a node of this lattice
+   * \return Index of the node.
+   */
+  std::size_t index_of(const T& node) const { return &node - lattice_.data(); }
+
   /**
    * Overwrite with a template value T at a given node
    */
@@ -615,32 +624,7 @@ class RectangularLattice {
    */
   template <typename F>
   void iterate_in_cube(const ThreeVector& point, const double r_cut, F&& func) {
-    std::array<int, 3> l_bounds, u_bounds;
-
-    /* Array holds value at the cell center: r_center = r_0 + (i+0.5)cell_size,
-     * where i is index in any direction. Therefore we want cells with condition
-     * (r-r_cut)/csize - 0.5 < i < (r+r_cut)/csize - 0.5, r = r_center - r_0 */
-    for (int i = 0; i < 3; i++) {
-      l_bounds[i] =
-          std::ceil((point[i] - origin_[i] - r_cut) / cell_sizes_[i] - 0.5);
-      u_bounds[i] =
-          std::ceil((point[i] - origin_[i] + r_cut) / cell_sizes_[i] - 0.5);
-    }
-
-    if (!periodic_) {
-      for (int i = 0; i < 3; i++) {
-        if (l_bounds[i] < 0) {
-          l_bounds[i] = 0;
-        }
-        if (u_bounds[i] > n_cells_[i]) {
-          u_bounds[i] = n_cells_[i];
-        }
-        if (l_bounds[i] > n_cells_[i] || u_bounds[i] < 0) {
-          return;
-        }
-      }
-    }
-    iterate_sublattice(l_bounds, u_bounds, std::forward<F>(func));
+    iterate_in_rectangle(point, {r_cut, r_cut, r_cut}, std::forward<F>(func));
   }
 
   /**
@@ -682,19 +666,7 @@ class RectangularLattice {
   template <typename F>
   void iterate_in_rectangle(const ThreeVector& point,
                             const std::array<double, 3>& rectangle, F&& func) {
-    std::array<int, 3> l_bounds, u_bounds;
-
-    /* Array holds value at the cell center: r_center = r_0 + (i+0.5)cell_size,
-     * where i is index in any direction. Therefore we want cells with condition
-     * (r[i]-rectangle[i])/csize - 0.5 < i < (r[i]+rectangle[i])/csize - 0.5,
-     * r[i] = r_center[i] - r_0[i]
-     */
-    for (int i = 0; i < 3; i++) {
-      l_bounds[i] = std::ceil(
-          (point[i] - origin_[i] - rectangle[i]) / cell_sizes_[i] - 0.5);
-      u_bounds[i] = std::ceil(
-          (point[i] - origin_[i] + rectangle[i]) / cell_sizes_[i] - 0.5);
-    }
+    auto [l_bounds, u_bounds] = rectangle_bounds(point, rectangle);
 
     if (!periodic_) {
       for (int i = 0; i < 3; i++) {
@@ -712,6 +684,37 @@ class RectangularLattice {
     iterate_sublattice(l_bounds, u_bounds, std::forward<F>(func));
   }
 
+  /**
+   * Finds the cells whose centers lie not further than the given distances
+   * in x-, y-, and z-direction from the given point, before they are cut at
+   * the edges of a non-periodic lattice. These are the cells iterated by
+   * iterate_in_rectangle and iterate_in_cube, which lie in the returned
+   * bounds also for periodic lattices, where the indices are not wrapped.
+   *
+   * \param[in] point Position, usually the position of particle [fm].
+   * \param[in] rectangle Maximum distances in the x-, y-, and z-directions
+   * from the cell center to the given position. [fm]
+   * \return Lowest indices of the cells in x, y and z direction and the
+   *         indices after the highest ones.
+   */
+  std::pair<std::array<int, 3>, std::array<int, 3>> rectangle_bounds(
+      const ThreeVector& point, const std::array<double, 3>& rectangle) const {
+    std::array<int, 3> l_bounds, u_bounds;
+
+    /* Array holds value at the cell center: r_center = r_0 + (i+0.5)cell_size,
+     * where i is index in any direction. Therefore we want cells with condition
+     * (r[i]-rectangle[i])/csize - 0.5 < i < (r[i]+rectangle[i])/csize - 0.5,
+     * r[i] = r_center[i] - r_0[i]
+     */
+    for (int i = 0; i < 3; i++) {
+      l_bounds[i] = std::ceil(
+          (point[i] - origin_[i] - rectangle[i]) / cell_sizes_[i] - 0.5);
+      u_bounds[i] = std::ceil(
+          (point[i] - origin_[i] + rectangle[i]) / cell_sizes_[i] - 0.5);
+    }
+    return {l_bounds, u_bounds};
+  }
+
   /**
    * Iterates only over nodes corresponding to the center cell (the cell
    * containing the given point) and its nearest neighbors in the -x, +x, -y,
@@ -0,0 +1,155 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_MULTIPARTICLERATEBOUNDS_H_
+#define SRC_INCLUDE_SMASH_MULTIPARTICLERATEBOUNDS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "forwarddeclarations.h"
+#include "particledata.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ * Table of upper bounds of the multi-particle reaction rates of a combination
+ * of particle types in bins of the center-of-mass energy.
+ *
+ * The probability of n particles with energies \f$E_i\f$ to react with the
+ * stochastic criterion in a time step \f$\Delta t\f$ and a cell of volume
+ * \f$V\f$ is
+ * \f[ P = \frac{\Delta t}{V^{n-1}\prod_i E_i} \, R(\sqrt{s}) \f]
+ * up to the test particle and cross section scaling factors, where the
+ * reduced rate \f$R\f$ is the sum over all reactions and only depends on the
+ * types of the particles and their \f$\sqrt{s}\f$. Bounding \f$R\f$ allows
+ * rejecting almost all combinations of particles without building their
+ * reactions.
+ *
+ * The bound of a bin is the maximum of the rate evaluated at n_samples + 1
+ * equidistant points in the bin, including its edges, and at the pole masses
+ * of all particle types inside the bin, times a safety factor. This is not a
+ * proven bound: it relies on the rates varying by less than the safety factor
+ * between two samples. The only narrow structures of the rates are the
+ * spectral functions of the resonances formed in 3 -> 1 reactions, which are
+ * sampled at their pole masses, while the phase space integrals and the
+ * parametrized cross sections of the other reactions vary smoothly. The test
+ * multiparticleratebounds_actual checks this for the reactions of SMASH by
+ * dense sampling, and ScatterActionsFinder warns if a combination which
+ * passed the bound has a larger reaction probability. The bins are evaluated
+ * lazily on first use, since only a small part of all combinations and
+ * energies occurs in a simulation.
+ *
+ * The table can be used from several threads concurrently without locking.
+ * Each combination of types takes a slot of a fixed-size hash table on its
+ * first use, and its bins are allocated then. Combinations of more than
+ * max_particles particles, or which do not fit into the table any more, are
+ * not bounded.
+ */
+class MultiParticleRateBounds {
+ public:
+  /// Reduced rate \f$R\f$ of a combination of types at a \f$\sqrt{s}\f$ [GeV]
+  using RateFunction =
+      std::function<double(const ParticleTypePtrList &, double)>;
+
+  /// Width of the \f$\sqrt{s}\f$ bins [GeV].
+  static constexpr double bin_width = 0.01;
+  /// Number of intervals the bins are sampled in.
+  static constexpr int n_samples = 10;
+  /// Factor applied to the largest sampled rate of a bin.
+  static constexpr double safety_factor = 1.2;
+  /// Largest \f$\sqrt{s}\f$ above the threshold which is tabulated [GeV].
+  static constexpr double max_sqrts_above_threshold = 5.;
+  /// Number of bins of each combination
+  static constexpr std::size_t n_bins =
+      static_cast<std::size_t>(max_sqrts_above_threshold / bin_width);
+  /// Largest number of particles of a bounded combination
+  static constexpr std::size_t max_particles = 5;
+  /// Number of bits of the slot indices of the hash table
+  static constexpr int slot_bits = 12;
+  /// Number of combinations the table can hold
+  static constexpr std::size_t n_slots = std::size_t{1} << slot_bits;
+
+  /**
+   * Construct an empty table.
+   *
+   * \param[in] rate Computes the reduced rate, which is bounded. It is called
+   *                 with the types sorted by their PDG codes and must not
+   *                 depend on anything else than its arguments.
+   */
+  explicit MultiParticleRateBounds(RateFunction rate);
+
+  /// Frees the bins
+  ~MultiParticleRateBounds();
+
+  /// Cannot be copied, since the bins are owned
+  MultiParticleRateBounds(const MultiParticleRateBounds &) = delete;
+  /// Cannot be copied, since the bins are owned
+  MultiParticleRateBounds &operator=(const MultiParticleRateBounds &) = delete;
+
+  /**
+   * Upper bound of the reduced rate of a combination of particles.
+   *
+   * \param[in] incoming the particles
+   * \return An upper bound of the reduced rate or infinity, if no bound is
+   *         known for the particles.
+   */
+  double upper_bound(const std::vector<const ParticleData *> &incoming) const;
+
+ private:
+  /**
+   * Evaluate the bound of one bin.
+   *
+   * \param[in] types types of the particles, sorted by their PDG codes
+   * \param[in] threshold sum of the pole masses of the types [GeV]
+   * \param[in] sqrts_min lower edge of the bin [GeV]
+   * \return Bound of the reduced rate in the bin.
+   */
+  double evaluate_bin(const ParticleTypePtrList &types, double threshold,
+                      double sqrts_min) const;
+
+  /// Entry of the hash table of the combinations
+  struct Slot {
+    /**
+     * Indices of the types of the combination plus one, sorted by their PDG
+     * codes and packed into bits_per_type bits each, 0 for a free slot.
+     */
+    std::atomic<std::uint64_t> key{0};
+    /**
+     * Bins of the combination, nullptr until they are first used. The bins
+     * start at the threshold and are negative until they are evaluated.
+     */
+    std::atomic<std::atomic<double> *> bins{nullptr};
+  };
+
+  /// Number of bits of a type index in the key of a combination
+  static constexpr int bits_per_type = 12;
+
+  /**
+   * Find the slot of a combination, and take a free one if it has none yet.
+   *
+   * \param[in] key key of the combination, see Slot::key
+   * \return The slot or nullptr, if the table is full.
+   */
+  Slot *find_slot(std::uint64_t key) const;
+
+  /// Function computing the bounded rate.
+  RateFunction rate_;
+
+  /// Hash table of the combinations with n_slots entries
+  std::unique_ptr<Slot[]> slots_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_MULTIPARTICLERATEBOUNDS_H_
@@ -0,0 +1,91 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_OBJECTPOOL_H_
+#define SRC_INCLUDE_SMASH_OBJECTPOOL_H_
+
+#include <cstddef>
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * Base class for objects that are allocated from a pool of fixed size blocks
+ * instead of the general purpose heap.
+ *
+ * The collision term creates and destroys a large number of small, short-lived
+ * objects in every time step: an Action for every candidate interaction and a
+ * CollisionBranch or DecayBranch for every channel of it, most of which are
+ * discarded right away. Deriving from this class gives a class and all of its
+ * subclasses an operator new and delete that take the memory from free lists
+ * of blocks, one list per multiple of 16 bytes. Freed blocks go back to the
+ * list of their size and are reused by the objects of the next time step, so
+ * after the first steps hardly any call reaches the heap. Nothing changes for
+ * the users of the class: std::make_unique and std::unique_ptr work as before.
+ *
+ * Memory is taken from the heap in chunks of 64 KiB, which belong to the
+ * thread that took them. The free lists of a thread need no locking. A block
+ * freed on another thread, e.g. an action found on a worker and performed on
+ * the main thread, is pushed onto a lock-free list of the owning thread, which
+ * takes it back before it takes a new chunk. When a thread finishes, its free
+ * blocks are shared by the other threads, which use them before new chunks,
+ * and its chunks are handed on to the next new thread.
+ *
+ * Chunks are never given back to the heap, so the pool holds on to its peak
+ * memory. A thread only takes a new chunk if each block of the size is in
+ * use, in the free list of another running thread, or returned to another
+ * thread which did not take it back yet. The chunks of a block size hence
+ * hold at most the largest number of such blocks at any time plus less than
+ * one chunk per thread, but blocks idle in the lists of one thread are not
+ * available to the others while it runs. Objects larger than the largest
+ * block use the heap directly.
+ *
+ * A class deriving from PoolAllocated must have a virtual destructor if it is
+ * deleted through a pointer to its base, since the size of the block is given
+ * by the dynamic type.
+ */
+class PoolAllocated {
+ public:
+  /**
+   * Allocate memory for an object.
+   *
+   * \param[in] size Size of the object in bytes
+   * \return Memory aligned for any object of that size
+   */
+  static void *operator new(std::size_t size);
+
+  /**
+   * Return the memory of an object to the pool.
+   *
+   * \param[in] p Pointer obtained from operator new
+   * \param[in] size Size of the object in bytes, as given to operator new
+   */
+  static void operator delete(void *p, std::size_t size) noexcept;
+
+  /// \return Number of chunks taken from the heap so far by all threads
+  static std::size_t n_chunks();
+
+  /**
+   * \return Number of objects the calling thread has allocated so far, from
+   *         the pool or, if they are too large, from the heap
+   */
+  static std::size_t n_allocations();
+
+  /// Largest object size in bytes that is served from the pool
+  static constexpr std::size_t max_block_size = 2048;
+
+ protected:
+  /// Only derived classes can be created.
+  PoolAllocated() = default;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_OBJECTPOOL_H_
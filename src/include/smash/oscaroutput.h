@@ -72,6 +72,9 @@ class OscarOutput : public OutputInterface {
    */
   OscarOutput(const std::filesystem::path &path, const std::string &name);
 
+  /// Write the lines which are still buffered.
+  ~OscarOutput() override;
+
   /**
    * Writes the initial particle information of an event to the oscar output.
    * \param[in] particles Current list of all particles.
@@ -125,9 +128,26 @@ class OscarOutput : public OutputInterface {
    */
   void write(const Particles &particles);
 
+  /**
+   * Write the buffered lines to the file.
+   *
+   * \param[in] only_if_full Only write them if there are more than
+   *                         max_buffer_size bytes.
+   */
+  void write_buffer(bool only_if_full);
+
+  /// Size [bytes] of the buffered lines above which they are written early
+  static constexpr std::size_t max_buffer_size = 4 * 1024 * 1024;
+
   /// Keep track of event number.
   int current_event_ = 0;
 
+  /**
+   * Lines formatted since the last write. They are written at the end of an
+   * event, or earlier if there are more than max_buffer_size bytes.
+   */
+  std::string buffer_;
+
   /// Full filepath of the output file.
   RenamingFilePtr file_;
 };
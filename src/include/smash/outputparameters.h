@@ -77,7 +77,9 @@ struct OutputParameters {
         dil_extended(false),
         photons_extended(false),
         ic_extended(false),
-        rivet_parameters{} {}
+        rivet_parameters{},
+        binary_buffer_size(16 * 1024 * 1024),
+        binary_compression(BinaryCompression::None) {}
 
   /// Constructor from configuration
   explicit OutputParameters(Configuration conf) : OutputParameters() {
@@ -281,6 +283,12 @@ struct OutputParameters {
 
   /// Rivet specfic parameters
   RivetOutputParameters rivet_parameters;
+
+  /// Memory budget [bytes] of each binary output for records to be written
+  std::size_t binary_buffer_size;
+
+  /// Codec of the binary outputs, None for uncompressed files
+  BinaryCompression binary_compression;
 };
 
 }  // namespace smash
@@ -80,6 +80,15 @@ class ParticleData {
    */
   void set_id(int i) { id_ = i; }
 
+  /**
+   * Get the index of the particle in the Particles object holding it. It
+   * identifies the particle as long as it exists and is reused for another
+   * particle after it is removed.
+   * \return internal index, the maximal unsigned value for a particle that
+   *         was never inserted into a Particles object
+   */
+  unsigned index() const { return index_; }
+
   /**
    * Get the pdgcode of the particle
    * \return pdgcode of the particle
@@ -163,6 +172,7 @@ class ParticleData {
    */
   void set_4momentum(const FourVector &momentum_vector) {
     momentum_ = momentum_vector;
+    unschedule_decay();
   }
 
   /**
@@ -173,6 +183,7 @@ class ParticleData {
    */
   void set_4momentum(double mass, const ThreeVector &mom) {
     momentum_ = FourVector(std::sqrt(mass * mass + mom * mom), mom);
+    unschedule_decay();
   }
 
   /**
@@ -186,6 +197,7 @@ class ParticleData {
   void set_4momentum(double mass, double px, double py, double pz) {
     momentum_ = FourVector(std::sqrt(mass * mass + px * px + py * py + pz * pz),
                            px, py, pz);
+    unschedule_decay();
   }
   /**
    * Set the momentum of the particle without modifying the energy.
@@ -195,6 +207,7 @@ class ParticleData {
    */
   void set_3momentum(const ThreeVector &mom) {
     momentum_ = FourVector(momentum_.x0(), mom);
+    unschedule_decay();
   }
 
   /**
@@ -252,6 +265,7 @@ class ParticleData {
     formation_time_ = form_time;
     // cross section scaling factor will be a step function in time
     begin_formation_time_ = form_time;
+    unschedule_decay();
   }
   /**
    * Set the time, when the cross section scaling factor begins, and finishes
@@ -265,6 +279,29 @@ class ParticleData {
   void set_slow_formation_times(double begin_form_time, double form_time) {
     begin_formation_time_ = begin_form_time;
     formation_time_ = form_time;
+    unschedule_decay();
+  }
+
+  /**
+   * Get the time at which the particle decays, if it has been sampled once
+   * for its current momentum instead of in every time step.
+   *
+   * \return absolute decay time in the computational frame, NaN if it has
+   *         not been sampled since the momentum or formation time changed
+   */
+  double scheduled_decay_time() const { return scheduled_decay_time_; }
+
+  /**
+   * Set the absolute decay time in the computational frame, which stays valid
+   * until the momentum or the formation time of the particle change.
+   *
+   * \param[in] time absolute decay time
+   */
+  void schedule_decay(double time) { scheduled_decay_time_ = time; }
+
+  /// Discard the scheduled decay time, such that it is sampled again.
+  void unschedule_decay() {
+    scheduled_decay_time_ = std::numeric_limits<double>::quiet_NaN();
   }
 
   /**
@@ -407,6 +444,7 @@ class ParticleData {
     dst.initial_xsec_scaling_factor_ = initial_xsec_scaling_factor_;
     dst.begin_formation_time_ = begin_formation_time_;
     dst.belongs_to_ = belongs_to_;
+    dst.scheduled_decay_time_ = scheduled_decay_time_;
   }
 
   /**
@@ -468,6 +506,8 @@ class ParticleData {
   HistoryData history_;
   /// is it part of projectile or target nuclei?
   BelongsTo belongs_to_ = BelongsTo::Nothing;
+  /// Absolute decay time, if sampled once for the current momentum, or NaN
+  double scheduled_decay_time_ = std::numeric_limits<double>::quiet_NaN();
 };
 
 /**
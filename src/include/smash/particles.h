@@ -40,6 +40,18 @@ class Particles {
   /// Cannot be copied
   Particles &operator=(const Particles &) = delete;
 
+  /**
+   * Replace the content of this list by an exact copy of \p other, including
+   * the particle ids.
+   *
+   * Particles are not copied implicitly, see the class description. This is
+   * only meant for keeping the state of the particles at a given time, e.g.
+   * for outputs that are written later.
+   *
+   * \param[in] other The particles to be copied
+   */
+  void copy_from(const Particles &other);
+
   /// \return a copy of all particles as a std::vector<ParticleData>.
   ParticleList copy_to_vector() const {
     if (dirty_.empty()) {
@@ -223,6 +235,16 @@ class Particles {
     assert(is_valid(old_state));
     return data_[old_state.index_];
   }
+  /**
+   * Non-const overload of lookup, for modifying the particle in place.
+   *
+   * \param[in] old_state A valid copy of the particle
+   * \return The current state of the particle.
+   */
+  ParticleData &lookup(const ParticleData &old_state) {
+    assert(is_valid(old_state));
+    return data_[old_state.index_];
+  }
 
   /**
    * \internal
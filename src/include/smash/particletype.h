@@ -8,6 +8,7 @@
 #define SRC_INCLUDE_SMASH_PARTICLETYPE_H_
 
 #include <cassert>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -323,6 +324,22 @@ class ParticleType {
   DecayBranchList get_partial_widths(const FourVector p, const ThreeVector x,
                                      WhichDecaymodes wh) const;
 
+  /**
+   * Get the total width of the wanted decay modes of a particle, i.e. the sum
+   * of the weights of get_partial_widths, without creating the branches.
+   *
+   * \param[in] p 4-momentum of the decaying particle.
+   * \param[in] x position of the decaying particle.
+   * \param[in] wh enum that decides which decay modes are summed.
+   * \param[in] tabulated whether to interpolate the widths tabulated by
+   *                      tabulate_decay_widths, which is faster but not
+   *                      exact. Masses beyond the tables and types without
+   *                      tables are evaluated exactly.
+   * \return the total width of the wanted decay modes.
+   */
+  double get_total_width(const FourVector p, const ThreeVector x,
+                         WhichDecaymodes wh, bool tabulated = false) const;
+
   /**
    * Get the mass-dependent partial width of a resonance with mass m,
    * decaying into two given daughter particles.
@@ -420,6 +437,15 @@ class ParticleType {
                                                     const double cms_energy,
                                                     int L = 0) const;
 
+  /**
+   * Reset the maximum factors of the resonance mass sampling of the calling
+   * thread, which are adapted during the sampling.
+   *
+   * Resetting them at the beginning of every event makes the masses sampled
+   * in an event independent of the events sampled before on the same thread.
+   */
+  static void reset_max_factors();
+
   /**
    * Prints out width and spectral function versus mass to the
    * standard output. This is useful for debugging and analysis.
@@ -562,6 +588,30 @@ class ParticleType {
    */
   static void check_consistency();
 
+  /**
+   * Evaluate all lazily initialized properties of all particle types and of
+   * their decay modes, i.e. the minimal masses, the isospin, the normalization
+   * of the spectral function, the decay thresholds and the tabulated decay
+   * widths.
+   *
+   * Afterwards using the particle types does not modify them anymore, which
+   * is required before they are shared between several threads.
+   *
+   * Note that the particles and decay modes have to be initialized, otherwise
+   * calling this is undefined behavior.
+   */
+  static void precompute_lazy_properties();
+
+  /**
+   * Tabulate the partial widths of all decay modes of all unstable particle
+   * types on a mass grid for get_total_width. The grid of each decay mode
+   * starts at its threshold, so that the tables are smooth.
+   *
+   * Like precompute_lazy_properties, this has to be called before the
+   * particle types are shared between several threads.
+   */
+  static void tabulate_decay_widths();
+
   /**
    * Returns an object that acts like a pointer, except that it requires only 2
    * bytes and inhibits pointer arithmetics.
@@ -638,6 +688,14 @@ class ParticleType {
   /** This normalization factor ensures that the spectral function is normalized
    * to unity, when integrated over its full domain. */
   mutable double norm_factor_ = -1.;
+  /// Decay widths tabulated on a mass grid
+  struct DecayWidthTables;
+  /**
+   * Decay widths of the particle, tabulated by tabulate_decay_widths.
+   * Mutable, because they are filled for the particle types in the global
+   * list; nullptr if they are not tabulated.
+   */
+  mutable std::shared_ptr<const DecayWidthTables> decay_width_tables_;
   /// Charge of the particle; filled automatically from pdgcode_.
   int32_t charge_;
   /// Isospin of the particle; filled automatically from pdgcode_.
@@ -648,11 +706,6 @@ class ParticleType {
   /// Container for the isospin multiplet information
   IsoParticleType *iso_multiplet_ = nullptr;
 
-  /// Maximum factor for single-res mass sampling, cf. sample_resonance_mass.
-  mutable double max_factor1_ = 1.;
-  /// Maximum factor for double-res mass sampling, cf. sample_resonance_masses.
-  mutable double max_factor2_ = 1.;
-
   /**\ingroup logging
    * Writes all information about the particle type to the output stream.
    *
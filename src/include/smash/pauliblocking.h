@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2015,2017-2018,2020,2022
+ *    Copyright (c) 2015,2017-2018,2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -10,6 +10,9 @@
 #ifndef SRC_INCLUDE_SMASH_PAULIBLOCKING_H_
 #define SRC_INCLUDE_SMASH_PAULIBLOCKING_H_
 
+#include <array>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "configuration.h"
@@ -68,6 +71,40 @@ class PauliBlocker {
                          const PdgCode pdg,
                          const ParticleList &disregard) const;
 
+  /**
+   * Sort all particles into cells in coordinate space, one set of cells for
+   * each PDG code, such that phasespace_dens only needs to look at the
+   * particles close to the given point.
+   *
+   * The index stays valid while the particles move on straight lines for at
+   * most \p time_step_duration. Particles created in that time have to be
+   * added with add_to_index, and it has to be cleared before the momenta are
+   * changed otherwise, e.g. by potentials. Without index all particles are
+   * looked at.
+   *
+   * \param[in] ensembles Current list of particles in all ensembles.
+   * \param[in] time Time of the particle positions [fm].
+   * \param[in] time_step_duration Time the index is used for [fm].
+   */
+  void build_index(const std::vector<Particles> &ensembles, double time,
+                   double time_step_duration);
+
+  /**
+   * Add new particles to the index. They are sorted in where their straight
+   * line trajectory was at the time of build_index. Particles which are
+   * removed from the ensembles do not need to be removed from the index.
+   * An entry of the same ensemble and index in Particles is replaced, such
+   * that a particle crossing a wall is only indexed once. Does nothing if
+   * there is no index.
+   *
+   * \param[in] particles Particles created since build_index.
+   * \param[in] i_ensemble Ensemble the particles belong to.
+   */
+  void add_to_index(const ParticleList &particles, int i_ensemble);
+
+  /// Remove the index, such that all particles are looked at again.
+  void clear_index();
+
  private:
   /// Tabulate integrals for weights
   void init_weights();
@@ -95,6 +132,58 @@ class PauliBlocker {
 
   /// Weights: tabulated results of numerical integration
   std::array<double, 30> weights_;
+
+  /// Identifies a cell of the index: PDG code and the 3 cell coordinates.
+  using CellKey = std::pair<PdgCode, std::array<int, 3>>;
+
+  /// Hash function of CellKey.
+  struct CellKeyHash {
+    /**
+     * \param[in] key cell to hash
+     * \return hash of the cell
+     */
+    std::size_t operator()(const CellKey &key) const {
+      std::size_t hash = std::hash<std::int32_t>()(key.first.code());
+      for (const int i : key.second) {
+        hash = hash * 1000003 ^ std::hash<int>()(i);
+      }
+      return hash;
+    }
+  };
+
+  /**
+   * \return the cell of the index in which a particle of the given PDG code
+   * at position \p r lies.
+   *
+   * \param[in] pdg PDG code of the particle
+   * \param[in] r position of the particle
+   */
+  CellKey cell_of(PdgCode pdg, const ThreeVector &r) const;
+
+  /// Whether the index was built.
+  bool has_index_ = false;
+
+  /// Time of the particle positions in the index, fm
+  double index_time_ = 0.0;
+
+  /// Length of the index cells, fm
+  double cell_length_ = 0.0;
+
+  /// Copies of the particles in a cell of the index and their ensemble
+  using Cell = std::vector<std::pair<int, ParticleData>>;
+
+  /**
+   * The index: copies of the particles and their ensemble in each cell. The
+   * copies are used to look up the current state of the particles.
+   */
+  std::unordered_map<CellKey, Cell, CellKeyHash> index_;
+
+  /**
+   * The cell of the last particle indexed for each ensemble and index in
+   * Particles, nullptr if there is none. Cells of an unordered_map keep their
+   * address when more are added.
+   */
+  std::vector<std::vector<Cell *>> indexed_cells_;
 };
 }  // namespace smash
 
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2018-2020
+ *    Copyright (c) 2018-2020,2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -15,14 +15,20 @@
 
 namespace smash {
 
+/*
+ * The pointers are thread local, since several experiments can be evolved at
+ * the same time, each on its own threads. Every thread evaluating actions has
+ * to set them to the potentials of its experiment.
+ */
+
 /// Pointer to the skyrme potential on the lattice
-extern RectangularLattice<FourVector> *UB_lat_pointer;
+extern thread_local RectangularLattice<FourVector> *UB_lat_pointer;
 
 /// Pointer to the symmmetry potential on the lattice
-extern RectangularLattice<FourVector> *UI3_lat_pointer;
+extern thread_local RectangularLattice<FourVector> *UI3_lat_pointer;
 
 /// Pointer to a Potential class
-extern Potentials *pot_pointer;
+extern thread_local Potentials *pot_pointer;
 
 }  // namespace smash
 
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2015,2017-2022
+ *    Copyright (c) 2014-2015,2017-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -353,8 +353,16 @@ class Potentials {
   /// \return Number of terms in the VDF potential
   int number_of_terms() const { return powers_.size(); }
 
+  /**
+   * \return Distance [fm] beyond which particles do not contribute to
+   *         all_forces, the cut-off of the Gaussian smearing
+   */
+  double force_range() const { return param_.r_cut(); }
+
   /// \return cutoff radius in ntegration for coulomb potential in fm
   double coulomb_r_cut() const { return coulomb_r_cut_; }
+  /// \return Method of calculating the fields of the coulomb potential
+  CoulombSolver coulomb_solver() const { return coulomb_solver_; }
 
  private:
   /**
@@ -413,6 +421,9 @@ class Potentials {
   /// Cutoff in integration for coulomb potential
   double coulomb_r_cut_;
 
+  /// Method of calculating the fields of the coulomb potential
+  CoulombSolver coulomb_solver_ = CoulombSolver::Direct;
+
   /**
    * Saturation density of nuclear matter used in the VDF potential; it may
    * vary between different parameterizations.
@@ -14,6 +14,7 @@
 
 #include "decaytype.h"
 #include "forwarddeclarations.h"
+#include "objectpool.h"
 #include "particletype.h"
 
 namespace smash {
@@ -125,8 +126,11 @@ std::ostream &operator<<(std::ostream &os, ProcessType process_type);
  * branch.set_weight(1);
  * deltaplus_decay_modes.push_back(branch);
  * \endcode
+ *
+ * Branches are allocated from a PoolAllocated pool, since the cross sections
+ * create a new list of them for every candidate collision.
  */
-class ProcessBranch {
+class ProcessBranch : public PoolAllocated {
  public:
   /// Create a ProcessBranch without final states and weight.
   ProcessBranch() : branch_weight_(0.) {}
@@ -1,5 +1,5 @@
 /*
- *    Copyright (c) 2013-2022
+ *    Copyright (c) 2013-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -8,6 +8,7 @@
 #ifndef SRC_INCLUDE_SMASH_PROPAGATION_H_
 #define SRC_INCLUDE_SMASH_PROPAGATION_H_
 
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -72,6 +73,49 @@ double calc_hubble(double time, const ExpansionProperties &metric);
 double propagate_straight_line(Particles *particles, double to_time,
                                const std::vector<FourVector> &beam_momentum);
 
+/**
+ * Propagates only the given particles on a straight line to a given moment,
+ * like propagate_straight_line for all particles.
+ *
+ * This allows propagating particles lazily, i.e. only when their position is
+ * needed. Particles keep their individual time until then, which is the time
+ * of their 4-position.
+ *
+ * \param[out] particles The particle list in the event
+ * \param[in,out] to_propagate Valid copies of the particles to be propagated.
+ *                 They are updated to the propagated state.
+ * \param[in] to_time final time [fm]
+ * \param[in] beam_momentum 4-momenta of the initial nucleons with "frozen
+ *            Fermi motion", see above [GeV]
+ */
+void propagate_straight_line(Particles *particles, ParticleList &to_propagate,
+                             double to_time,
+                             const std::vector<FourVector> &beam_momentum);
+
+/**
+ * Kernel of the straight line propagation of a batch of particles.
+ *
+ * Each component is a separate array, such that the compiler vectorizes the
+ * loop with the widest instruction set enabled for the build (e.g. AVX2 or
+ * AVX-512 with -march=native) and falls back to scalar code otherwise. The
+ * arrays must not overlap.
+ *
+ * \param[in] n number of particles
+ * \param[in] to_time final time [fm]
+ * \param[in,out] t times of the particles [fm], set to to_time
+ * \param[in,out] x x coordinates of the particles [fm]
+ * \param[in,out] y y coordinates of the particles [fm]
+ * \param[in,out] z z coordinates of the particles [fm]
+ * \param[in] energy energies the velocities are calculated from [GeV]
+ * \param[in] px x components of the momenta [GeV]
+ * \param[in] py y components of the momenta [GeV]
+ * \param[in] pz z components of the momenta [GeV]
+ */
+void propagate_straight_line_kernel(std::size_t n, double to_time, double *t,
+                                    double *x, double *y, double *z,
+                                    const double *energy, const double *px,
+                                    const double *py, const double *pz);
+
 /**
  * Modifies positions and momentum of all particles to account for
  * space-time deformation.
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2012-2020
+ *    Copyright (c) 2012-2020,2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -11,6 +11,7 @@
 #define SRC_INCLUDE_SMASH_RANDOM_H_
 
 #include <cassert>
+#include <cstdint>
 #include <limits>
 #include <random>
 #include <utility>
@@ -26,8 +27,138 @@ namespace random {
 /// The random number engine used is the Mersenne Twister.
 using Engine = std::mt19937_64;
 
-/// The engine that is used commonly by all distributions.
-extern /*thread_local (see #3075)*/ Engine engine;
+/**
+ * A stream of random numbers that can be split deterministically.
+ *
+ * A stream wraps a random number engine together with the seed it was started
+ * with. Independent sub-streams, e.g. one per ensemble or per event, are
+ * obtained with split. The seed of a sub-stream is derived only from the seed
+ * of the parent stream and the index of the sub-stream and not from the state
+ * of the parent, so the numbers of the sub-stream do not depend on how many
+ * numbers were drawn from the parent or from other sub-streams before. This is
+ * what makes results reproducible independently of the order in which
+ * concurrently running threads draw their numbers.
+ *
+ * A stream satisfies the UniformRandomBitGenerator requirements, so it can be
+ * handed directly to the distributions of the standard library. The free
+ * functions in this namespace draw from the stream that is active on the
+ * calling thread, see StreamScope.
+ */
+class Stream {
+ public:
+  /// Type of the generated values
+  using result_type = Engine::result_type;
+
+  /**
+   * Start a stream with the given seed.
+   *
+   * \param[in] seed Seed of the stream
+   */
+  explicit Stream(uint64_t seed = Engine::default_seed)
+      : seed_(seed), engine_(seed) {}
+
+  /**
+   * Derive an independent sub-stream.
+   *
+   * Splitting the same stream with the same index always gives the same
+   * sub-stream, while different indices give statistically independent ones.
+   *
+   * \param[in] index Index of the sub-stream
+   * \return The sub-stream
+   */
+  Stream split(uint64_t index) const {
+    return Stream(mix(seed_ + golden_gamma * (index + 1)));
+  }
+
+  /// \return the seed the stream was started with
+  uint64_t seed() const { return seed_; }
+
+  /// \return the smallest value that can be generated
+  static constexpr result_type min() { return Engine::min(); }
+  /// \return the largest value that can be generated
+  static constexpr result_type max() { return Engine::max(); }
+  /// Advance the stream's state and return the generated value.
+  result_type operator()() { return engine_(); }
+
+ private:
+  /// Increment of the SplitMix64 generator
+  static constexpr uint64_t golden_gamma = 0x9e3779b97f4a7c15;
+
+  /**
+   * Finalizer of the SplitMix64 generator, which maps neighbouring inputs to
+   * uncorrelated outputs.
+   *
+   * \param[in] z Value to be mixed
+   * \return The mixed value
+   */
+  static constexpr uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+
+  /// The seed the stream was started with
+  uint64_t seed_;
+  /// The engine generating the numbers
+  Engine engine_;
+};
+
+/// Implementation details of the stream selection.
+namespace detail {
+/// The stream used on this thread if no StreamScope is active
+extern thread_local Stream default_stream;
+/// The stream of the innermost active StreamScope on this thread, if any
+extern thread_local Stream *active_stream;
+}  // namespace detail
+
+/**
+ * \return the stream that is currently used by all distributions on the
+ * calling thread.
+ *
+ * Every thread has its own default stream, so the distributions can be sampled
+ * concurrently. It is replaced by another stream during the lifetime of a
+ * StreamScope.
+ */
+inline Stream &current_stream() {
+  return detail::active_stream ? *detail::active_stream
+                               : detail::default_stream;
+}
+
+/**
+ * Makes a stream the one used by all distributions on the calling thread.
+ *
+ * The previously used stream is restored when the scope object is destroyed.
+ * Scopes can be nested. Example:
+ *
+ * \code
+ *   random::Stream ensemble_stream = event_stream.split(i_ensemble);
+ *   {
+ *     random::StreamScope scope(ensemble_stream);
+ *     // All random numbers drawn here come from ensemble_stream.
+ *   }
+ * \endcode
+ */
+class StreamScope {
+ public:
+  /**
+   * Activate the given stream on the calling thread.
+   *
+   * \param[in] stream Stream to be used. It has to outlive the scope.
+   */
+  explicit StreamScope(Stream &stream) : previous_(detail::active_stream) {
+    detail::active_stream = &stream;
+  }
+  /// Restore the previously used stream.
+  ~StreamScope() { detail::active_stream = previous_; }
+  /// Cannot be copied
+  StreamScope(const StreamScope &) = delete;
+  /// Cannot be copied
+  StreamScope &operator=(const StreamScope &) = delete;
+
+ private:
+  /// The stream used before the scope was entered
+  Stream *previous_;
+};
 
 /** Provides uniform random numbers on a fixed interval.
  *
@@ -56,7 +187,7 @@ class uniform_dist {
    * */
   uniform_dist(T min, T max) : distribution(min, max) {}
   /** \returns A random number in the interval. */
-  T operator()() { return distribution(engine); }
+  T operator()() { return distribution(current_stream()); }
 
  private:
   /** The distribution object that is being used. */
@@ -66,16 +197,19 @@ class uniform_dist {
 /** Generates a seed with a truly random 63-bit value, if possible */
 int64_t generate_63bit_seed();
 
-/** Sets the seed of the random number engine. */
+/**
+ * Restarts the stream currently used on the calling thread with the given
+ * seed.
+ */
 template <typename T>
 void set_seed(T &&seed) {
   static_assert(std::is_same<Engine::result_type, uint64_t>::value,
                 "experiment.cc needs the seed to be 64 bits");
-  engine.seed(std::forward<T>(seed));
+  current_stream() = Stream(std::forward<T>(seed));
 }
 
-/// Advance the engine's state and return the generated value.
-inline Engine::result_type advance() { return engine(); }
+/// Advance the current stream's state and return the generated value.
+inline Engine::result_type advance() { return current_stream()(); }
 
 /**
  * \returns A uniformly distributed random real number \f$\chi \in [{\rm
@@ -86,7 +220,7 @@ inline Engine::result_type advance() { return engine(); }
  */
 template <typename T>
 T uniform(T min, T max) {
-  return std::uniform_real_distribution<T>(min, max)(engine);
+  return std::uniform_real_distribution<T>(min, max)(current_stream());
 }
 
 /**
@@ -98,7 +232,7 @@ T uniform(T min, T max) {
  */
 template <typename T>
 T uniform_int(T min, T max) {
-  return std::uniform_int_distribution<T>(min, max)(engine);
+  return std::uniform_int_distribution<T>(min, max)(current_stream());
 }
 
 /**
@@ -112,7 +246,7 @@ T uniform_int(T min, T max) {
 template <typename T = double>
 T canonical() {
   return std::generate_canonical<T, std::numeric_limits<double>::digits>(
-      engine);
+      current_stream());
 }
 
 /**
@@ -122,7 +256,8 @@ template <typename T = double>
 T canonical_nonzero() {
   // use 'nextafter' to generate a value that is guaranteed to be larger than 0
   return std::nextafter(
-      std::generate_canonical<T, std::numeric_limits<double>::digits>(engine),
+      std::generate_canonical<T, std::numeric_limits<double>::digits>(
+          current_stream()),
       T(1));
 }
 
@@ -224,7 +359,7 @@ T power(T n, T xMin, T xMax) {
  */
 template <typename T>
 int poisson(const T &lam) {
-  return std::poisson_distribution<int>(lam)(engine);
+  return std::poisson_distribution<int>(lam)(current_stream());
 }
 
 /**
@@ -236,7 +371,7 @@ int poisson(const T &lam) {
  */
 template <typename T>
 int binomial(const int N, const T &p) {
-  return std::binomial_distribution<int>(N, p)(engine);
+  return std::binomial_distribution<int>(N, p)(current_stream());
 }
 
 /**
@@ -248,7 +383,7 @@ int binomial(const int N, const T &p) {
  */
 template <typename T>
 double normal(const T &mean, const T &sigma) {
-  return std::normal_distribution<double>(mean, sigma)(engine);
+  return std::normal_distribution<double>(mean, sigma)(current_stream());
 }
 
 /**
@@ -283,7 +418,7 @@ class discrete_dist {
   /** Draw a random number from the discrete distribution.
    * \return Sampled value
    */
-  int operator()() { return distribution(engine); }
+  int operator()() { return distribution(current_stream()); }
 
  private:
   /** The distribution object that is being used. */
@@ -329,8 +464,8 @@ template <typename T = double>
 T beta(T a, T b) {
   // Otherwise the integral over probability density diverges
   assert(a > T(0.0) && b > T(0.0));
-  const T x1 = std::gamma_distribution<T>(a)(engine);
-  const T x2 = std::gamma_distribution<T>(b)(engine);
+  const T x1 = std::gamma_distribution<T>(a)(current_stream());
+  const T x2 = std::gamma_distribution<T>(b)(current_stream());
   return x1 / (x1 + x2);
 }
 
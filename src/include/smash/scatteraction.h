@@ -79,7 +79,22 @@ class ScatterAction : public Action {
    *
    * \return  squared distance \f$d^2_\mathrm{coll}\f$.
    */
-  double transverse_distance_sqr() const;
+  double transverse_distance_sqr() const {
+    return transverse_distance_sqr(incoming_particles_[0],
+                                   incoming_particles_[1]);
+  }
+
+  /**
+   * Calculate the transverse distance of two particles in their local rest
+   * frame, see the overload above. This does not require an action, such
+   * that far away particle pairs can be rejected without creating one.
+   *
+   * \param[in] p_a first particle
+   * \param[in] p_b second particle
+   * \return  squared distance \f$d^2_\mathrm{coll}\f$.
+   */
+  static double transverse_distance_sqr(const ParticleData& p_a,
+                                        const ParticleData& p_b);
 
   /**
    * Calculate the transverse distance of the two incoming particles in their
@@ -88,7 +103,21 @@ class ScatterAction : public Action {
    *
    * \return squared distance  \f$d^2_\mathrm{coll}\f$.
    */
-  double cov_transverse_distance_sqr() const;
+  double cov_transverse_distance_sqr() const {
+    return cov_transverse_distance_sqr(incoming_particles_[0],
+                                       incoming_particles_[1]);
+  }
+
+  /**
+   * Calculate the covariant transverse distance of two particles, see the
+   * overload above. This does not require an action.
+   *
+   * \param[in] p_a first particle
+   * \param[in] p_b second particle
+   * \return squared distance  \f$d^2_\mathrm{coll}\f$.
+   */
+  static double cov_transverse_distance_sqr(const ParticleData& p_a,
+                                            const ParticleData& p_b);
   /**
    * Determine the Mandelstam s variable,
    *
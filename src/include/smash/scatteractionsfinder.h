@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2022
+ *    Copyright (c) 2014-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -17,8 +17,11 @@
 #include "action.h"
 #include "actionfinderfactory.h"
 #include "configuration.h"
+#include "crosssectionbounds.h"
+#include "multiparticleratebounds.h"
 #include "scatteraction.h"
 #include "scatteractionsfinderparameters.h"
+#include "threadpool.h"
 
 namespace smash {
 
@@ -149,6 +152,10 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * secondary collisions among the outgoing particles, no new actions will be
    * found since the scattered pairs cannot scatter again.)
    *
+   * Multi-particle reactions are only checked for the combinations of
+   * particles of the species that take part in them, e.g. only pions for
+   * 5-to-2 reactions.
+   *
    * \param[in] search_list A list of particles within one cell
    * \param[in] dt The maximum time interval at the current time step [fm]
    * \param[in] gcell_vol Volume of searched grid cell [fm^3]
@@ -264,12 +271,52 @@ class ScatterActionsFinder : public ActionFinderInterface {
    */
   StringProcess *get_process_string_ptr() {
     if (finder_parameters_.strings_switch) {
-      return string_process_interface_.get();
+      return string_process_interfaces_.front().get();
     } else {
       return NULL;
     }
   }
 
+  /**
+   * \return Pointers to the string process class objects of all ensemble
+   *         threads, see \ref key_gen_ensemble_threads_. If string is turned
+   *         off, the list is empty.
+   */
+  std::vector<StringProcess *> get_process_string_ptrs() {
+    std::vector<StringProcess *> ptrs;
+    for (const auto &string_process : string_process_interfaces_) {
+      ptrs.push_back(string_process.get());
+    }
+    return ptrs;
+  }
+
+  /**
+   * Compute the total cross section of two particles of the given types on
+   * their mass shell, which collide back to back. This is the cross section
+   * which is bounded to reject pairs early, see CrossSectionBounds.
+   *
+   * \param[in] type_a type of the first particle
+   * \param[in] type_b type of the second particle
+   * \param[in] sqrts center-of-mass energy [GeV]
+   * \return The total cross section [mb].
+   */
+  double total_cross_section(const ParticleType &type_a,
+                             const ParticleType &type_b, double sqrts) const;
+
+  /**
+   * Compute the reduced rate of all included multi-particle reactions of
+   * particles of the given types on their mass shell, i.e. the reaction
+   * probability for \f$\Delta t = 1\f$ fm and \f$V = 1\f$ fm\f$^3\f$ times
+   * the product of the energies of the particles. This is the rate which is
+   * bounded to reject combinations early, see MultiParticleRateBounds.
+   *
+   * \param[in] types types of the particles
+   * \param[in] sqrts center-of-mass energy [GeV]
+   * \return The reduced rate [GeV\f$^n\f$ fm\f$^{3n-4}\f$].
+   */
+  double multi_particle_rate(const ParticleTypePtrList &types,
+                             double sqrts) const;
+
  private:
   /**
    * Check for a single pair of particles (id_a, id_b) if a collision will
@@ -307,19 +354,33 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * as for the 2-particle scatterings, probabilities for multi-particle
    * scatterings can be derived.
    *
-   * \param[in] plist List of incoming particles
+   * \param[in] incoming Incoming particles, which are only copied if an
+   *                     action is created
    * \param[in] dt Maximum time interval within which a collision can happen
    * \param[in] gcell_vol volume of grid cell in which the collision is checked
    * \return A null pointer if no collision happens or an action which contains
    *         the information of the outgoing particles.
    */
-  ActionPtr check_collision_multi_part(const ParticleList &plist, double dt,
-                                       const double gcell_vol) const;
+  ActionPtr check_collision_multi_part(
+      const std::vector<const ParticleData *> &incoming, double dt,
+      const double gcell_vol) const;
 
   /// Struct collecting several parameters.
   ScatterActionsFinderParameters finder_parameters_;
-  /// Class that deals with strings, interfacing Pythia.
-  std::unique_ptr<StringProcess> string_process_interface_;
+  /**
+   * \return The string process class object of the calling thread, see
+   *         ThreadPool::current_thread_index.
+   */
+  StringProcess *string_process_interface() const {
+    return string_process_interfaces_[ThreadPool::current_thread_index()]
+        .get();
+  }
+
+  /**
+   * Classes that deal with strings, interfacing Pythia. There is one object
+   * per ensemble thread.
+   */
+  std::vector<std::unique_ptr<StringProcess>> string_process_interfaces_;
   /// Do all collisions isotropically.
   const bool isotropic_;
   /**
@@ -330,6 +391,17 @@ class ScatterActionsFinder : public ActionFinderInterface {
   const double box_length_;
   /// Parameter for formation time
   const double string_formation_time_;
+  /**
+   * Upper bounds of the total cross sections, to reject pairs which are too
+   * far apart without building all collision channels.
+   */
+  CrossSectionBounds cross_section_bounds_;
+
+  /**
+   * Upper bounds of the multi-particle reaction rates, to reject
+   * combinations of particles without building their reactions.
+   */
+  MultiParticleRateBounds multi_particle_rate_bounds_;
 };
 
 /**
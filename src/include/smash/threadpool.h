@@ -0,0 +1,118 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_THREADPOOL_H_
+#define SRC_INCLUDE_SMASH_THREADPOOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * A minimal pool of persistent worker threads.
+ *
+ * The pool is built for the independent pieces of work that SMASH can run
+ * concurrently, e.g. the evolution of several ensembles within one timestep.
+ * In contrast to a work-stealing scheduler, the tasks are distributed
+ * statically: task \c i always runs on the worker with index
+ * \c i % \c size(), and the tasks of one worker are run in increasing order.
+ * Any thread local state (random number engines, PYTHIA objects, adaptive
+ * sampling maxima) thus sees the same sequence of tasks in every run, which is
+ * what makes a threaded simulation reproducible for a fixed seed and number of
+ * threads.
+ *
+ * The calling thread takes part in the work as worker 0, so a pool of size 1
+ * does not start any thread and simply runs all tasks in order.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Start the worker threads.
+   *
+   * \param[in] n_threads Total number of threads working on a parallel_for,
+   *                      including the calling thread.
+   * \throw std::invalid_argument if n_threads is smaller than 1
+   */
+  explicit ThreadPool(int n_threads);
+
+  /// Stop and join all worker threads.
+  ~ThreadPool();
+
+  /// Cannot be copied
+  ThreadPool(const ThreadPool &) = delete;
+  /// Cannot be copied
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// \return the number of threads working on a parallel_for
+  int size() const { return n_threads_; }
+
+  /**
+   * Run task(0), ..., task(n_tasks - 1) on the pool and wait for all of them.
+   *
+   * If tasks throw, all remaining tasks are still run and the exception of the
+   * task with the lowest index is rethrown in the calling thread afterwards.
+   * parallel_for must not be called from inside a task.
+   *
+   * \param[in] n_tasks Number of tasks
+   * \param[in] task Function taking the task index
+   */
+  void parallel_for(int n_tasks, const std::function<void(int)> &task);
+
+  /**
+   * \return the index of the pool worker executing the current task, or 0 if
+   *         called outside of a parallel_for.
+   */
+  static int current_thread_index();
+
+ private:
+  /**
+   * Run all tasks assigned to the given worker.
+   *
+   * \param[in] worker Index of the worker
+   */
+  void run_tasks_of(int worker);
+
+  /// Main loop of the worker threads 1, ..., n_threads_ - 1.
+  void worker_loop(int worker);
+
+  /// Number of threads including the calling thread
+  const int n_threads_;
+  /// The started worker threads
+  std::vector<std::thread> workers_;
+  /// Protects all members below
+  std::mutex mutex_;
+  /// Signals the workers that a new parallel_for started or the pool stops
+  std::condition_variable work_available_;
+  /// Signals the calling thread that a worker is done
+  std::condition_variable work_done_;
+  /// Counts the parallel_for calls, such that workers detect new work
+  uint64_t generation_ = 0;
+  /// Number of workers still busy with the current parallel_for
+  int busy_workers_ = 0;
+  /// Whether the pool is being destroyed
+  bool stop_ = false;
+  /// Number of tasks of the current parallel_for
+  int n_tasks_ = 0;
+  /// Task of the current parallel_for
+  const std::function<void(int)> *task_ = nullptr;
+  /// Exceptions thrown by the tasks of the current parallel_for
+  std::vector<std::exception_ptr> errors_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_THREADPOOL_H_
@@ -303,6 +303,23 @@ void IsoParticleType::tabulate_integrals(
   if (rho && h1) {
     cache_integral(rhoR_tabulations, dir, hash, *rho, *h1, nullptr, true);
   }
+
+  /* Resolve the cached tabulation pointers right away, so that the get_integral
+   * functions do not write to the multiplets when several threads use them. */
+  const auto find_tabulation =
+      [](std::unordered_map<std::string, Tabulation> &tabulations,
+         const std::string &name) -> Tabulation * {
+    const auto found = tabulations.find(name);
+    return found == tabulations.end() ? nullptr : &found->second;
+  };
+  for (IsoParticleType &multiplet : iso_type_list) {
+    const std::string &name = multiplet.name();
+    multiplet.XS_NR_tabulation_ = find_tabulation(NR_tabulations, name);
+    multiplet.XS_piR_tabulation_ = find_tabulation(piR_tabulations, name);
+    multiplet.XS_RK_tabulation_ = find_tabulation(RK_tabulations, name);
+    multiplet.XS_DeltaR_tabulation_ = find_tabulation(DeltaR_tabulations, name);
+    multiplet.XS_rhoR_tabulation_ = find_tabulation(rhoR_tabulations, name);
+  }
 }
 
 double IsoParticleType::get_integral_NR(double sqrts) {
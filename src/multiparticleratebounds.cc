@@ -0,0 +1,161 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/multiparticleratebounds.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "smash/constants.h"
+#include "smash/particletype.h"
+#include "smash/random.h"
+
+namespace smash {
+
+MultiParticleRateBounds::MultiParticleRateBounds(RateFunction rate)
+    : rate_(std::move(rate)), slots_(new Slot[n_slots]) {}
+
+MultiParticleRateBounds::~MultiParticleRateBounds() {
+  for (std::size_t i = 0; i < n_slots; i++) {
+    delete[] slots_[i].bins.load(std::memory_order_relaxed);
+  }
+}
+
+MultiParticleRateBounds::Slot *MultiParticleRateBounds::find_slot(
+    std::uint64_t key) const {
+  // Fibonacci hashing spreads the packed indices over the table.
+  const auto start = static_cast<std::size_t>(
+      (key * std::uint64_t{0x9E3779B97F4A7C15}) >> (64 - slot_bits));
+  for (std::size_t probe = 0; probe < n_slots; probe++) {
+    Slot &slot = slots_[(start + probe) & (n_slots - 1)];
+    std::uint64_t stored = slot.key.load(std::memory_order_acquire);
+    if (stored == 0 &&
+        slot.key.compare_exchange_strong(stored, key,
+                                         std::memory_order_acq_rel)) {
+      return &slot;
+    }
+    // Also the key another thread has just put into the slot
+    if (stored == key) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+double MultiParticleRateBounds::upper_bound(
+    const std::vector<const ParticleData *> &incoming) const {
+  constexpr double no_bound = std::numeric_limits<double>::infinity();
+  const std::size_t n = incoming.size();
+  if (n > max_particles) {
+    return no_bound;
+  }
+  std::array<ParticleTypePtr, max_particles> types;
+  FourVector total_momentum;
+  double threshold = 0.;
+  for (std::size_t i = 0; i < n; i++) {
+    types[i] = &incoming[i]->type();
+    total_momentum += incoming[i]->momentum();
+    threshold += types[i]->mass();
+  }
+  const double sqrts_above_threshold = total_momentum.abs() - threshold;
+  if (!(sqrts_above_threshold >= 0.)) {
+    return no_bound;
+  }
+  const auto bin = static_cast<std::size_t>(sqrts_above_threshold / bin_width);
+  if (bin >= n_bins) {
+    return no_bound;
+  }
+
+  std::sort(types.begin(), types.begin() + n,
+            [](ParticleTypePtr a, ParticleTypePtr b) {
+              return a->pdgcode() < b->pdgcode();
+            });
+  const ParticleType *first_type = ParticleType::list_all().data();
+  std::uint64_t key = 0;
+  for (std::size_t i = 0; i < n; i++) {
+    const auto index =
+        static_cast<std::uint64_t>(std::addressof(*types[i]) - first_type) + 1;
+    if (index >= (std::uint64_t{1} << bits_per_type)) {
+      return no_bound;
+    }
+    key |= index << (bits_per_type * i);
+  }
+
+  Slot *slot = find_slot(key);
+  if (!slot) {
+    return no_bound;
+  }
+  std::atomic<double> *bins = slot->bins.load(std::memory_order_acquire);
+  if (!bins) {
+    std::unique_ptr<std::atomic<double>[]> new_bins(
+        new std::atomic<double>[n_bins]);
+    for (std::size_t i = 0; i < n_bins; i++) {
+      new_bins[i].store(-1., std::memory_order_relaxed);
+    }
+    // Another thread may have been faster, then its bins are used.
+    if (slot->bins.compare_exchange_strong(bins, new_bins.get(),
+                                           std::memory_order_acq_rel)) {
+      bins = new_bins.release();
+    }
+  }
+  double bound = bins[bin].load(std::memory_order_relaxed);
+  if (bound < 0.) {
+    /* Threads evaluating the same bin at the same time store the same value,
+     * since the evaluation does not depend on anything else. */
+    ParticleTypePtrList type_list;
+    type_list.reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+      type_list.push_back(types[i]);
+    }
+    bound = evaluate_bin(type_list, threshold, threshold + bin * bin_width);
+    bins[bin].store(bound, std::memory_order_relaxed);
+  }
+  return bound;
+}
+
+double MultiParticleRateBounds::evaluate_bin(const ParticleTypePtrList &types,
+                                             double threshold,
+                                             double sqrts_min) const {
+  /* The rates must not take random numbers from the simulation, otherwise
+   * its outcome would depend on which bins are evaluated first. */
+  random::Stream stream;
+  random::StreamScope stream_scope(stream);
+  // Exactly at the threshold the phase space of the particles vanishes.
+  const double sqrts_first = std::max(sqrts_min, threshold + really_small);
+  const double sqrts_max = sqrts_min + bin_width;
+  std::vector<double> sample_points;
+  sample_points.reserve(n_samples + 1);
+  for (int i = 0; i <= n_samples; i++) {
+    sample_points.push_back(
+        std::max(sqrts_min + i * bin_width / n_samples, sqrts_first));
+  }
+  /* Resonances formed by the particles peak at their pole mass, which can be
+   * much narrower than the distance between two samples. */
+  for (const ParticleType &resonance : ParticleType::list_all()) {
+    if (resonance.mass() > sqrts_first && resonance.mass() < sqrts_max) {
+      sample_points.push_back(resonance.mass());
+    }
+  }
+  double max_rate = 0.;
+  for (const double sqrts : sample_points) {
+    const double rate = rate_(types, sqrts);
+    if (!(rate <= max_rate)) {
+      // Also catches NaN, which makes the bound infinite.
+      max_rate =
+          std::isnan(rate) ? std::numeric_limits<double>::infinity() : rate;
+    }
+  }
+  return safety_factor * max_rate;
+}
+
+}  // namespace smash
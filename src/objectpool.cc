@@ -0,0 +1,298 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/objectpool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace smash {
+
+namespace {
+
+/// Granularity of the block sizes, which is also the alignment of the blocks
+constexpr std::size_t block_alignment = 16;
+static_assert(block_alignment >= alignof(std::max_align_t),
+              "Pool blocks must be aligned for any object.");
+
+/// Number of different block sizes
+constexpr std::size_t n_block_sizes =
+    PoolAllocated::max_block_size / block_alignment;
+
+/**
+ * Size of the chunks in which memory is taken from the heap. The chunks are
+ * aligned to their size, such that the chunk of a block is found by
+ * rounding down its address.
+ */
+constexpr std::size_t chunk_size = 64 * 1024;
+static_assert((chunk_size & (chunk_size - 1)) == 0,
+              "The chunk size must be a power of two.");
+
+/// Bytes at the beginning of a chunk which hold its header
+constexpr std::size_t chunk_header_size = block_alignment;
+
+/// A free block, which stores the pointer to the next free block of its size
+struct FreeBlock {
+  /// Next free block of the same size, or nullptr
+  FreeBlock *next;
+};
+
+/**
+ * The free blocks of one thread and the blocks which other threads returned
+ * to it. Every chunk belongs to the Owner that took it from the heap, and its
+ * blocks always go back to that Owner.
+ */
+struct Owner {
+  Owner() {
+    for (std::atomic<FreeBlock *> &list : returned) {
+      list.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  /// Free blocks of each size, only used by the thread of the owner
+  FreeBlock *free_blocks[n_block_sizes] = {};
+
+  /**
+   * Blocks of each size freed by other threads. They push onto these stacks
+   * and the thread of the owner takes them all at once when its own list is
+   * empty, so no lock is needed.
+   */
+  std::atomic<FreeBlock *> returned[n_block_sizes];
+};
+static_assert(sizeof(Owner *) <= chunk_header_size,
+              "The owner has to fit into the chunk header.");
+
+/**
+ * Guards the global lists of the pool, which are never destroyed, so that
+ * objects can still be deleted while static objects are destroyed and the
+ * chunks stay reachable (and are not reported as leaks).
+ */
+std::mutex &pool_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// All chunks taken from the heap
+std::vector<char *> &all_chunks() {
+  static auto *chunks = new std::vector<char *>();
+  return *chunks;
+}
+
+/**
+ * Free blocks of each size left by threads which have finished, to be shared
+ * by the running threads. Guarded by pool_mutex.
+ */
+FreeBlock **spare_blocks() {
+  static auto *blocks = new FreeBlock *[n_block_sizes]();
+  return blocks;
+}
+
+/// Owners of threads which have finished, to be taken over by new threads
+std::vector<Owner *> &orphaned_owners() {
+  static auto *owners = new std::vector<Owner *>();
+  return *owners;
+}
+
+/**
+ * Owner of the current thread, nullptr until the first allocation. The
+ * pointer has no destructor, see OwnerRelease.
+ */
+thread_local Owner *this_thread_owner = nullptr;
+
+/// Whether the owner of this thread was already released on thread exit
+thread_local bool owner_released = false;
+
+/// Number of objects allocated by this thread, see PoolAllocated::n_allocations
+thread_local std::size_t allocations_of_thread = 0;
+
+/**
+ * Hands the owner of a finishing thread on to the next new thread, such that
+ * the number of owners is bounded by the number of threads running at the
+ * same time, and its free blocks to all threads, see spare_blocks.
+ */
+struct OwnerRelease {
+  ~OwnerRelease() {
+    if (this_thread_owner) {
+      std::lock_guard<std::mutex> lock(pool_mutex());
+      // including the blocks other threads returned to it
+      for (std::size_t i = 0; i < n_block_sizes; i++) {
+        for (FreeBlock *blocks :
+             {this_thread_owner->free_blocks[i],
+              this_thread_owner->returned[i].exchange(
+                  nullptr, std::memory_order_acquire)}) {
+          while (blocks) {
+            FreeBlock *next = blocks->next;
+            blocks->next = spare_blocks()[i];
+            spare_blocks()[i] = blocks;
+            blocks = next;
+          }
+        }
+        this_thread_owner->free_blocks[i] = nullptr;
+      }
+      orphaned_owners().push_back(this_thread_owner);
+    }
+    this_thread_owner = nullptr;
+    owner_released = true;
+  }
+};
+
+/// \return The owner of the current thread, which is created if needed.
+Owner &current_owner() {
+  if (this_thread_owner) {
+    return *this_thread_owner;
+  }
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex());
+    if (orphaned_owners().empty()) {
+      this_thread_owner = new Owner();
+    } else {
+      this_thread_owner = orphaned_owners().back();
+      orphaned_owners().pop_back();
+    }
+  }
+  /* Objects allocated while the thread local objects of a finishing thread
+   * are destroyed keep their owner for good. */
+  if (!owner_released) {
+    thread_local OwnerRelease release;
+    static_cast<void>(release);
+  }
+  return *this_thread_owner;
+}
+
+/**
+ * \param[in] p A block of the pool
+ * \return The owner of the chunk the block is in.
+ */
+Owner *owner_of(void *p) {
+  const std::uintptr_t chunk =
+      reinterpret_cast<std::uintptr_t>(p) & ~(chunk_size - 1);
+  return *reinterpret_cast<Owner **>(chunk);
+}
+
+/**
+ * Take at most a chunk worth of the free blocks of one size left by threads
+ * which have finished. The blocks still go back to the owner of their chunk
+ * when they are freed.
+ *
+ * \param[in] i Index of the block size, the blocks have
+ *              (i + 1) * block_alignment bytes
+ * \return List of free blocks, nullptr if there are none.
+ */
+FreeBlock *take_spare_blocks(std::size_t i) {
+  const std::size_t blocks_per_chunk =
+      (chunk_size - chunk_header_size) / ((i + 1) * block_alignment);
+  std::lock_guard<std::mutex> lock(pool_mutex());
+  FreeBlock *head = spare_blocks()[i];
+  if (!head) {
+    return nullptr;
+  }
+  FreeBlock *last = head;
+  for (std::size_t n = 1; n < blocks_per_chunk && last->next; n++) {
+    last = last->next;
+  }
+  spare_blocks()[i] = last->next;
+  last->next = nullptr;
+  return head;
+}
+
+/**
+ * Fill a free list of the owner from a new chunk.
+ *
+ * \param[in] owner The owner of the new chunk
+ * \param[in] i Index of the block size, the blocks have
+ *              (i + 1) * block_alignment bytes
+ */
+void refill(Owner &owner, std::size_t i) {
+  const std::size_t block_size = (i + 1) * block_alignment;
+  char *chunk = static_cast<char *>(
+      ::operator new(chunk_size, std::align_val_t(chunk_size)));
+  *reinterpret_cast<Owner **>(chunk) = &owner;
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex());
+    all_chunks().push_back(chunk);
+  }
+  FreeBlock *head = owner.free_blocks[i];
+  for (std::size_t offset = chunk_header_size;
+       offset + block_size <= chunk_size; offset += block_size) {
+    FreeBlock *block = reinterpret_cast<FreeBlock *>(chunk + offset);
+    block->next = head;
+    head = block;
+  }
+  owner.free_blocks[i] = head;
+}
+
+/**
+ * \param[in] size Size of the object in bytes, at least 1 and at most
+ *                 PoolAllocated::max_block_size
+ * \return Index of the smallest block size that fits the object.
+ */
+std::size_t block_index(std::size_t size) {
+  return (size - 1) / block_alignment;
+}
+
+}  // unnamed namespace
+
+void *PoolAllocated::operator new(std::size_t size) {
+  allocations_of_thread++;
+  if (size == 0 || size > max_block_size) {
+    return ::operator new(size);
+  }
+  const std::size_t i = block_index(size);
+  Owner &owner = current_owner();
+  FreeBlock *&head = owner.free_blocks[i];
+  if (!head) {
+    // Take back the blocks freed by other threads, before using new memory.
+    head = owner.returned[i].exchange(nullptr, std::memory_order_acquire);
+  }
+  if (!head) {
+    head = take_spare_blocks(i);
+  }
+  if (!head) {
+    refill(owner, i);
+  }
+  FreeBlock *block = head;
+  head = block->next;
+  return block;
+}
+
+void PoolAllocated::operator delete(void *p, std::size_t size) noexcept {
+  if (!p) {
+    return;
+  }
+  if (size == 0 || size > max_block_size) {
+    ::operator delete(p);
+    return;
+  }
+  const std::size_t i = block_index(size);
+  FreeBlock *block = static_cast<FreeBlock *>(p);
+  Owner *owner = owner_of(p);
+  if (owner == this_thread_owner) {
+    block->next = owner->free_blocks[i];
+    owner->free_blocks[i] = block;
+    return;
+  }
+  std::atomic<FreeBlock *> &returned = owner->returned[i];
+  block->next = returned.load(std::memory_order_relaxed);
+  while (!returned.compare_exchange_weak(block->next, block,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+  }
+}
+
+std::size_t PoolAllocated::n_allocations() { return allocations_of_thread; }
+
+std::size_t PoolAllocated::n_chunks() {
+  std::lock_guard<std::mutex> lock(pool_mutex());
+  return all_chunks().size();
+}
+
+}  // namespace smash
@@ -9,8 +9,14 @@
 
 #include "smash/oscaroutput.h"
 
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
 #include "smash/action.h"
 #include "smash/clock.h"
@@ -20,6 +26,135 @@
 namespace smash {
 static constexpr int LHyperSurfaceCrossing = LogArea::HyperSurfaceCrossing::id;
 
+namespace {
+/*
+ * The lines of the ASCII outputs are formatted with std::to_chars instead of
+ * std::fprintf. The numbers are the same as those of the printf conversions
+ * named below in the "C" locale, but the format strings do not need to be
+ * parsed for every particle, and the locale is not consulted. Standard
+ * libraries without std::to_chars for floating-point numbers fall back to
+ * std::snprintf.
+ */
+
+/// A number to be formatted like printf's %<width>.<precision>g
+struct General {
+  /// The number
+  double value;
+  /// Number of significant digits
+  int precision = 6;
+  /// Minimal number of characters, padded with spaces on the left
+  std::size_t width = 0;
+};
+
+/// A number to be formatted like printf's %<width>.<precision>f
+struct Fixed {
+  /// The number
+  double value;
+  /// Number of digits after the decimal point
+  int precision;
+  /// Minimal number of characters, padded with spaces on the left
+  std::size_t width;
+};
+
+/// An integer to be formatted like printf's %<width>i
+struct Padded {
+  /// The integer
+  int value;
+  /// Minimal number of characters, padded with spaces on the left
+  std::size_t width;
+};
+
+/**
+ * Append characters to a line, padded on the left up to a width.
+ *
+ * \param[inout] line Line to append to
+ * \param[in] first First character
+ * \param[in] last Past the last character
+ * \param[in] width Minimal number of characters
+ */
+void append_padded(std::string &line, const char *first, const char *last,
+                   std::size_t width) {
+  const std::size_t length = last - first;
+  if (length < width) {
+    line.append(width - length, ' ');
+  }
+  line.append(first, last);
+}
+
+/// Append a double to a line, see General and Fixed.
+void append_double(std::string &line, double value, bool fixed, int precision,
+                   std::size_t width) {
+  // Large enough for any double in fixed notation with up to 9 decimals
+  char digits[512];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  const std::to_chars_result result = std::to_chars(
+      digits, digits + sizeof(digits), value,
+      fixed ? std::chars_format::fixed : std::chars_format::general,
+      precision);
+  if (result.ec != std::errc()) {
+    throw std::runtime_error("Could not format a number for ASCII output.");
+  }
+  const char *end = result.ptr;
+#else
+  const int length =
+      fixed ? std::snprintf(digits, sizeof(digits), "%.*f", precision, value)
+            : std::snprintf(digits, sizeof(digits), "%.*g", precision, value);
+  if (length < 0 || static_cast<std::size_t>(length) >= sizeof(digits)) {
+    throw std::runtime_error("Could not format a number for ASCII output.");
+  }
+  const char *end = digits + length;
+#endif
+  append_padded(line, digits, end, width);
+}
+
+/// Append a number like printf's %g with precision and width.
+void append_one(std::string &line, const General &number) {
+  append_double(line, number.value, false, number.precision, number.width);
+}
+
+/// Append a number like printf's %f with precision and width.
+void append_one(std::string &line, const Fixed &number) {
+  append_double(line, number.value, true, number.precision, number.width);
+}
+
+/// Append an integer like printf's %i with width.
+void append_one(std::string &line, const Padded &number) {
+  char digits[16];
+  append_padded(line, digits,
+                std::to_chars(digits, digits + sizeof(digits), number.value)
+                    .ptr,
+                number.width);
+}
+
+/// Append an integer like printf's %i or %zu.
+template <typename T,
+          typename = std::enable_if_t<std::is_integral_v<T> &&
+                                      !std::is_same_v<T, char> &&
+                                      !std::is_same_v<T, bool>>>
+void append_one(std::string &line, T number) {
+  char digits[24];
+  line.append(digits,
+              std::to_chars(digits, digits + sizeof(digits), number).ptr);
+}
+
+/// Append a character.
+void append_one(std::string &line, char c) { line += c; }
+
+/// Append a string.
+void append_one(std::string &line, const char *text) { line += text; }
+
+/**
+ * Append the formatted pieces of a line to a buffer.
+ *
+ * \param[inout] buffer Buffer to append to
+ * \param[in] pieces Text, characters, integers, General, Fixed or Padded
+ */
+template <typename... Pieces>
+void append(std::string &buffer, const Pieces &...pieces) {
+  (append_one(buffer, pieces), ...);
+}
+}  // unnamed namespace
+
 template <OscarOutputFormat Format, int Contents>
 OscarOutput<Format, Contents>::OscarOutput(const std::filesystem::path &path,
                                            const std::string &name)
@@ -114,6 +249,15 @@ OscarOutput<Format, Contents>::OscarOutput(const std::filesystem::path &path,
   }
 }
 
+template <OscarOutputFormat Format, int Contents>
+OscarOutput<Format, Contents>::~OscarOutput() {
+  try {
+    write_buffer(false);
+  } catch (std::exception &e) {
+    logg[LOutput].error("Writing the OSCAR output failed: ", e.what());
+  }
+}
+
 template <OscarOutputFormat Format, int Contents>
 inline void OscarOutput<Format, Contents>::write(const Particles &particles) {
   for (const ParticleData &data : particles) {
@@ -121,6 +265,19 @@ inline void OscarOutput<Format, Contents>::write(const Particles &particles) {
   }
 }
 
+template <OscarOutputFormat Format, int Contents>
+void OscarOutput<Format, Contents>::write_buffer(bool only_if_full) {
+  if (buffer_.empty() || (only_if_full && buffer_.size() < max_buffer_size)) {
+    return;
+  }
+  if (std::fwrite(buffer_.data(), 1, buffer_.size(), file_.get()) !=
+      buffer_.size()) {
+    throw std::runtime_error(std::string("Could not write OSCAR output: ") +
+                             std::strerror(errno));
+  }
+  buffer_.clear();
+}
+
 template <OscarOutputFormat Format, int Contents>
 void OscarOutput<Format, Contents>::at_eventstart(const Particles &particles,
                                                   const int event_number,
@@ -128,21 +285,19 @@ void OscarOutput<Format, Contents>::at_eventstart(const Particles &particles,
   current_event_ = event_number;
   if (Contents & OscarAtEventstart) {
     if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
-      std::fprintf(file_.get(), "# event %i in %zu\n", event_number,
-                   particles.size());
+      append(buffer_, "# event ", event_number, " in ", particles.size(), '\n');
     } else {
       /* OSCAR line prefix : initial particles; final particles; event id
        * First block of an event: initial = 0, final = number of particles
        */
-      const size_t zero = 0;
-      std::fprintf(file_.get(), "%zu %zu %i\n", zero, particles.size(),
-                   event_number);
+      append(buffer_, "0 ", particles.size(), ' ', event_number, '\n');
     }
     if (!(Contents & OscarParticlesIC)) {
       // We do not want the inital particle list to be printed in case of IC
       // output
       write(particles);
     }
+    write_buffer(true);
   }
 }
 
@@ -153,32 +308,30 @@ void OscarOutput<Format, Contents>::at_eventend(const Particles &particles,
   if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
     if (Contents & OscarParticlesAtEventend ||
         (Contents & OscarParticlesAtEventendIfNotEmpty && !event.empty_event)) {
-      std::fprintf(file_.get(), "# event %i out %zu\n", event_number,
-                   particles.size());
+      append(buffer_, "# event ", event_number, " out ", particles.size(),
+             '\n');
       write(particles);
     }
     // Comment end of an event
     const char *empty_event_str = event.empty_event ? "no" : "yes";
-    std::fprintf(
-        file_.get(),
-        "# event %i end 0 impact %7.3f scattering_projectile_target %s\n",
-        event_number, event.impact_parameter, empty_event_str);
+    append(buffer_, "# event ", event_number, " end 0 impact ",
+           Fixed{event.impact_parameter, 3, 7},
+           " scattering_projectile_target ", empty_event_str, '\n');
   } else {
     /* OSCAR line prefix : initial particles; final particles; event id
      * Last block of an event: initial = number of particles, final = 0
      * Block ends with null interaction. */
-    const size_t zero = 0;
     if (Contents & OscarParticlesAtEventend ||
         (Contents & OscarParticlesAtEventendIfNotEmpty && !event.empty_event)) {
-      std::fprintf(file_.get(), "%zu %zu %i\n", particles.size(), zero,
-                   event_number);
+      append(buffer_, particles.size(), " 0 ", event_number, '\n');
       write(particles);
     }
     // Null interaction marks the end of an event
-    std::fprintf(file_.get(), "%zu %zu %i %7.3f\n", zero, zero, event_number,
-                 event.impact_parameter);
+    append(buffer_, "0 0 ", event_number, ' ',
+           Fixed{event.impact_parameter, 3, 7}, '\n');
   }
   // Flush to disk
+  write_buffer(false);
   std::fflush(file_.get());
 
   if (Contents & OscarParticlesIC) {
@@ -198,13 +351,12 @@ void OscarOutput<Format, Contents>::at_interaction(const Action &action,
                                                    const double density) {
   if (Contents & OscarInteractions) {
     if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
-      std::fprintf(file_.get(),
-                   "# interaction in %zu out %zu rho %12.7f weight %12.7g"
-                   " partial %12.7f type %5i\n",
-                   action.incoming_particles().size(),
-                   action.outgoing_particles().size(), density,
-                   action.get_total_weight(), action.get_partial_weight(),
-                   static_cast<int>(action.get_type()));
+      append(buffer_, "# interaction in ", action.incoming_particles().size(),
+             " out ", action.outgoing_particles().size(), " rho ",
+             Fixed{density, 7, 12}, " weight ",
+             General{action.get_total_weight(), 7, 12}, " partial ",
+             Fixed{action.get_partial_weight(), 7, 12}, " type ",
+             Padded{static_cast<int>(action.get_type()), 5}, '\n');
     } else {
       /* OSCAR line prefix : initial final
        * particle creation: 0 1
@@ -212,11 +364,11 @@ void OscarOutput<Format, Contents>::at_interaction(const Action &action,
        * resonance formation: 2 1
        * resonance decay: 1 2
        * etc.*/
-      std::fprintf(file_.get(), "%zu %zu %12.7f %12.7f %12.7f %5i\n",
-                   action.incoming_particles().size(),
-                   action.outgoing_particles().size(), density,
-                   action.get_total_weight(), action.get_partial_weight(),
-                   static_cast<int>(action.get_type()));
+      append(buffer_, action.incoming_particles().size(), ' ',
+             action.outgoing_particles().size(), ' ', Fixed{density, 7, 12},
+             ' ', Fixed{action.get_total_weight(), 7, 12}, ' ',
+             Fixed{action.get_partial_weight(), 7, 12}, ' ',
+             Padded{static_cast<int>(action.get_type()), 5}, '\n');
     }
     for (const auto &p : action.incoming_particles()) {
       write_particledata(p);
@@ -229,6 +381,7 @@ void OscarOutput<Format, Contents>::at_interaction(const Action &action,
       write_particledata(p);
     }
   }
+  write_buffer(true);
 }
 
 template <OscarOutputFormat Format, int Contents>
@@ -237,14 +390,13 @@ void OscarOutput<Format, Contents>::at_intermediate_time(
     const DensityParameters &, const EventInfo &) {
   if (Contents & OscarTimesteps) {
     if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
-      std::fprintf(file_.get(), "# event %i out %zu\n", current_event_,
-                   particles.size());
+      append(buffer_, "# event ", current_event_, " out ", particles.size(),
+             '\n');
     } else {
-      const size_t zero = 0;
-      std::fprintf(file_.get(), "%zu %zu %i\n", particles.size(), zero,
-                   current_event_);
+      append(buffer_, particles.size(), " 0 ", current_event_, '\n');
     }
     write(particles);
+    write_buffer(true);
   }
 }
 
@@ -746,30 +898,33 @@ void OscarOutput<Format, Contents>::write_particledata(
     const ParticleData &data) {
   const FourVector pos = data.position();
   const FourVector mom = data.momentum();
+  // The same as "%g %g %g %g %g %.9g %.9g %.9g %.9g %s %i %i"
+  if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
+    append(buffer_, General{pos.x0()}, ' ', General{pos.x1()}, ' ',
+           General{pos.x2()}, ' ', General{pos.x3()}, ' ',
+           General{data.effective_mass()}, ' ', General{mom.x0(), 9}, ' ',
+           General{mom.x1(), 9}, ' ', General{mom.x2(), 9}, ' ',
+           General{mom.x3(), 9}, ' ', data.pdgcode().get_decimal(), ' ',
+           data.id(), ' ', data.type().charge());
+  }
   if (Format == OscarFormat2013) {
-    std::fprintf(file_.get(), "%g %g %g %g %g %.9g %.9g %.9g %.9g %s %i %i\n",
-                 pos.x0(), pos.x1(), pos.x2(), pos.x3(), data.effective_mass(),
-                 mom.x0(), mom.x1(), mom.x2(), mom.x3(),
-                 data.pdgcode().string().c_str(), data.id(),
-                 data.type().charge());
+    buffer_ += '\n';
   } else if (Format == OscarFormat2013Extended) {
+    // The same as " %i %g %g %i %i %g %s %s %i\n"
     const auto h = data.get_history();
-    std::fprintf(file_.get(),
-                 "%g %g %g %g %g %.9g %.9g %.9g"
-                 " %.9g %s %i %i %i %g %g %i %i %g %s %s %i\n",
-                 pos.x0(), pos.x1(), pos.x2(), pos.x3(), data.effective_mass(),
-                 mom.x0(), mom.x1(), mom.x2(), mom.x3(),
-                 data.pdgcode().string().c_str(), data.id(),
-                 data.type().charge(), h.collisions_per_particle,
-                 data.formation_time(), data.xsec_scaling_factor(),
-                 h.id_process, static_cast<int>(h.process_type),
-                 h.time_last_collision, h.p1.string().c_str(),
-                 h.p2.string().c_str(), data.type().baryon_number());
+    append(buffer_, ' ', h.collisions_per_particle, ' ',
+           General{data.formation_time()}, ' ',
+           General{data.xsec_scaling_factor()}, ' ', h.id_process, ' ',
+           static_cast<int>(h.process_type), ' ',
+           General{h.time_last_collision}, ' ', h.p1.get_decimal(), ' ',
+           h.p2.get_decimal(), ' ', data.type().baryon_number(), '\n');
   } else {
-    std::fprintf(file_.get(), "%i %s %i %g %g %g %g %g %g %g %g %g\n",
-                 data.id(), data.pdgcode().string().c_str(), 0, mom.x1(),
-                 mom.x2(), mom.x3(), mom.x0(), data.effective_mass(), pos.x1(),
-                 pos.x2(), pos.x3(), pos.x0());
+    // The same as "%i %s %i %g %g %g %g %g %g %g %g %g\n"
+    append(buffer_, data.id(), ' ', data.pdgcode().get_decimal(), " 0 ",
+           General{mom.x1()}, ' ', General{mom.x2()}, ' ', General{mom.x3()},
+           ' ', General{mom.x0()}, ' ', General{data.effective_mass()}, ' ',
+           General{pos.x1()}, ' ', General{pos.x2()}, ' ', General{pos.x3()},
+           ' ', General{pos.x0()}, '\n');
   }
 }
 
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2013-2015,2017-2018
+ *    Copyright (c) 2013-2015,2017-2018,2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -47,6 +47,17 @@ inline void Particles::copy_in(ParticleData &to, const ParticleData &from) {
   from.copy_to(to);
 }
 
+void Particles::copy_from(const Particles &other) {
+  reset();
+  ensure_capacity(other.data_size_);
+  for (unsigned i = 0; i < other.data_size_; ++i) {
+    data_[i] = other.data_[i];
+  }
+  data_size_ = other.data_size_;
+  dirty_ = other.dirty_;
+  id_max_ = other.id_max_;
+}
+
 const ParticleData &Particles::insert(const ParticleData &p) {
   if (likely(dirty_.empty())) {
     ensure_capacity(1);
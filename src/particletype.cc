@@ -26,6 +26,7 @@
 #include "smash/logging.h"
 #include "smash/potential_globals.h"
 #include "smash/stringfunctions.h"
+#include "smash/tabulation.h"
 
 namespace smash {
 static constexpr int LParticleType = LogArea::ParticleType::id;
@@ -46,6 +47,32 @@ ParticleTypePtrList anti_deltas_list;
 ParticleTypePtrList baryon_resonances_list;
 /// Global pointer to the Particle Type list of light nuclei
 ParticleTypePtrList light_nuclei_list;
+
+/**
+ * Maximum factors for single-res mass sampling, cf. sample_resonance_mass,
+ * one per particle type.
+ *
+ * The factors are adapted during the sampling. They are kept per thread, so
+ * that the sampling neither races nor depends on the order in which the
+ * threads happen to sample, and are reset at the beginning of every event,
+ * cf. ParticleType::reset_max_factors.
+ */
+thread_local std::vector<double> max_factors1;
+/// Maximum factors for double-res mass sampling, cf. sample_resonance_masses.
+thread_local std::vector<double> max_factors2;
+
+/**
+ * \param[in] factors Per-thread maximum factors
+ * \param[in] type Particle type whose factor is looked up
+ * \return Reference to the maximum factor of the given type (initialized to 1)
+ */
+double &max_factor_of(std::vector<double> &factors, const ParticleType &type) {
+  const auto &types = ParticleType::list_all();
+  if (factors.size() != types.size()) {
+    factors.assign(types.size(), 1.);
+  }
+  return factors[std::addressof(type) - std::addressof(types[0])];
+}
 }  // unnamed namespace
 
 const ParticleTypeList &ParticleType::list_all() {
@@ -452,6 +479,22 @@ double ParticleType::total_width(const double m) const {
   return w;
 }
 
+void ParticleType::precompute_lazy_properties() {
+  for (const ParticleType &ptype : ParticleType::list_all()) {
+    ptype.isospin();
+    ptype.min_mass_spectral();
+    if (ptype.is_stable()) {
+      continue;
+    }
+    ptype.spectral_function(ptype.mass());
+    for (const auto &mode : ptype.decay_modes().decay_mode_list()) {
+      // Evaluating the width at the pole fills the tabulations of the decay.
+      mode->type().width(ptype.mass(), ptype.width_at_pole() * mode->weight(),
+                         std::max(ptype.mass(), mode->threshold()));
+    }
+  }
+}
+
 void ParticleType::check_consistency() {
   for (const ParticleType &ptype : ParticleType::list_all()) {
     if (!ptype.is_stable() && ptype.decay_modes().is_empty()) {
@@ -486,13 +529,16 @@ bool ParticleType::wanted_decaymode(const DecayType &t,
   }
 }
 
-DecayBranchList ParticleType::get_partial_widths(const FourVector p,
-                                                 const ThreeVector x,
-                                                 WhichDecaymodes wh) const {
-  const auto &decay_mode_list = decay_modes().decay_mode_list();
-  /* Determine whether the decay is affected by the potentials. If it's
-   * affected, read the values of the potentials at the position of the
-   * particle */
+namespace {
+
+/**
+ * Read the potentials at the position of a decaying particle, which shift the
+ * square root of s of the final state of its decays.
+ *
+ * \param[in] x position of the decaying particle
+ * \return Baryon and isospin potential at x, zero without potentials.
+ */
+std::pair<FourVector, FourVector> potentials_at(const ThreeVector &x) {
   FourVector UB = FourVector();
   FourVector UI3 = FourVector();
   if (UB_lat_pointer != nullptr) {
@@ -501,24 +547,64 @@ DecayBranchList ParticleType::get_partial_widths(const FourVector p,
   if (UI3_lat_pointer != nullptr) {
     UI3_lat_pointer->value_at(x, UI3);
   }
+  return {UB, UI3};
+}
+
+/**
+ * Calculate the square root of s of the final state of a decay, which differs
+ * from the mass of the decaying particle if the potentials act differently on
+ * the final state.
+ *
+ * \param[in] mother type of the decaying particle
+ * \param[in] mode decay mode
+ * \param[in] p 4-momentum of the decaying particle
+ * \param[in] potentials baryon and isospin potential at the decay
+ * \return Square root of s of the final state.
+ */
+double final_state_sqrt_s(const ParticleType &mother, const DecayType &mode,
+                          const FourVector &p,
+                          const std::pair<FourVector, FourVector> &potentials) {
+  double scale_B = 0.0;
+  double scale_I3 = 0.0;
+  if (pot_pointer != nullptr) {
+    scale_B += pot_pointer->force_scale(mother).first;
+    scale_I3 += pot_pointer->force_scale(mother).second * mother.isospin3_rel();
+    for (const auto &finaltype : mode.particle_types()) {
+      scale_B -= pot_pointer->force_scale(*finaltype).first;
+      scale_I3 -= pot_pointer->force_scale(*finaltype).second *
+                  finaltype->isospin3_rel();
+    }
+  }
+  return (p + potentials.first * scale_B + potentials.second * scale_I3).abs();
+}
+
+}  // namespace
+
+/// Number of intervals of the mass grid of the decay width tables
+constexpr size_t num_width_tab_intervals = 500;
+
+struct ParticleType::DecayWidthTables {
+  /// Partial widths of the decay modes, in the order of the decay modes
+  std::vector<Tabulation> partial;
+  /// Upper end of the mass grid, which is the same for all tables
+  double max_mass;
+};
+
+DecayBranchList ParticleType::get_partial_widths(const FourVector p,
+                                                 const ThreeVector x,
+                                                 WhichDecaymodes wh) const {
+  const auto &decay_mode_list = decay_modes().decay_mode_list();
+  /* Determine whether the decay is affected by the potentials. If it's
+   * affected, read the values of the potentials at the position of the
+   * particle */
+  const auto potentials = potentials_at(x);
   /* Loop over decay modes and calculate all partial widths. */
   DecayBranchList partial;
   partial.reserve(decay_mode_list.size());
   for (unsigned int i = 0; i < decay_mode_list.size(); i++) {
     /* Calculate the sqare root s of the final state particles. */
-    const auto FinalTypes = decay_mode_list[i]->type().particle_types();
-    double scale_B = 0.0;
-    double scale_I3 = 0.0;
-    if (pot_pointer != nullptr) {
-      scale_B += pot_pointer->force_scale(*this).first;
-      scale_I3 += pot_pointer->force_scale(*this).second * isospin3_rel();
-      for (const auto &finaltype : FinalTypes) {
-        scale_B -= pot_pointer->force_scale(*finaltype).first;
-        scale_I3 -= pot_pointer->force_scale(*finaltype).second *
-                    finaltype->isospin3_rel();
-      }
-    }
-    double sqrt_s = (p + UB * scale_B + UI3 * scale_I3).abs();
+    const double sqrt_s =
+        final_state_sqrt_s(*this, decay_mode_list[i]->type(), p, potentials);
 
     const double w = partial_width(sqrt_s, decay_mode_list[i].get());
     if (w > 0.) {
@@ -531,6 +617,55 @@ DecayBranchList ParticleType::get_partial_widths(const FourVector p,
   return partial;
 }
 
+double ParticleType::get_total_width(const FourVector p, const ThreeVector x,
+                                     WhichDecaymodes wh, bool tabulated) const {
+  const DecayWidthTables *tables =
+      tabulated ? decay_width_tables_.get() : nullptr;
+  const auto &decay_mode_list = decay_modes().decay_mode_list();
+  const auto potentials = potentials_at(x);
+  // Sum up the same partial widths in the same order as get_partial_widths
+  double width = 0.;
+  for (unsigned int i = 0; i < decay_mode_list.size(); i++) {
+    const DecayType &mode = decay_mode_list[i]->type();
+    if (!wanted_decaymode(mode, wh)) {
+      continue;
+    }
+    const double sqrt_s = final_state_sqrt_s(*this, mode, p, potentials);
+    const double w = tables != nullptr && sqrt_s <= tables->max_mass
+                         ? tables->partial[i].get_value_linear(sqrt_s)
+                         : partial_width(sqrt_s, decay_mode_list[i].get());
+    if (w > 0.) {
+      width += w;
+    }
+  }
+  return width;
+}
+
+void ParticleType::tabulate_decay_widths() {
+  for (const ParticleType &ptype : list_all()) {
+    if (ptype.is_stable() || ptype.decay_width_tables_ != nullptr) {
+      continue;
+    }
+    const auto &modes = ptype.decay_modes().decay_mode_list();
+    double max_threshold = 0.;
+    for (const auto &mode : modes) {
+      max_threshold = std::max(max_threshold, mode->threshold());
+    }
+    auto tables = std::make_shared<DecayWidthTables>();
+    // Same interval as for the tabulations of the decay types
+    tables->max_mass =
+        max_threshold + std::max(2., 10. * ptype.width_at_pole());
+    tables->partial.reserve(modes.size());
+    for (const auto &mode : modes) {
+      tables->partial.emplace_back(
+          mode->threshold(), tables->max_mass - mode->threshold(),
+          num_width_tab_intervals,
+          [&](double m) { return ptype.partial_width(m, mode.get()); });
+    }
+    ptype.decay_width_tables_ = std::move(tables);
+  }
+}
+
 double ParticleType::get_partial_width(const double m,
                                        const ParticleTypePtrList dlist) const {
   /* Get all decay modes. */
@@ -570,7 +705,7 @@ double ParticleType::spectral_function(double m) const {
   if (norm_factor_ < 0.) {
     /* Initialize the normalization factor
      * by integrating over the unnormalized spectral function. */
-    static /*thread_local (see #3075)*/ Integrator integrate;
+    static thread_local Integrator integrate;
     const double width = width_at_pole();
     const double m_pole = mass();
     // We transform the integral using m = m_min + width_pole * tan(x), to
@@ -633,10 +768,11 @@ double ParticleType::sample_resonance_mass(const double mass_stable,
       std::max(1., this->spectral_function(max_mass) /
                        this->spectral_function_simple(max_mass));
 
+  double &max_factor = max_factor_of(max_factors1, *this);
   double mass_res, val;
   // outer loop: repeat if maximum is too small
   do {
-    const double q_max = sf_ratio_max * this->max_factor1_;
+    const double q_max = sf_ratio_max * max_factor;
     const double max = blw_max * q_max;  // maximum value for rejection sampling
     // inner loop: rejection sampling
     do {
@@ -656,9 +792,9 @@ double ParticleType::sample_resonance_mass(const double mass_stable,
     if (val > max) {
       logg[LResonances].debug(
           "maximum is being increased in sample_resonance_mass: ",
-          this->max_factor1_, " ", val / max, " ", this->pdgcode(), " ",
-          mass_stable, " ", cms_energy, " ", mass_res);
-      this->max_factor1_ *= val / max;
+          max_factor, " ", val / max, " ", this->pdgcode(), " ", mass_stable,
+          " ", cms_energy, " ", mass_res);
+      max_factor *= val / max;
     } else {
       break;  // maximum ok, exit loop
     }
@@ -682,11 +818,12 @@ std::pair<double, double> ParticleType::sample_resonance_masses(
       pCM(cms_energy, t1.min_mass_spectral(), t2.min_mass_spectral());
   const double blw_max = pcm_max * blatt_weisskopf_sqr(pcm_max, L);
 
+  double &max_factor = max_factor_of(max_factors2, t1);
   double mass_1, mass_2, val;
   // outer loop: repeat if maximum is too small
   do {
     // maximum value for rejection sampling (determined automatically)
-    const double max = blw_max * t1.max_factor2_;
+    const double max = blw_max * max_factor;
     // inner loop: rejection sampling
     do {
       // sample mass from a simple Breit-Wigner (aka Cauchy) distribution
@@ -708,9 +845,9 @@ std::pair<double, double> ParticleType::sample_resonance_masses(
     if (val > max) {
       logg[LResonances].debug(
           "maximum is being increased in sample_resonance_masses: ",
-          t1.max_factor2_, " ", val / max, " ", t1.pdgcode(), " ", t2.pdgcode(),
-          " ", cms_energy, " ", mass_1, " ", mass_2);
-      t1.max_factor2_ *= val / max;
+          max_factor, " ", val / max, " ", t1.pdgcode(), " ", t2.pdgcode(), " ",
+          cms_energy, " ", mass_1, " ", mass_2);
+      max_factor *= val / max;
     } else {
       break;  // maximum ok, exit loop
     }
@@ -719,6 +856,11 @@ std::pair<double, double> ParticleType::sample_resonance_masses(
   return {mass_1, mass_2};
 }
 
+void ParticleType::reset_max_factors() {
+  max_factors1.clear();
+  max_factors2.clear();
+}
+
 void ParticleType::dump_width_and_spectral_function() const {
   if (is_stable()) {
     std::stringstream err;
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2015-2020,2022
+ *    Copyright (c) 2015-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -9,6 +9,10 @@
 
 #include "smash/pauliblocking.h"
 
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
 #include "smash/constants.h"
 #include "smash/logging.h"
 
@@ -48,48 +52,134 @@ double PauliBlocker::phasespace_dens(const ThreeVector &r, const ThreeVector &p,
                                      const ParticleList &disregard) const {
   double f = 0.0;
 
-  /* TODO(oliiny): looping over all particles is inefficient,
-   * I need only particles within rp_ radius in momentum and
-   * within rr_+rc_ in coordinate space. Some search algorithm might help. */
-  for (const Particles &particles : ensembles) {
-    for (const ParticleData &part : particles) {
-      // Only consider identical particles
-      if (part.pdgcode() != pdg) {
-        continue;
-      }
-      // Only consider momenta in sphere of radius rp_ with center at p
-      const double pdist_sqr = (part.momentum().threevec() - p).sqr();
-      if (pdist_sqr > rp_ * rp_) {
-        continue;
-      }
-      const double rdist_sqr = (part.position().threevec() - r).sqr();
-      // Only consider coordinates in sphere of radius rr_+rc_ with center at r
-      if (rdist_sqr >= (rr_ + rc_) * (rr_ + rc_)) {
-        continue;
-      }
-      // Do not count particles that should be disregarded.
-      bool to_disregard = false;
-      for (const auto &disregard_part : disregard) {
-        if (part.id() == disregard_part.id()) {
-          to_disregard = true;
+  std::unordered_set<int> disregard_ids;
+  for (const ParticleData &disregard_part : disregard) {
+    disregard_ids.insert(disregard_part.id());
+  }
+  auto &&add_to_density = [&](const ParticleData &part) {
+    // Only consider identical particles
+    if (part.pdgcode() != pdg) {
+      return;
+    }
+    // Only consider momenta in sphere of radius rp_ with center at p
+    const double pdist_sqr = (part.momentum().threevec() - p).sqr();
+    if (pdist_sqr > rp_ * rp_) {
+      return;
+    }
+    const double rdist_sqr = (part.position().threevec() - r).sqr();
+    // Only consider coordinates in sphere of radius rr_+rc_ with center at r
+    if (rdist_sqr >= (rr_ + rc_) * (rr_ + rc_)) {
+      return;
+    }
+    // Do not count particles that should be disregarded.
+    if (disregard_ids.count(part.id()) > 0) {
+      return;
+    }
+    // 1st order interpolation using tabulated values
+    const double i_real = std::sqrt(rdist_sqr) / (rr_ + rc_) * weights_.size();
+    const size_t i = std::floor(i_real);
+    const double rest = i_real - i;
+    if (likely(i + 1 < weights_.size())) {
+      f += weights_[i] * rest + weights_[i + 1] * (1. - rest);
+    }
+  };
+
+  if (has_index_) {
+    // Only the particles in the surrounding cells can be close enough.
+    const CellKey center = cell_of(pdg, r);
+    CellKey key = center;
+    for (int dz = -1; dz <= 1; dz++) {
+      for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+          key.second = {center.second[0] + dx, center.second[1] + dy,
+                        center.second[2] + dz};
+          const auto cell = index_.find(key);
+          if (cell == index_.end()) {
+            continue;
+          }
+          for (const auto &entry : cell->second) {
+            const Particles &particles = ensembles[entry.first];
+            // Particles which interacted since they were indexed are gone.
+            if (particles.is_valid(entry.second)) {
+              add_to_density(particles.lookup(entry.second));
+            }
+          }
         }
       }
-      if (to_disregard) {
-        continue;
-      }
-      // 1st order interpolation using tabulated values
-      const double i_real =
-          std::sqrt(rdist_sqr) / (rr_ + rc_) * weights_.size();
-      const size_t i = std::floor(i_real);
-      const double rest = i_real - i;
-      if (likely(i + 1 < weights_.size())) {
-        f += weights_[i] * rest + weights_[i + 1] * (1. - rest);
+    }
+  } else {
+    for (const Particles &particles : ensembles) {
+      for (const ParticleData &part : particles) {
+        add_to_density(part);
       }
-    }  // loop over particles in one ensemble
-  }    // loop over ensembles
+    }
+  }
   return f / ntest_ / n_ensembles_;
 }
 
+PauliBlocker::CellKey PauliBlocker::cell_of(PdgCode pdg,
+                                            const ThreeVector &r) const {
+  return {pdg,
+          {static_cast<int>(std::floor(r.x1() / cell_length_)),
+           static_cast<int>(std::floor(r.x2() / cell_length_)),
+           static_cast<int>(std::floor(r.x3() / cell_length_))}};
+}
+
+void PauliBlocker::build_index(const std::vector<Particles> &ensembles,
+                               double time, double time_step_duration) {
+  index_.clear();
+  indexed_cells_.assign(ensembles.size(), {});
+  has_index_ = true;
+  index_time_ = time;
+  /* Within the time step the particles move less than its duration, so all
+   * particles closer than rr_ + rc_ to a point are in the cell of the point or
+   * in the adjacent cells. */
+  cell_length_ = rr_ + rc_ + time_step_duration;
+  for (std::size_t i_ens = 0; i_ens < ensembles.size(); i_ens++) {
+    add_to_index(ensembles[i_ens].copy_to_vector(), i_ens);
+  }
+}
+
+void PauliBlocker::add_to_index(const ParticleList &particles,
+                                int i_ensemble) {
+  if (!has_index_) {
+    return;
+  }
+  std::vector<Cell *> &cells = indexed_cells_[i_ensemble];
+  for (const ParticleData &part : particles) {
+    if (cells.size() <= part.index()) {
+      cells.resize(part.index() + 1, nullptr);
+    }
+    if (cells[part.index()]) {
+      /* Drop the old copy with the same index. Either it is the same particle
+       * before crossing a wall, which would be counted twice otherwise, or a
+       * particle that is gone anyway. */
+      Cell &old_cell = *cells[part.index()];
+      const auto old =
+          std::find_if(old_cell.begin(), old_cell.end(),
+                       [&part](const std::pair<int, ParticleData> &entry) {
+                         return entry.second.index() == part.index();
+                       });
+      if (old != old_cell.end()) {
+        old_cell.erase(old);
+      }
+    }
+    // Follow the straight line trajectory back to the time of the index.
+    const ThreeVector position =
+        part.position().threevec() -
+        part.velocity() * (part.position().x0() - index_time_);
+    Cell &cell = index_[cell_of(part.pdgcode(), position)];
+    cell.emplace_back(i_ensemble, part);
+    cells[part.index()] = &cell;
+  }
+}
+
+void PauliBlocker::clear_index() {
+  index_.clear();
+  indexed_cells_.clear();
+  has_index_ = false;
+}
+
 void PauliBlocker::init_weights_analytical() {
   const double pi = M_PI;
   const double sqrt2 = std::sqrt(2.);
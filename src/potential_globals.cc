@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2018-2019
+ *    Copyright (c) 2018-2019,2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -12,8 +12,8 @@
 
 namespace smash {
 
-RectangularLattice<FourVector> *UB_lat_pointer = nullptr;
-RectangularLattice<FourVector> *UI3_lat_pointer = nullptr;
-Potentials *pot_pointer = nullptr;
+thread_local RectangularLattice<FourVector> *UB_lat_pointer = nullptr;
+thread_local RectangularLattice<FourVector> *UI3_lat_pointer = nullptr;
+thread_local Potentials *pot_pointer = nullptr;
 
 }  // namespace smash
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2015,2017-2022
+ *    Copyright (c) 2014-2015,2017-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -35,6 +35,7 @@ Potentials::Potentials(Configuration conf, const DensityParameters &param)
   }
   if (use_coulomb_) {
     coulomb_r_cut_ = conf.take({"Coulomb", "R_Cut"});
+    coulomb_solver_ = conf.take({"Coulomb", "Solver"}, CoulombSolver::Direct);
   }
   if (use_vdf_) {
     saturation_density_ = conf.take({"VDF", "Sat_rhoB"});
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2015-2022
+ *    Copyright (c) 2015-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -9,6 +9,11 @@
 
 #include "smash/propagation.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+
 #include "smash/boxmodus.h"
 #include "smash/collidermodus.h"
 #include "smash/listmodus.h"
@@ -41,19 +46,37 @@ double calc_hubble(double time, const ExpansionProperties &metric) {
   return h;
 }
 
-double propagate_straight_line(Particles *particles, double to_time,
-                               const std::vector<FourVector> &beam_momentum) {
-  bool negative_dt_error = false;
-  double dt = 0.0;
-  for (ParticleData &data : *particles) {
+namespace {
+/**
+ * Batch of particles gathered from their ParticleData objects into arrays,
+ * which are propagated by propagate_straight_line_kernel.
+ */
+class PropagationBatch {
+ public:
+  /**
+   * Construct an empty batch.
+   *
+   * \param[in] to_time final time [fm]
+   * \param[in] beam_momentum see propagate_straight_line
+   */
+  PropagationBatch(double to_time, const std::vector<FourVector> &beam_momentum)
+      : to_time_(to_time), beam_momentum_(beam_momentum) {}
+
+  /**
+   * Add a particle to the batch, propagating the batch when it is full.
+   *
+   * \param[in,out] data particle to be propagated
+   */
+  void add(ParticleData &data) {
     const double t0 = data.position().x0();
-    dt = to_time - t0;
-    if (dt < 0.0 && !negative_dt_error) {
+    last_dt_ = to_time_ - t0;
+    if (last_dt_ < 0.0 && !negative_dt_error_) {
       // Print error message once, not for every particle
-      negative_dt_error = true;
-      logg[LPropagation].error("propagate_straight_line - negative dt = ", dt);
+      negative_dt_error_ = true;
+      logg[LPropagation].error("propagate_straight_line - negative dt = ",
+                               last_dt_);
     }
-    assert(dt >= 0.0);
+    assert(last_dt_ >= 0.0);
     /* "Frozen Fermi motion": Fermi momenta are only used for collisions,
      * but not for propagation. This is done to avoid nucleus flying apart
      * even if potentials are off. Initial nucleons before the first collision
@@ -65,22 +88,112 @@ double propagate_straight_line(Particles *particles, double to_time,
     assert(data.id() >= 0);
     const bool avoid_fermi_motion =
         (static_cast<uint64_t>(data.id()) <
-         static_cast<uint64_t>(beam_momentum.size())) &&
+         static_cast<uint64_t>(beam_momentum_.size())) &&
         (data.get_history().collisions_per_particle == 0);
-    ThreeVector v;
-    if (avoid_fermi_motion) {
-      const FourVector vbeam = beam_momentum[data.id()];
-      v = vbeam.velocity();
-    } else {
-      v = data.velocity();
+    const FourVector &momentum =
+        avoid_fermi_motion ? beam_momentum_[data.id()] : data.momentum();
+    const FourVector &position = data.position();
+    t_[size_] = t0;
+    x_[size_] = position.x1();
+    y_[size_] = position.x2();
+    z_[size_] = position.x3();
+    energy_[size_] = momentum.x0();
+    px_[size_] = momentum.x1();
+    py_[size_] = momentum.x2();
+    pz_[size_] = momentum.x3();
+    particles_[size_] = &data;
+    if (++size_ == batch_size) {
+      flush();
     }
-    const FourVector distance = FourVector(0.0, v * dt);
-    logg[LPropagation].debug("Particle ", data, " motion: ", distance);
-    FourVector position = data.position() + distance;
-    position.set_x0(to_time);
-    data.set_4position(position);
   }
-  return dt;
+
+  /// Propagate the particles in the batch and write back their positions.
+  void flush() {
+    propagate_straight_line_kernel(size_, to_time_, t_.data(), x_.data(),
+                                   y_.data(), z_.data(), energy_.data(),
+                                   px_.data(), py_.data(), pz_.data());
+    for (std::size_t i = 0; i < size_; i++) {
+      const FourVector position(t_[i], x_[i], y_[i], z_[i]);
+      logg[LPropagation].debug("Particle ", *particles_[i],
+                               " propagated to ", position);
+      particles_[i]->set_4position(position);
+    }
+    size_ = 0;
+  }
+
+  /// \return Propagation time of the last added particle.
+  double last_dt() const { return last_dt_; }
+
+ private:
+  /// Number of particles propagated together
+  static constexpr std::size_t batch_size = 64;
+  /// Final time
+  const double to_time_;
+  /// Momenta of the initial nucleons with frozen Fermi motion
+  const std::vector<FourVector> &beam_momentum_;
+  /// Whether a negative time step was reported
+  bool negative_dt_error_ = false;
+  /// Propagation time of the last added particle
+  double last_dt_ = 0.0;
+  /// Number of particles in the batch
+  std::size_t size_ = 0;
+  /// Times of the particles
+  std::array<double, batch_size> t_;
+  /// x coordinates of the particles
+  std::array<double, batch_size> x_;
+  /// y coordinates of the particles
+  std::array<double, batch_size> y_;
+  /// z coordinates of the particles
+  std::array<double, batch_size> z_;
+  /// Energies of the propagation momenta
+  std::array<double, batch_size> energy_;
+  /// x components of the propagation momenta
+  std::array<double, batch_size> px_;
+  /// y components of the propagation momenta
+  std::array<double, batch_size> py_;
+  /// z components of the propagation momenta
+  std::array<double, batch_size> pz_;
+  /// Particles in the batch
+  std::array<ParticleData *, batch_size> particles_;
+};
+}  // namespace
+
+double propagate_straight_line(Particles *particles, double to_time,
+                               const std::vector<FourVector> &beam_momentum) {
+  PropagationBatch batch(to_time, beam_momentum);
+  for (ParticleData &data : *particles) {
+    batch.add(data);
+  }
+  batch.flush();
+  return batch.last_dt();
+}
+
+void propagate_straight_line(Particles *particles, ParticleList &to_propagate,
+                             double to_time,
+                             const std::vector<FourVector> &beam_momentum) {
+  PropagationBatch batch(to_time, beam_momentum);
+  for (const ParticleData &copy : to_propagate) {
+    batch.add(particles->lookup(copy));
+  }
+  batch.flush();
+  for (ParticleData &copy : to_propagate) {
+    copy = particles->lookup(copy);
+  }
+}
+
+void propagate_straight_line_kernel(std::size_t n, double to_time, double *t,
+                                    double *x, double *y, double *z,
+                                    const double *energy, const double *px,
+                                    const double *py, const double *pz) {
+  // Same operations as FourVector::velocity, to give identical results.
+  for (std::size_t i = 0; i < n; i++) {
+    const double dt = to_time - t[i];
+    const double inverse_energy = 1.0 / energy[i];
+    x[i] += px[i] * inverse_energy * dt;
+    y[i] += py[i] * inverse_energy * dt;
+    z[i] += pz[i] * inverse_energy * dt;
+    t[i] = to_time;
+  }
 }
 
 void expand_space_time(Particles *particles,
@@ -108,19 +221,168 @@ void expand_space_time(Particles *particles,
   }
 }
 
+namespace {
+
+/**
+ * Cell list of the baryons and nuclei of all ensembles, which are the only
+ * particles contributing to Potentials::all_forces, to find the particles
+ * within the range of the forces of a position without looping over all of
+ * them.
+ *
+ * The particles are copied at construction, so the index keeps describing the
+ * system at that moment while the momenta of the particles are updated.
+ */
+class BaryonCellList {
+ public:
+  /**
+   * Index the baryons and nuclei of all ensembles.
+   *
+   * \param[in] ensembles particles of all ensembles
+   * \param[in] range distance beyond which particles do not contribute to the
+   *                  forces [fm], the minimal edge length of the cells
+   */
+  BaryonCellList(const std::vector<Particles> &ensembles, double range) {
+    for (const Particles &particles : ensembles) {
+      for (const ParticleData &data : particles) {
+        if (data.is_baryon() || data.is_nucleus()) {
+          baryons_.push_back(data);
+        }
+      }
+    }
+    if (baryons_.empty()) {
+      return;
+    }
+    ThreeVector upper = baryons_.front().position().threevec();
+    origin_ = upper;
+    for (const ParticleData &data : baryons_) {
+      const ThreeVector r = data.position().threevec();
+      for (int i = 0; i < 3; i++) {
+        origin_[i] = std::min(origin_[i], r[i]);
+        upper[i] = std::max(upper[i], r[i]);
+      }
+    }
+    /* Cells smaller than the range would not reduce the number of candidates
+     * much, more cells than particles only cost memory. */
+    cell_length_ = range > 0. ? range : 1.;
+    const std::size_t max_cells = 8 * baryons_.size() + 27;
+    while (true) {
+      std::size_t total = 1;
+      for (int i = 0; i < 3; i++) {
+        n_cells_[i] = static_cast<int>((upper[i] - origin_[i]) / cell_length_) +
+                      1;
+        total *= n_cells_[i];
+      }
+      if (total <= max_cells) {
+        break;
+      }
+      cell_length_ *= 1.5;
+    }
+
+    // Sort the particles into the cells, keeping their order within a cell
+    std::vector<std::size_t> cell_of_baryon(baryons_.size());
+    cell_start_.assign(static_cast<std::size_t>(n_cells_[0]) * n_cells_[1] *
+                               n_cells_[2] +
+                           1,
+                       0);
+    for (std::size_t i = 0; i < baryons_.size(); i++) {
+      const std::array<int, 3> cell = cell_of(baryons_[i].position());
+      cell_of_baryon[i] = cell_index(cell[0], cell[1], cell[2]);
+      cell_start_[cell_of_baryon[i] + 1]++;
+    }
+    for (std::size_t c = 1; c < cell_start_.size(); c++) {
+      cell_start_[c] += cell_start_[c - 1];
+    }
+    sorted_baryons_.resize(baryons_.size());
+    std::vector<std::size_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+    for (std::size_t i = 0; i < baryons_.size(); i++) {
+      sorted_baryons_[fill[cell_of_baryon[i]]++] = i;
+    }
+  }
+
+  /**
+   * \param[in] r position where the forces are calculated
+   * \return Indexed baryons and nuclei within the range of r and possibly
+   *         some more beyond it, in the order of the ensembles. Valid until the
+   *         next call.
+   */
+  const ParticleList &near(const ThreeVector &r) {
+    nearby_.clear();
+    if (baryons_.empty()) {
+      return nearby_;
+    }
+    candidates_.clear();
+    const std::array<int, 3> cell = cell_of(FourVector(0., r));
+    for (int iz = std::max(cell[2] - 1, 0);
+         iz <= std::min(cell[2] + 1, n_cells_[2] - 1); iz++) {
+      for (int iy = std::max(cell[1] - 1, 0);
+           iy <= std::min(cell[1] + 1, n_cells_[1] - 1); iy++) {
+        for (int ix = std::max(cell[0] - 1, 0);
+             ix <= std::min(cell[0] + 1, n_cells_[0] - 1); ix++) {
+          const std::size_t c = cell_index(ix, iy, iz);
+          candidates_.insert(candidates_.end(),
+                             sorted_baryons_.begin() + cell_start_[c],
+                             sorted_baryons_.begin() + cell_start_[c + 1]);
+        }
+      }
+    }
+    /* Summing the contributions in the original order gives the same forces
+     * as the full particle list, since the others contribute exactly zero. */
+    std::sort(candidates_.begin(), candidates_.end());
+    for (std::size_t i : candidates_) {
+      nearby_.push_back(baryons_[i]);
+    }
+    return nearby_;
+  }
+
+ private:
+  /**
+   * \param[in] position position of a particle or point
+   * \return Indices of the cell containing the position, clamped to the
+   *         indexed volume.
+   */
+  std::array<int, 3> cell_of(const FourVector &position) const {
+    std::array<int, 3> cell;
+    for (int i = 0; i < 3; i++) {
+      const double x = (position[i + 1] - origin_[i]) / cell_length_;
+      // Points beyond the outer cells only see the particles in them
+      cell[i] = x < 0. ? -1
+                       : static_cast<int>(std::min(
+                             std::floor(x), static_cast<double>(n_cells_[i])));
+    }
+    return cell;
+  }
+
+  /// \return Index of the cell with indices ix, iy and iz.
+  std::size_t cell_index(int ix, int iy, int iz) const {
+    return ix + static_cast<std::size_t>(n_cells_[0]) *
+                    (iy + static_cast<std::size_t>(n_cells_[1]) * iz);
+  }
+
+  /// Copies of the indexed particles, in the order of the ensembles
+  ParticleList baryons_;
+  /// Lower corner of the indexed volume
+  ThreeVector origin_;
+  /// Edge length of the cells
+  double cell_length_ = 1.;
+  /// Number of cells in x, y and z direction
+  std::array<int, 3> n_cells_ = {0, 0, 0};
+  /// Offset of the first particle of each cell in sorted_baryons_
+  std::vector<std::size_t> cell_start_;
+  /// Indices of the particles in baryons_, sorted by cell
+  std::vector<std::size_t> sorted_baryons_;
+  /// Indices of the particles in the cells around a position
+  std::vector<std::size_t> candidates_;
+  /// Particles in the cells around a position, returned by near
+  ParticleList nearby_;
+};
+
+}  // namespace
+
 void update_momenta(
     std::vector<Particles> &ensembles, double dt, const Potentials &pot,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FB_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FI3_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *EM_lat) {
-  // Copy particles from ALL ensembles to a single list before propagation
-  // and calculate potentials from this list
-  ParticleList plist;
-  for (Particles &particles : ensembles) {
-    const ParticleList tmp = particles.copy_to_vector();
-    plist.insert(plist.end(), tmp.begin(), tmp.end());
-  }
-
   bool possibly_use_lattice =
       (pot.use_skyrme() ? (FB_lat != nullptr) : true) &&
       (pot.use_vdf() ? (FB_lat != nullptr) : true) &&
@@ -128,6 +390,33 @@ void update_momenta(
   std::pair<ThreeVector, ThreeVector> FB, FI3, EM_fields;
   double min_time_scale = std::numeric_limits<double>::infinity();
 
+  /* Lattices can be used for calculation if 1-2 are fulfilled:
+   * 1) Required lattices are not nullptr - possibly_use_lattice
+   * 2) r is not out of required lattices */
+  auto forces_from_lattice = [&](const ThreeVector &r) {
+    return possibly_use_lattice &&
+           (pot.use_skyrme() ? FB_lat->value_at(r, FB) : true) &&
+           (pot.use_vdf() ? FB_lat->value_at(r, FB) : true) &&
+           (pot.use_symmetry() ? FI3_lat->value_at(r, FI3) : true);
+  };
+  /* Forces off the lattices are calculated from the baryons of ALL ensembles
+   * before the propagation. They are only indexed if there is such a
+   * particle, which is usually not the case. */
+  bool all_on_lattice = possibly_use_lattice;
+  for (Particles &particles : ensembles) {
+    all_on_lattice =
+        all_on_lattice &&
+        std::all_of(particles.begin(), particles.end(),
+                    [&](const ParticleData &data) {
+                      return !(data.is_baryon() || data.is_nucleus()) ||
+                             forces_from_lattice(data.position().threevec());
+                    });
+  }
+  std::optional<BaryonCellList> baryons;
+  if (!all_on_lattice) {
+    baryons.emplace(ensembles, pot.force_range());
+  }
+
   for (Particles &particles : ensembles) {
     for (ParticleData &data : particles) {
       // Only baryons and nuclei will be affected by the potentials
@@ -136,14 +425,7 @@ void update_momenta(
       }
       const auto scale = pot.force_scale(data.type());
       const ThreeVector r = data.position().threevec();
-      /* Lattices can be used for calculation if 1-2 are fulfilled:
-       * 1) Required lattices are not nullptr - possibly_use_lattice
-       * 2) r is not out of required lattices */
-      const bool use_lattice =
-          possibly_use_lattice &&
-          (pot.use_skyrme() ? FB_lat->value_at(r, FB) : true) &&
-          (pot.use_vdf() ? FB_lat->value_at(r, FB) : true) &&
-          (pot.use_symmetry() ? FI3_lat->value_at(r, FI3) : true);
+      const bool use_lattice = forces_from_lattice(r);
       if (!pot.use_skyrme() && !pot.use_vdf()) {
         FB = std::make_pair(ThreeVector(0., 0., 0.), ThreeVector(0., 0., 0.));
       }
@@ -151,7 +433,7 @@ void update_momenta(
         FI3 = std::make_pair(ThreeVector(0., 0., 0.), ThreeVector(0., 0., 0.));
       }
       if (!use_lattice) {
-        const auto tmp = pot.all_forces(r, plist);
+        const auto tmp = pot.all_forces(r, baryons->near(r));
         FB = std::make_pair(std::get<0>(tmp), std::get<1>(tmp));
         FI3 = std::make_pair(std::get<2>(tmp), std::get<3>(tmp));
       }
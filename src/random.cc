@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014,2017-2019,2022
+ *    Copyright (c) 2014,2017-2019,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -15,7 +15,8 @@
 
 namespace smash {
 static constexpr int LGrandcanThermalizer = LogArea::GrandcanThermalizer::id;
-/*thread_local (see #3075)*/ random::Engine random::engine;
+thread_local random::Stream random::detail::default_stream;
+thread_local random::Stream *random::detail::active_stream = nullptr;
 
 int64_t random::generate_63bit_seed() {
   std::random_device rd;
@@ -10,12 +10,16 @@
 #include "smash/scatteractionsfinder.h"
 
 #include <algorithm>
+#include <limits>
 #include <map>
+#include <string>
 #include <vector>
 
+#include "smash/algorithms.h"
 #include "smash/constants.h"
 #include "smash/decaymodes.h"
 #include "smash/logging.h"
+#include "smash/potential_globals.h"
 #include "smash/scatteraction.h"
 #include "smash/scatteractionmulti.h"
 #include "smash/scatteractionphoton.h"
@@ -36,7 +40,15 @@ ScatterActionsFinder::ScatterActionsFinder(
       isotropic_(config.take({"Collision_Term", "Isotropic"}, false)),
       box_length_(parameters.box_length),
       string_formation_time_(config.take(
-          {"Collision_Term", "String_Parameters", "Formation_Time"}, 1.)) {
+          {"Collision_Term", "String_Parameters", "Formation_Time"}, 1.)),
+      cross_section_bounds_([this](const ParticleType& type_a,
+                                   const ParticleType& type_b, double sqrts) {
+        return total_cross_section(type_a, type_b, sqrts);
+      }),
+      multi_particle_rate_bounds_(
+          [this](const ParticleTypePtrList& types, double sqrts) {
+            return multi_particle_rate(types, sqrts);
+          }) {
   if (is_constant_elastic_isotropic()) {
     logg[LFindScatter].info(
         "Constant elastic isotropic cross-section mode:", " using ",
@@ -103,26 +115,42 @@ ScatterActionsFinder::ScatterActionsFinder(
   if (finder_parameters_.strings_switch) {
     auto subconfig = config.extract_sub_configuration(
         {"Collision_Term", "String_Parameters"}, Configuration::GetEmpty::Yes);
-    string_process_interface_ = std::make_unique<StringProcess>(
-        subconfig.take({"String_Tension"}, 1.0), string_formation_time_,
-        subconfig.take({"Gluon_Beta"}, 0.5),
-        subconfig.take({"Gluon_Pmin"}, 0.001),
-        subconfig.take({"Quark_Alpha"}, 2.0),
-        subconfig.take({"Quark_Beta"}, 7.0),
-        subconfig.take({"Strange_Supp"}, 0.16),
-        subconfig.take({"Diquark_Supp"}, 0.036),
-        subconfig.take({"Sigma_Perp"}, 0.42),
-        subconfig.take({"StringZ_A_Leading"}, 0.2),
-        subconfig.take({"StringZ_B_Leading"}, 2.0),
-        subconfig.take({"StringZ_A"}, 2.0), subconfig.take({"StringZ_B"}, 0.55),
-        subconfig.take({"String_Sigma_T"}, 0.5),
-        subconfig.take({"Form_Time_Factor"}, 1.0),
-        subconfig.take({"Mass_Dependent_Formation_Times"}, false),
-        subconfig.take({"Prob_proton_to_d_uu"}, 1. / 3.),
-        subconfig.take({"Separate_Fragment_Baryon"}, true),
-        subconfig.take({"Popcorn_Rate"}, 0.15),
-        subconfig.take({"Use_Monash_Tune"},
-                       parameters.use_monash_tune_default.value()));
+    const double string_tension = subconfig.take({"String_Tension"}, 1.0);
+    const double gluon_beta = subconfig.take({"Gluon_Beta"}, 0.5);
+    const double gluon_pmin = subconfig.take({"Gluon_Pmin"}, 0.001);
+    const double quark_alpha = subconfig.take({"Quark_Alpha"}, 2.0);
+    const double quark_beta = subconfig.take({"Quark_Beta"}, 7.0);
+    const double strange_supp = subconfig.take({"Strange_Supp"}, 0.16);
+    const double diquark_supp = subconfig.take({"Diquark_Supp"}, 0.036);
+    const double sigma_perp = subconfig.take({"Sigma_Perp"}, 0.42);
+    const double stringz_a_leading =
+        subconfig.take({"StringZ_A_Leading"}, 0.2);
+    const double stringz_b_leading =
+        subconfig.take({"StringZ_B_Leading"}, 2.0);
+    const double stringz_a = subconfig.take({"StringZ_A"}, 2.0);
+    const double stringz_b = subconfig.take({"StringZ_B"}, 0.55);
+    const double string_sigma_T = subconfig.take({"String_Sigma_T"}, 0.5);
+    const double factor_t_form = subconfig.take({"Form_Time_Factor"}, 1.0);
+    const bool mass_dependent_formation_times =
+        subconfig.take({"Mass_Dependent_Formation_Times"}, false);
+    const double prob_proton_to_d_uu =
+        subconfig.take({"Prob_proton_to_d_uu"}, 1. / 3.);
+    const bool separate_fragment_baryon =
+        subconfig.take({"Separate_Fragment_Baryon"}, true);
+    const double popcorn_rate = subconfig.take({"Popcorn_Rate"}, 0.15);
+    const bool use_monash_tune = subconfig.take(
+        {"Use_Monash_Tune"}, parameters.use_monash_tune_default.value());
+    /* The PYTHIA objects carry state, hence every thread that evolves
+     * ensembles needs its own StringProcess. */
+    for (int i = 0; i < parameters.n_ensemble_threads; i++) {
+      string_process_interfaces_.emplace_back(std::make_unique<StringProcess>(
+          string_tension, string_formation_time_, gluon_beta, gluon_pmin,
+          quark_alpha, quark_beta, strange_supp, diquark_supp, sigma_perp,
+          stringz_a_leading, stringz_b_leading, stringz_a, stringz_b,
+          string_sigma_T, factor_t_form, mass_dependent_formation_times,
+          prob_proton_to_d_uu, separate_fragment_baryon, popcorn_rate,
+          use_monash_tune));
+    }
   }
 }
 
@@ -222,25 +250,14 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
     return nullptr;
   }
 
-  // Create ScatterAction object.
-  ScatterActionPtr act = std::make_unique<ScatterAction>(
-      data_a, data_b, time_until_collision, isotropic_, string_formation_time_,
-      box_length_);
-
-  if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic) {
-    act->set_stochastic_pos_idx();
-  }
-
-  if (finder_parameters_.strings_switch) {
-    act->set_string_interface(string_process_interface_.get());
-  }
-
-  // Distance squared calculation not needed for stochastic criterion
+  /* Distance squared calculation not needed for stochastic criterion. It is
+   * done on the particles directly, such that no action is allocated for the
+   * pairs which are too far apart, which are most of them. */
   const double distance_squared =
       (finder_parameters_.coll_crit == CollisionCriterion::Geometric)
-          ? act->transverse_distance_sqr()
+          ? ScatterAction::transverse_distance_sqr(data_a, data_b)
       : (finder_parameters_.coll_crit == CollisionCriterion::Covariant)
-          ? act->cov_transverse_distance_sqr()
+          ? ScatterAction::cov_transverse_distance_sqr(data_a, data_b)
           : 0.0;
 
   // Don't calculate cross section if the particles are very far apart.
@@ -251,6 +268,38 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
     return nullptr;
   }
 
+  /* Don't build all collision channels if the particles are too far apart
+   * for the largest cross section possible at their sqrt(s). The cross
+   * section scaling factors are at most 1 and applied to the bound, too.
+   * If potentials shift the thresholds, the cross section depends on the
+   * position and there is no bound. */
+  const bool potentials_affect_threshold =
+      UB_lat_pointer != nullptr || UI3_lat_pointer != nullptr;
+  double xs_bound = std::numeric_limits<double>::infinity();
+  if (finder_parameters_.coll_crit != CollisionCriterion::Stochastic &&
+      !potentials_affect_threshold) {
+    xs_bound = cross_section_bounds_.upper_bound(data_a, data_b) * fm2_mb /
+               static_cast<double>(finder_parameters_.testparticles) *
+               data_a.xsec_scaling_factor(time_until_collision) *
+               data_b.xsec_scaling_factor(time_until_collision);
+    if (distance_squared >= xs_bound * M_1_PI) {
+      return nullptr;
+    }
+  }
+
+  // Create ScatterAction object.
+  ScatterActionPtr act = std::make_unique<ScatterAction>(
+      data_a, data_b, time_until_collision, isotropic_, string_formation_time_,
+      box_length_);
+
+  if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic) {
+    act->set_stochastic_pos_idx();
+  }
+
+  if (finder_parameters_.strings_switch) {
+    act->set_string_interface(string_process_interface());
+  }
+
   // Add various subprocesses.
   act->add_all_scatterings(finder_parameters_);
   double xs = act->cross_section() * fm2_mb /
@@ -260,6 +309,15 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
   xs *= data_a.xsec_scaling_factor(time_until_collision);
   xs *= data_b.xsec_scaling_factor(time_until_collision);
 
+  /* The bound is not proven, so a pair which exceeds it means that pairs
+   * further apart may have been rejected wrongly. */
+  if (xs > xs_bound) {
+    logg[LFindScatter].warn(
+        "Cross section of ", data_a.type().name(), data_b.type().name(),
+        " at sqrts[GeV] = ", act->sqrt_s(), " exceeds its tabulated bound (",
+        xs, " > ", xs_bound, " fm^2), collisions may have been missed.");
+  }
+
   if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic) {
     const double v_rel = act->relative_velocity();
     /* Collision probability for 2-particle scattering, see
@@ -321,8 +379,56 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
   return act;
 }
 
+double ScatterActionsFinder::total_cross_section(const ParticleType& type_a,
+                                                 const ParticleType& type_b,
+                                                 double sqrts) const {
+  const double momentum = pCM(sqrts, type_a.mass(), type_b.mass());
+  ParticleData data_a(type_a), data_b(type_b);
+  data_a.set_4momentum(type_a.mass(), momentum, 0.0, 0.0);
+  data_b.set_4momentum(type_b.mass(), -momentum, 0.0, 0.0);
+  ScatterAction act(data_a, data_b, 0.0, isotropic_, string_formation_time_);
+  if (finder_parameters_.strings_switch) {
+    act.set_string_interface(string_process_interface());
+  }
+  act.add_all_scatterings(finder_parameters_);
+  return act.cross_section();
+}
+
+double ScatterActionsFinder::multi_particle_rate(
+    const ParticleTypePtrList& types, double sqrts) const {
+  /* The first particle moves towards the others, which are at rest, with the
+   * energy that gives the requested sqrt(s). */
+  double mass_at_rest = 0.;
+  for (std::size_t i = 1; i < types.size(); i++) {
+    mass_at_rest += types[i]->mass();
+  }
+  const double mass_moving = types[0]->mass();
+  const double energy = (sqrts * sqrts - mass_moving * mass_moving -
+                         mass_at_rest * mass_at_rest) /
+                        (2. * mass_at_rest);
+  const double momentum =
+      std::sqrt(std::max(0., energy * energy - mass_moving * mass_moving));
+  ParticleList plist;
+  plist.reserve(types.size());
+  double energy_product = 1.;
+  for (ParticleTypePtr type : types) {
+    ParticleData data(*type);
+    if (plist.empty()) {
+      data.set_4momentum(mass_moving, momentum, 0., 0.);
+    } else {
+      data.set_4momentum(type->mass(), 0., 0., 0.);
+    }
+    energy_product *= data.momentum().x0();
+    plist.push_back(data);
+  }
+  ScatterActionMulti act(plist, 0.);
+  act.add_possible_reactions(1., 1., finder_parameters_.included_multi);
+  return act.get_total_weight() * energy_product;
+}
+
 ActionPtr ScatterActionsFinder::check_collision_multi_part(
-    const ParticleList& plist, double dt, const double gcell_vol) const {
+    const std::vector<const ParticleData*>& incoming, double dt,
+    const double gcell_vol) const {
   /* If all particles
    * 1) belong to the two colliding nuclei
    * 2) are within the same nucleus
@@ -330,17 +436,17 @@ ActionPtr ScatterActionsFinder::check_collision_multi_part(
    * then the collision between them are banned also for multi-particle
    * interactions. */
   if (!finder_parameters_.allow_collisions_within_nucleus) {
-    bool all_projectile =
-        std::all_of(plist.begin(), plist.end(), [&](const ParticleData& data) {
-          return data.belongs_to() == BelongsTo::Projectile;
+    bool all_projectile = std::all_of(
+        incoming.begin(), incoming.end(), [&](const ParticleData* data) {
+          return data->belongs_to() == BelongsTo::Projectile;
         });
-    bool all_target =
-        std::all_of(plist.begin(), plist.end(), [&](const ParticleData& data) {
-          return data.belongs_to() == BelongsTo::Target;
+    bool all_target = std::all_of(
+        incoming.begin(), incoming.end(), [&](const ParticleData* data) {
+          return data->belongs_to() == BelongsTo::Target;
         });
-    bool none_collided =
-        std::all_of(plist.begin(), plist.end(), [&](const ParticleData& data) {
-          return data.get_history().collisions_per_particle == 0;
+    bool none_collided = std::all_of(
+        incoming.begin(), incoming.end(), [&](const ParticleData* data) {
+          return data->get_history().collisions_per_particle == 0;
         });
     if ((all_projectile || all_target) && none_collided) {
       return nullptr;
@@ -351,29 +457,60 @@ ActionPtr ScatterActionsFinder::check_collision_multi_part(
     return nullptr;
   }
 
-  /* Optimisation for later: Already check here at the beginning
-   * if collision with plist is possible before constructing actions. */
+  /* 1. Draw the random number of the probability decision first and reject
+   *    the particles right away if it exceeds the largest probability
+   *    possible at their sqrt(s). This leaves the accepted reactions
+   *    unchanged, but only few combinations have to build their reactions. */
+  const double random_no = random::uniform(0., 1.);
+  const double n_minus_one = static_cast<double>(incoming.size() - 1);
+  double prob_bound =
+      dt / std::pow(gcell_vol * finder_parameters_.testparticles, n_minus_one);
+  for (const ParticleData* data : incoming) {
+    prob_bound *= data->xsec_scaling_factor() / data->momentum().x0();
+  }
+  prob_bound *= multi_particle_rate_bounds_.upper_bound(incoming);
+  if (random_no > prob_bound) {
+    return nullptr;
+  }
 
-  // 1. Determine time of collision.
+  // 2. Determine time of collision.
   const double time_until_collision = dt * random::uniform(0., 1.);
 
-  // 2. Create ScatterAction object.
+  // 3. Create ScatterAction object.
+  ParticleList plist;
+  plist.reserve(incoming.size());
+  for (const ParticleData* data : incoming) {
+    plist.push_back(*data);
+  }
   ScatterActionMultiPtr act =
       std::make_unique<ScatterActionMulti>(plist, time_until_collision);
 
   act->set_stochastic_pos_idx();
 
-  // 3. Add possible final states (dt and gcell_vol for probability calculation)
+  // 4. Add possible final states (dt and gcell_vol for probability calculation)
   act->add_possible_reactions(dt, gcell_vol, finder_parameters_.included_multi);
 
-  /* 4. Return total collision probability
+  /* 5. Return total collision probability
    *    Scales with 1 over the number of testpartciles to the power of the
    *    number of incoming particles - 1 */
   const double prob =
       act->get_total_weight() /
       std::pow(finder_parameters_.testparticles, plist.size() - 1);
 
-  // 5. Check that probability is smaller than one
+  /* The bound is not proven, so a combination which exceeds it means that
+   * reactions may have been rejected wrongly. */
+  if (prob > prob_bound) {
+    std::string names;
+    for (const ParticleData& data : plist) {
+      names += data.type().name();
+    }
+    logg[LFindScatter].warn("Probability of ", names,
+                            " at sqrts[GeV] = ", act->sqrt_s(),
+                            " exceeds its tabulated bound (", prob, " > ",
+                            prob_bound, "), reactions may have been missed.");
+  }
+
+  // 6. Check that probability is smaller than one
   if (prob > 1.) {
     std::stringstream err;
     err << "Probability " << prob << " larger than 1 for stochastic rates for ";
@@ -389,8 +526,7 @@ ActionPtr ScatterActionsFinder::check_collision_multi_part(
     }
   }
 
-  // 6. Perform probability decisions
-  double random_no = random::uniform(0., 1.);
+  // 7. Perform probability decisions
   if (random_no > prob) {
     return nullptr;
   }
@@ -412,53 +548,75 @@ ActionList ScatterActionsFinder::find_actions_in_cell(
           actions.push_back(std::move(act));
         }
       }
-      if (finder_parameters_.included_multi.any()) {
-        // Also, check for 3 particle scatterings with stochastic criterion
-        for (const ParticleData& p3 : search_list) {
-          if (finder_parameters_.included_multi
-                      [IncludedMultiParticleReactions::Deuteron_3to2] == 1 ||
-              finder_parameters_.included_multi
-                      [IncludedMultiParticleReactions::Meson_3to1] == 1) {
-            if (p1.id() < p2.id() && p2.id() < p3.id()) {
-              ActionPtr act =
-                  check_collision_multi_part({p1, p2, p3}, dt, gcell_vol);
-              if (act) {
-                actions.push_back(std::move(act));
-              }
-            }
-          }
-          for (const ParticleData& p4 : search_list) {
-            if (finder_parameters_.included_multi
-                    [IncludedMultiParticleReactions::A3_Nuclei_4to2]) {
-              if (p1.id() < p2.id() && p2.id() < p3.id() && p3.id() < p4.id()) {
-                ActionPtr act =
-                    check_collision_multi_part({p1, p2, p3, p4}, dt, gcell_vol);
-                if (act) {
-                  actions.push_back(std::move(act));
-                }
-              }
-            }
-            if (finder_parameters_.included_multi
-                        [IncludedMultiParticleReactions::NNbar_5to2] == 1 &&
-                search_list.size() >= 5) {
-              for (const ParticleData& p5 : search_list) {
-                if ((p1.id() < p2.id() && p2.id() < p3.id() &&
-                     p3.id() < p4.id() && p4.id() < p5.id()) &&
-                    (p1.is_pion() && p2.is_pion() && p3.is_pion() &&
-                     p4.is_pion() && p5.is_pion())) {
-                  // at the moment only pure pion 5-body reactions
-                  ActionPtr act = check_collision_multi_part(
-                      {p1, p2, p3, p4, p5}, dt, gcell_vol);
-                  if (act) {
-                    actions.push_back(std::move(act));
-                  }
-                }
-              }
-            }
-          }
-        }
+    }
+  }
+  const MultiParticleReactionsBitSet& multi = finder_parameters_.included_multi;
+  if (multi.none()) {
+    return actions;
+  }
+
+  /* Check for multi-particle scatterings with the stochastic criterion. Only
+   * the species that appear in the reactions of each number of incoming
+   * particles are combined, since the reaction probability of all other
+   * combinations is zero. The candidates are sorted by id, so that every
+   * combination is checked once, with the particles in the order of their
+   * ids. */
+  std::vector<const ParticleData*> by_id;
+  by_id.reserve(search_list.size());
+  for (const ParticleData& data : search_list) {
+    by_id.push_back(&data);
+  }
+  std::sort(by_id.begin(), by_id.end(),
+            [](const ParticleData* a, const ParticleData* b) {
+              return a->id() < b->id();
+            });
+  auto candidates = [&by_id](auto takes_part) {
+    std::vector<const ParticleData*> selected;
+    for (const ParticleData* data : by_id) {
+      if (takes_part(data->pdgcode())) {
+        selected.push_back(data);
       }
     }
+    return selected;
+  };
+  auto check_combinations = [&](const std::vector<const ParticleData*>& list,
+                                std::size_t n_incoming) {
+    for_each_combination(
+        list, n_incoming,
+        [&](const std::vector<const ParticleData*>& incoming) {
+          ActionPtr act = check_collision_multi_part(incoming, dt, gcell_vol);
+          if (act) {
+            actions.push_back(std::move(act));
+          }
+        });
+  };
+
+  // 3 -> 1 needs three pions or two pions and an eta, 3 -> 2 forms a
+  // deuteron out of nucleons with a pion or nucleon catalyst
+  const bool meson_3to1 = multi[IncludedMultiParticleReactions::Meson_3to1];
+  const bool deuteron_3to2 =
+      multi[IncludedMultiParticleReactions::Deuteron_3to2];
+  if (meson_3to1 || deuteron_3to2) {
+    check_combinations(candidates([&](PdgCode pdg) {
+                         return pdg.is_pion() ||
+                                (meson_3to1 && pdg == pdg::eta) ||
+                                (deuteron_3to2 && pdg.is_nucleon());
+                       }),
+                       3);
+  }
+  // 4 -> 2 forms A = 3 nuclei out of (anti-)nucleons and (anti-)Lambdas with
+  // a pion or nucleon catalyst
+  if (multi[IncludedMultiParticleReactions::A3_Nuclei_4to2]) {
+    check_combinations(candidates([](PdgCode pdg) {
+                         return pdg.is_pion() || pdg.is_nucleon() ||
+                                pdg == pdg::Lambda || pdg == -pdg::Lambda;
+                       }),
+                       4);
+  }
+  // 5 -> 2 annihilates pions into a nucleon-antinucleon pair
+  if (multi[IncludedMultiParticleReactions::NNbar_5to2]) {
+    check_combinations(
+        candidates([](PdgCode pdg) { return pdg.is_pion(); }), 5);
   }
   return actions;
 }
@@ -541,7 +699,7 @@ void ScatterActionsFinder::dump_reactions() const {
             ScatterActionPtr act = std::make_unique<ScatterAction>(
                 A, B, time, isotropic_, string_formation_time_);
             if (finder_parameters_.strings_switch) {
-              act->set_string_interface(string_process_interface_.get());
+              act->set_string_interface(string_process_interface());
             }
             act->add_all_scatterings(finder_parameters_);
             const double total_cs = act->cross_section();
@@ -925,7 +1083,7 @@ void ScatterActionsFinder::dump_cross_sections(
     ScatterActionPtr act = std::make_unique<ScatterAction>(
         a_data, b_data, 0., isotropic_, string_formation_time_);
     if (finder_parameters_.strings_switch) {
-      act->set_string_interface(string_process_interface_.get());
+      act->set_string_interface(string_process_interface());
     }
     act->add_all_scatterings(finder_parameters_);
     decaytree::Node tree(a.name() + b.name(), act->cross_section(), {&a, &b},
@@ -11,8 +11,10 @@
 #include <filesystem>
 #include <set>
 #include <sstream>
+#include <string>
 #include <vector>
 
+#include "smash/binaryreader.h"
 #include "smash/decaymodes.h"
 #include "smash/experiment.h"
 #include "smash/filelock.h"
@@ -73,6 +75,14 @@ namespace smash {
  *     integer. Note that this might cause races if several instances of SMASH
  *     run in parallel. In that case, make sure to specify a different output
  *     directory for every instance of SMASH.
+ * <tr><td>`-j <N>` <td>`--jobs <N>`
+ * <td>Evolves N events at the same time, each on its own thread. The
+ *     particle tables are shared by all threads, while every thread has its
+ *     own ensembles, modus and action finders. The output is written in the
+ *     order of the events and is identical to the one of a serial run with
+ *     the same random seed. This is not possible for the `List` and `ListBox`
+ *     modi, for custom nuclei, for forced thermalization and if the number of
+ *     events is given by `Minimum_Nonempty_Ensembles`.
  * <tr><td>`-l <dir>` <td>`--list-2-to-n <dir>`
  * <td>Dumps the list of all possible 2 &rarr; n reactions (n > 1). Note that
  *     resonance decays and formations are NOT dumped. Every particle
@@ -91,6 +101,11 @@ namespace smash {
  *     can be specified. The value of `plab1` depends on the order of the
  *     particles. The first particle is considered to be the projectile,
  *     the second one the target.
+ * <tr><td>`-b <file>` <td>`--index-binary <file>`
+ * <td>Writes the event index of a binary output file to `<file>.idx`, such
+ *     that smash::BinaryReader does not need to scan the file to find its
+ *     events. The index file is only used as long as the size of the output
+ *     file does not change.
  * <tr><td>`-f` <td>`--force`
  * <td>Forces overwriting files in the output directory.
  * <tr><td>`-S <pdg1>,<pdg2>[,mass1,mass2]`
@@ -147,6 +162,9 @@ void usage(const int rc, const std::string &progname) {
       "\n"
       "\n"
       "  -o, --output <dir>      output directory (default: ./data/<runid>)\n"
+      "  -j, --jobs <N>          evolve N events at the same time on N "
+      "threads\n"
+      "                          (the output is identical to a serial run)\n"
       "  -l, --list-2-to-n       list all possible 2->n reactions (with n>1)\n"
       "  -r, --resonance <pdg>   dump width(m) and m*spectral function(m^2)"
       " for resonance pdg\n"
@@ -168,6 +186,9 @@ void usage(const int rc, const std::string &progname) {
       "  -x, --dump_iSS          Dump particle table in iSS format\n"
       "                          This format is used in MUSIC and CLVisc\n"
       "                          relativistic hydro codes\n"
+      "  -b, --index-binary <file>\n"
+      "                          write the event index of a binary output "
+      "file\n"
       "  -q, --quiet             Supress disclaimer print-out\n"
       "  -n, --no-cache          Don't cache integrals on disk\n"
       "  -v, --version\n\n");
@@ -369,6 +390,7 @@ int main(int argc, char *argv[]) {
       {"modus", required_argument, 0, 'm'},
       {"particles", required_argument, 0, 'p'},
       {"output", required_argument, 0, 'o'},
+      {"jobs", required_argument, 0, 'j'},
       {"list-2-to-n", no_argument, 0, 'l'},
       {"resonance", required_argument, 0, 'r'},
       {"cross-sections", required_argument, 0, 's'},
@@ -377,6 +399,7 @@ int main(int argc, char *argv[]) {
       {"version", no_argument, 0, 'v'},
       {"no-cache", no_argument, 0, 'n'},
       {"quiet", no_argument, 0, 'q'},
+      {"index-binary", required_argument, 0, 'b'},
       {nullptr, 0, 0, 0}};
 
   // strip any path to progname
@@ -389,7 +412,7 @@ int main(int argc, char *argv[]) {
     std::string input_path("./config.yaml"), particles, decaymodes;
     std::vector<std::string> extra_config;
     char *modus = nullptr, *end_time = nullptr, *pdg_string = nullptr,
-         *cs_string = nullptr;
+         *cs_string = nullptr, *index_binary_file = nullptr;
     bool list2n_activated = false;
     bool resonance_dump_activated = false;
     bool cross_section_dump_activated = false;
@@ -397,12 +420,16 @@ int main(int argc, char *argv[]) {
     bool particles_dump_iSS_format = false;
     bool cache_integrals = true;
     bool suppress_disclaimer = false;
+    int n_event_threads = 1;
 
     // parse command-line arguments
     int opt;
-    while ((opt = getopt_long(argc, argv, "c:d:e:fhi:m:p:o:lr:s:S:xvnq",
+    while ((opt = getopt_long(argc, argv, "b:c:d:e:fhi:j:m:p:o:lr:s:S:xvnq",
                               longopts, nullptr)) != -1) {
       switch (opt) {
+        case 'b':
+          index_binary_file = optarg;
+          break;
         case 'c':
           extra_config.emplace_back(optarg);
           break;
@@ -430,6 +457,9 @@ int main(int argc, char *argv[]) {
         case 'o':
           output_path = optarg;
           break;
+        case 'j':
+          n_event_threads = std::stoi(optarg);
+          break;
         case 'l':
           list2n_activated = true;
           suppress_disclaimer = true;
@@ -484,6 +514,17 @@ int main(int argc, char *argv[]) {
       usage(EXIT_FAILURE, progname);
     }
 
+    if (index_binary_file) {
+      // The index is built from the output file, ignoring an old index file.
+      const BinaryReader reader(index_binary_file, false);
+      reader.write_index();
+      std::cout << "Indexed " << reader.n_events() << " events of "
+                << index_binary_file << " in "
+                << BinaryReader::index_path(index_binary_file).native()
+                << ".\n";
+      std::exit(EXIT_SUCCESS);
+    }
+
     if (!suppress_disclaimer) {
       print_disclaimer();
     }
@@ -670,7 +711,8 @@ int main(int argc, char *argv[]) {
 
     // Create an experiment
     logg[LMain].trace(SMASH_SOURCE_LOCATION, " create Experiment");
-    auto experiment = ExperimentBase::create(configuration, output_path);
+    auto experiment =
+        ExperimentBase::create(configuration, output_path, n_event_threads);
 
     // Version key is deprecated. If present, ignore it.
     if (configuration.has_value({"Version"})) {
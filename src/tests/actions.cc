@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2015,2017-2018,2020,2022
+ *    Copyright (c) 2015,2017-2018,2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -65,3 +65,58 @@ TEST(construct_and_insert) {
 
   VERIFY(actions.is_empty());
 }
+
+TEST(invalidate_actions_of_particles) {
+  Particles particles;
+  const ParticleData &a = particles.insert(Test::smashon_random());
+  const ParticleData &b = particles.insert(Test::smashon_random());
+  const ParticleData a_copy = a, b_copy = b;
+  Actions actions;
+  actions.insert(std::make_unique<DecayAction>(a_copy, 3.));
+  actions.insert(std::make_unique<DecayAction>(b_copy, 2.));
+  actions.insert(std::make_unique<DecayAction>(a_copy, 1.));
+  actions.insert(std::make_unique<DecayAction>(b_copy, 4.));
+  COMPARE(actions.size(), 4u);
+
+  // The first action of a is performed, so its other one becomes invalid
+  ActionPtr first = actions.pop();
+  COMPARE(first->incoming_particles()[0].id(), a_copy.id());
+  COMPARE(actions.invalidate(first->incoming_particles()), 1u);
+  COMPARE(actions.invalidate(first->incoming_particles()), 0u);
+  COMPARE(actions.size(), 2u);
+
+  // Only the actions of b are left, in the order of their times
+  COMPARE(actions.earliest_time(), b_copy.position().x0() + 2.);
+  COMPARE(actions.pop()->incoming_particles()[0].id(), b_copy.id());
+  COMPARE(actions.pop()->time_of_execution(), b_copy.position().x0() + 4.);
+  VERIFY(actions.is_empty());
+
+  // Actions of the same time are executed in the order of insertion
+  actions.insert(std::make_unique<DecayAction>(b_copy, 1.));
+  actions.insert(std::make_unique<DecayAction>(a_copy, 1.));
+  COMPARE(actions.pop()->incoming_particles()[0].id(), b_copy.id());
+  COMPARE(actions.pop()->incoming_particles()[0].id(), a_copy.id());
+}
+
+TEST(invalidate_many_actions) {
+  // Removed actions are dropped from the heap once they are the majority
+  Particles particles;
+  ParticleList copies;
+  for (int i = 0; i < 100; i++) {
+    copies.push_back(particles.insert(Test::smashon_random()));
+  }
+  Actions actions;
+  for (int repetition = 0; repetition < 10; repetition++) {
+    for (int i = 0; i < 100; i++) {
+      actions.insert(
+          std::make_unique<DecayAction>(copies[i], 0.01 * (100 - i) + 0.1));
+    }
+  }
+  COMPARE(actions.size(), 1000u);
+  COMPARE(actions.invalidate(ParticleList(copies.begin(), copies.end() - 1)),
+          990u);
+  COMPARE(actions.size(), 10u);
+  while (!actions.is_empty()) {
+    COMPARE(actions.pop()->incoming_particles()[0].id(), copies.back().id());
+  }
+}
@@ -0,0 +1,61 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/algorithms.h"
+
+#include <set>
+#include <vector>
+
+using namespace smash;
+
+TEST(combinations_of_three) {
+  const std::vector<char> elements = {'a', 'b', 'c', 'd'};
+  std::vector<std::vector<char>> combinations;
+  for_each_combination(elements, 3, [&](const std::vector<char> &c) {
+    combinations.push_back(c);
+  });
+  const std::vector<std::vector<char>> expected = {
+      {'a', 'b', 'c'}, {'a', 'b', 'd'}, {'a', 'c', 'd'}, {'b', 'c', 'd'}};
+  COMPARE(combinations, expected);
+}
+
+TEST(number_of_combinations) {
+  for (std::size_t n = 0; n <= 8; n++) {
+    std::vector<int> elements(n);
+    for (std::size_t i = 0; i < n; i++) {
+      elements[i] = i;
+    }
+    std::size_t binomial = 1;
+    for (std::size_t k = 1; k <= 6; k++) {
+      binomial = binomial * (n + 1 - k) / k;
+      std::set<std::vector<int>> seen;
+      std::size_t count = 0;
+      for_each_combination(elements, k, [&](const std::vector<int> &c) {
+        COMPARE(c.size(), k);
+        for (std::size_t i = 1; i < k; i++) {
+          VERIFY(c[i - 1] < c[i]);
+        }
+        seen.insert(c);
+        count++;
+      });
+      COMPARE(count, binomial) << "n = " << n << ", k = " << k;
+      COMPARE(seen.size(), count);
+    }
+  }
+}
+
+TEST(no_combinations) {
+  const std::vector<int> elements = {1, 2};
+  int calls = 0;
+  for_each_combination(elements, 0, [&](const std::vector<int> &) { calls++; });
+  for_each_combination(elements, 3, [&](const std::vector<int> &) { calls++; });
+  COMPARE(calls, 0);
+}
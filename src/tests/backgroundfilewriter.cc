@@ -0,0 +1,76 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/backgroundfilewriter.h"
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "smash/file.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+/// Write blocks of increasing size with the given budget and read them back
+static void write_and_compare(std::size_t memory_budget) {
+  const std::filesystem::path path =
+      testoutputpath / ("blocks_" + std::to_string(memory_budget) + ".bin");
+  std::string expected;
+  {
+    FilePtr file = fopen(path, "wb");
+    BackgroundFileWriter writer(file.get(), memory_budget);
+    for (int i = 0; i < 1000; i++) {
+      std::vector<char> block(i % 97);
+      for (std::size_t j = 0; j < block.size(); j++) {
+        block[j] = static_cast<char>(i + j);
+      }
+      expected.append(block.begin(), block.end());
+      writer.submit(std::move(block), i % 10 == 0);
+    }
+    writer.finish();
+  }
+  FilePtr file = fopen(path, "rb");
+  std::string content(expected.size() + 1, '\0');
+  COMPARE(std::fread(&content[0], 1, content.size(), file.get()),
+          expected.size());
+  content.resize(expected.size());
+  VERIFY(content == expected);
+}
+
+TEST(write_on_thread) { write_and_compare(256); }
+
+TEST(write_on_calling_thread) { write_and_compare(0); }
+
+TEST(block_larger_than_budget) { write_and_compare(16); }
+
+TEST(report_error) {
+  const std::filesystem::path path = testoutputpath / "read_only.bin";
+  fopen(path, "wb");
+  FilePtr file = fopen(path, "rb");
+  BackgroundFileWriter writer(file.get(), 1024);
+  writer.submit(std::vector<char>(100, 'x'), true);
+  bool thrown = false;
+  try {
+    writer.finish();
+  } catch (std::runtime_error &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+}
@@ -0,0 +1,131 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/binarycompression.h"
+
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace smash;
+
+static const BinaryCompression codecs[] = {
+    BinaryCompression::None, BinaryCompression::Builtin,
+    BinaryCompression::Zstd, BinaryCompression::LZ4};
+
+/// Compress and decompress data with all available codecs
+static void check_round_trip(const std::vector<char> &data) {
+  for (const BinaryCompression codec : codecs) {
+    if (!is_available(codec)) {
+      continue;
+    }
+    const std::vector<char> compressed =
+        compress_chunk(codec, data.data(), data.size());
+    std::vector<char> decompressed(data.size());
+    decompress_chunk(codec, compressed.data(), compressed.size(),
+                     decompressed.data(), decompressed.size());
+    VERIFY(decompressed == data) << codec;
+  }
+}
+
+TEST(always_available) {
+  VERIFY(is_available(BinaryCompression::None));
+  VERIFY(is_available(BinaryCompression::Builtin));
+}
+
+TEST(empty) { check_round_trip({}); }
+
+TEST(short_data) { check_round_trip({'S', 'M', 'S'}); }
+
+TEST(random_bytes) {
+  std::mt19937 engine(1);
+  std::vector<char> data(100000);
+  for (char &c : data) {
+    c = static_cast<char>(engine());
+  }
+  check_round_trip(data);
+}
+
+TEST(runs) {
+  // Long runs of a byte are stored as matches overlapping themselves.
+  std::vector<char> data(10000, 'p');
+  data.insert(data.end(), 5, 'i');
+  data.insert(data.end(), 10000, '\0');
+  check_round_trip(data);
+  const std::vector<char> compressed =
+      compress_chunk(BinaryCompression::Builtin, data.data(), data.size());
+  VERIFY(compressed.size() < 50u) << compressed.size();
+}
+
+TEST(repeated_records) {
+  // Records with few distinct values, like the particle lines of an event
+  std::mt19937 engine(2);
+  std::vector<char> data;
+  const double masses[] = {0.138, 0.938, 0.494};
+  const std::int32_t pdgs[] = {211, 2212, 321};
+  for (std::int32_t id = 0; id < 10000; id++) {
+    const int type = engine() % 3;
+    const double time = 100.;
+    const char *bytes = reinterpret_cast<const char *>(&time);
+    data.insert(data.end(), bytes, bytes + sizeof(time));
+    bytes = reinterpret_cast<const char *>(&masses[type]);
+    data.insert(data.end(), bytes, bytes + sizeof(double));
+    bytes = reinterpret_cast<const char *>(&pdgs[type]);
+    data.insert(data.end(), bytes, bytes + sizeof(std::int32_t));
+    bytes = reinterpret_cast<const char *>(&id);
+    data.insert(data.end(), bytes, bytes + sizeof(id));
+  }
+  check_round_trip(data);
+  const std::vector<char> compressed =
+      compress_chunk(BinaryCompression::Builtin, data.data(), data.size());
+  VERIFY(compressed.size() < data.size() / 2) << compressed.size();
+}
+
+TEST(corrupt_data) {
+  const std::vector<char> data(1000, 'f');
+  for (const BinaryCompression codec : codecs) {
+    if (!is_available(codec) || codec == BinaryCompression::None) {
+      continue;
+    }
+    const std::vector<char> compressed =
+        compress_chunk(codec, data.data(), data.size());
+    std::vector<char> out(data.size());
+    // A wrong size of the decompressed data
+    bool thrown = false;
+    try {
+      decompress_chunk(codec, compressed.data(), compressed.size(),
+                       out.data(), out.size() - 1);
+    } catch (std::runtime_error &) {
+      thrown = true;
+    }
+    VERIFY(thrown) << codec;
+    // Cut off data
+    thrown = false;
+    try {
+      decompress_chunk(codec, compressed.data(), compressed.size() / 2,
+                       out.data(), out.size());
+    } catch (std::runtime_error &) {
+      thrown = true;
+    }
+    VERIFY(thrown) << codec;
+  }
+}
+
+TEST(names) {
+  std::ostringstream names;
+  for (const BinaryCompression codec : codecs) {
+    names << codec << ' ';
+  }
+  COMPARE(names.str(), "None Builtin Zstd LZ4 ");
+}
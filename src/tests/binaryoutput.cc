@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2020,2022
+ *    Copyright (c) 2014-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -11,15 +11,18 @@
 
 #include "smash/binaryoutput.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
 #include "setup.h"
+#include "smash/binarycompression.h"
 #include "smash/clock.h"
 #include "smash/config.h"
 #include "smash/file.h"
@@ -517,3 +520,106 @@ TEST(initial_conditions_format) {
   }
   VERIFY(std::filesystem::remove(particleoutputpath));
 }
+
+/* Read a whole file */
+static std::vector<char> read_file(const std::filesystem::path &path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+}
+
+/* Read a value at a position of a buffer and move the position past it */
+template <typename T>
+static T read_value(const std::vector<char> &buffer, std::size_t &pos) {
+  T x;
+  VERIFY(pos + sizeof(T) <= buffer.size());
+  std::memcpy(&x, buffer.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return x;
+}
+
+/* Write three events of many particles to a particles output */
+static std::vector<char> write_particles_output(
+    const std::filesystem::path &directory, BinaryCompression compression) {
+  std::filesystem::create_directories(directory);
+  Particles particles;
+  for (int i = 0; i < 1000; i++) {
+    particles.insert(Test::smashon_random());
+  }
+  EventInfo event = Test::default_event_info();
+  {
+    OutputParameters output_par = OutputParameters();
+    output_par.part_only_final = OutputOnlyFinal::No;
+    // Written on the calling thread in blocks of 64 KiB
+    output_par.binary_buffer_size = 0;
+    output_par.binary_compression = compression;
+    BinaryOutputParticles bin_output(directory, "Particles", output_par);
+    for (int event_id = 0; event_id < 3; event_id++) {
+      bin_output.at_eventstart(particles, event_id, event);
+      bin_output.at_eventend(particles, event_id, event);
+    }
+  }
+  const std::vector<char> content =
+      read_file(directory / "particles_binary.bin");
+  std::filesystem::remove_all(directory);
+  return content;
+}
+
+TEST(compressed_format) {
+  const std::vector<char> uncompressed = write_particles_output(
+      testoutputpath / "uncompressed", BinaryCompression::None);
+  // magic number, format version, format variant and SMASH version
+  const std::size_t header_size = 12 + std::string(SMASH_VERSION).size();
+  for (const BinaryCompression compression :
+       {BinaryCompression::Builtin, BinaryCompression::Zstd,
+        BinaryCompression::LZ4}) {
+    if (!is_available(compression)) {
+      continue;
+    }
+    const std::vector<char> compressed =
+        write_particles_output(testoutputpath / "compressed", compression);
+
+    // Same header, with 2 added to the format variant
+    std::size_t pos = 6;
+    COMPARE(read_value<std::uint16_t>(compressed, pos), 2u);
+    VERIFY(std::equal(compressed.begin() + pos,
+                      compressed.begin() + header_size,
+                      uncompressed.begin() + pos));
+    pos = header_size;
+
+    // The chunks decompress to the records of the uncompressed file.
+    std::vector<char> records;
+    std::vector<std::size_t> offsets;
+    while (compressed.at(pos) == 'c') {
+      offsets.push_back(pos);
+      pos++;
+      const auto codec = static_cast<BinaryCompression>(
+          read_value<std::uint8_t>(compressed, pos));
+      VERIFY(codec == compression || codec == BinaryCompression::None);
+      const auto compressed_size = read_value<std::uint32_t>(compressed, pos);
+      const auto uncompressed_size = read_value<std::uint32_t>(compressed, pos);
+      VERIFY(pos + compressed_size <= compressed.size());
+      records.resize(records.size() + uncompressed_size);
+      decompress_chunk(codec, compressed.data() + pos, compressed_size,
+                       records.data() + records.size() - uncompressed_size,
+                       uncompressed_size);
+      pos += compressed_size;
+    }
+    VERIFY(std::equal(records.begin(), records.end(),
+                      uncompressed.begin() + header_size, uncompressed.end()));
+
+    /* Each event has a chunk for each of its two particle blocks, which are
+     * larger than the 64 KiB of a chunk. */
+    const std::size_t index_offset = pos;
+    COMPARE(compressed.at(pos++), 'x');
+    COMPARE(read_value<std::uint32_t>(compressed, pos), 6u);
+    for (std::uint32_t i = 0; i < 6; i++) {
+      COMPARE(read_value<std::uint64_t>(compressed, pos), offsets[i]);
+      read_value<std::uint32_t>(compressed, pos);
+      read_value<std::uint32_t>(compressed, pos);
+      COMPARE(read_value<std::uint32_t>(compressed, pos), i / 2);
+    }
+    COMPARE(read_value<std::uint64_t>(compressed, pos), index_offset);
+    COMPARE(std::string(compressed.begin() + pos, compressed.end()), "SIDX");
+  }
+}
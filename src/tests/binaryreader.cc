@@ -0,0 +1,235 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/binaryreader.h"
+
+#include <atomic>
+#include <filesystem>
+#include <vector>
+
+#include "setup.h"
+#include "smash/binarycompression.h"
+#include "smash/binaryoutput.h"
+#include "smash/config.h"
+#include "smash/outputinterface.h"
+#include "smash/scatteraction.h"
+#include "smash/scatteractionsfinderparameters.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST(init_particletypes) { Test::create_smashon_particletypes(); }
+
+/* Compare a particle with its view in a binary file */
+static void compare_particle(const ParticleData &p, BinaryParticleView view) {
+  COMPARE(view.position(), p.position());
+  COMPARE(view.mass(), p.effective_mass());
+  COMPARE(view.momentum(), p.momentum());
+  COMPARE(view.pdg(), p.pdgcode().get_decimal());
+  COMPARE(view.id(), p.id());
+  COMPARE(view.charge(), p.type().charge());
+  if (view.extended()) {
+    const HistoryData history = p.get_history();
+    COMPARE(view.ncoll(), history.collisions_per_particle);
+    COMPARE(view.formation_time(), p.formation_time());
+    COMPARE(view.xsec_scaling_factor(), p.xsec_scaling_factor());
+    COMPARE(view.process_id_origin(), history.id_process);
+    COMPARE(view.process_type_origin(),
+            static_cast<std::int32_t>(history.process_type));
+    COMPARE(view.time_last_collision(), history.time_last_collision);
+    COMPARE(view.pdg_mother1(), history.p1.get_decimal());
+    COMPARE(view.pdg_mother2(), history.p2.get_decimal());
+    COMPARE(view.baryon_number(), p.type().baryon_number());
+  }
+}
+
+TEST(particles_output) {
+  Particles particles;
+  for (int i = 0; i < 1000; i++) {
+    particles.insert(Test::smashon_random());
+  }
+  const ParticleList list = particles.copy_to_vector();
+  const std::filesystem::path file = testoutputpath / "particles_binary.bin";
+  for (const BinaryCompression compression :
+       {BinaryCompression::None, BinaryCompression::Builtin}) {
+    for (const bool extended : {false, true}) {
+      {
+        OutputParameters output_par = OutputParameters();
+        output_par.part_extended = extended;
+        output_par.part_only_final = OutputOnlyFinal::No;
+        // Written in blocks of 64 KiB, such that events have several chunks
+        output_par.binary_buffer_size = 0;
+        output_par.binary_compression = compression;
+        BinaryOutputParticles bin_output(testoutputpath, "Particles",
+                                         output_par);
+        for (int event_id = 0; event_id < 5; event_id++) {
+          EventInfo event = Test::default_event_info(0.5 * event_id);
+          bin_output.at_eventstart(particles, event_id, event);
+          bin_output.at_eventend(particles, event_id, event);
+        }
+      }
+
+      BinaryReader reader(file);
+      VERIFY(!reader.index_loaded());
+      COMPARE(reader.format_version(), 8u);
+      COMPARE(reader.extended(), extended);
+      COMPARE(reader.compressed(), compression != BinaryCompression::None);
+      COMPARE(reader.smash_version(), SMASH_VERSION);
+      COMPARE(reader.n_events(), 5u);
+
+      // Random access to a single event
+      const BinaryEvent event = reader.event(3);
+      COMPARE(event.index(), 3u);
+      COMPARE(event.number(), 3);
+      COMPARE(event.impact_parameter(), 1.5);
+      VERIFY(!event.empty_event());
+      COMPARE(event.blocks().size(), 2u);
+      for (const BinaryBlock &block : event.blocks()) {
+        COMPARE(block.type, 'p');
+        COMPARE(block.particles.size(), list.size());
+        std::size_t i = 0;
+        for (BinaryParticleView view : block.particles) {
+          compare_particle(list[i++], view);
+        }
+      }
+
+      // All events in parallel
+      std::vector<std::atomic<int>> seen(5);
+      std::atomic<int> mismatches{0};
+      reader.for_each_event(
+          [&](const BinaryEvent &e) {
+            seen.at(e.number())++;
+            if (e.blocks().back().particles[999].id() != list[999].id()) {
+              mismatches++;
+            }
+          },
+          3);
+      for (const std::atomic<int> &count : seen) {
+        COMPARE(count.load(), 1);
+      }
+      COMPARE(mismatches.load(), 0);
+
+      // The index file is used instead of scanning the output.
+      reader.write_index();
+      BinaryReader indexed(file);
+      VERIFY(indexed.index_loaded());
+      COMPARE(indexed.n_events(), 5u);
+      COMPARE(indexed.event(4).number(), 4);
+
+      std::filesystem::remove(BinaryReader::index_path(file));
+      std::filesystem::remove(file);
+    }
+  }
+}
+
+TEST(collisions_output) {
+  Particles particles;
+  const ParticleData p1 = particles.insert(Test::smashon_random());
+  const ParticleData p2 = particles.insert(Test::smashon_random());
+  ScatterActionPtr action = std::make_unique<ScatterAction>(p1, p2, 0.);
+  action->add_all_scatterings(Test::default_finder_parameters());
+  action->generate_final_state();
+  const ParticleList final_particles = action->outgoing_particles();
+  const double rho = 0.123;
+  EventInfo event = Test::default_event_info(1.473, false);
+
+  const std::filesystem::path file = testoutputpath / "collisions_binary.bin";
+  {
+    OutputParameters output_par = OutputParameters();
+    output_par.coll_printstartend = true;
+    BinaryOutputCollisions bin_output(testoutputpath, "Collisions",
+                                      output_par);
+    bin_output.at_eventstart(particles, 0, event);
+    bin_output.at_interaction(*action, rho);
+    action->perform(&particles, 1);
+    bin_output.at_eventend(particles, 0, event);
+  }
+
+  BinaryReader reader(file);
+  COMPARE(reader.n_events(), 1u);
+  const BinaryEvent read_event = reader.event(0);
+  COMPARE(read_event.impact_parameter(), 1.473);
+  const std::vector<BinaryBlock> &blocks = read_event.blocks();
+  COMPARE(blocks.size(), 3u);
+  COMPARE(blocks[0].type, 'p');
+  compare_particle(p1, blocks[0].particles[0]);
+  compare_particle(p2, blocks[0].particles[1]);
+
+  const BinaryBlock &interaction = blocks[1];
+  COMPARE(interaction.type, 'i');
+  VERIFY(interaction.particles.empty());
+  COMPARE(interaction.incoming.size(), 2u);
+  COMPARE(interaction.outgoing.size(), 2u);
+  COMPARE(interaction.density, rho);
+  COMPARE(interaction.total_weight, action->get_total_weight());
+  COMPARE(interaction.partial_weight, action->get_partial_weight());
+  COMPARE(interaction.process_type,
+          static_cast<std::uint32_t>(action->get_type()));
+  compare_particle(p1, interaction.incoming[0]);
+  compare_particle(p2, interaction.incoming[1]);
+  compare_particle(final_particles[0], interaction.outgoing[0]);
+  compare_particle(final_particles[1], interaction.outgoing[1]);
+
+  COMPARE(blocks[2].type, 'p');
+  compare_particle(final_particles[0], blocks[2].particles[0]);
+  compare_particle(final_particles[1], blocks[2].particles[1]);
+  std::filesystem::remove(file);
+}
+
+TEST(incomplete_file) {
+  const std::filesystem::path file = testoutputpath / "particles_binary.bin";
+  const auto particles =
+      Test::create_particles(3, [] { return Test::smashon_random(); });
+  {
+    OutputParameters output_par = OutputParameters();
+    BinaryOutputParticles bin_output(testoutputpath, "Particles", output_par);
+    for (int event_id = 0; event_id < 2; event_id++) {
+      bin_output.at_eventend(*particles, event_id, Test::default_event_info());
+    }
+  }
+  // Cut off the end of the last event, as if SMASH had been stopped.
+  std::filesystem::resize_file(file, std::filesystem::file_size(file) - 20);
+  BinaryReader reader(file);
+  COMPARE(reader.n_events(), 1u);
+  COMPARE(reader.event(0).blocks()[0].particles.size(), 3u);
+  std::filesystem::remove(file);
+}
+
+TEST(unfinished_compressed_event) {
+  const std::filesystem::path file = testoutputpath / "particles_binary.bin";
+  const auto particles =
+      Test::create_particles(3, [] { return Test::smashon_random(); });
+  {
+    OutputParameters output_par = OutputParameters();
+    output_par.part_only_final = OutputOnlyFinal::No;
+    output_par.binary_compression = BinaryCompression::Builtin;
+    BinaryOutputParticles bin_output(testoutputpath, "Particles", output_par);
+    for (int event_id = 0; event_id < 2; event_id++) {
+      const EventInfo event = Test::default_event_info();
+      bin_output.at_eventstart(*particles, event_id, event);
+      bin_output.at_eventend(*particles, event_id, event);
+    }
+    // The output is destroyed during the last event, which is flushed.
+    bin_output.at_eventstart(*particles, 2, Test::default_event_info());
+  }
+  BinaryReader reader(file);
+  VERIFY(reader.compressed());
+  COMPARE(reader.n_events(), 2u);
+  COMPARE(reader.event(1).number(), 1);
+  std::filesystem::remove(file);
+}
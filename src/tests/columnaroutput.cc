@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/columnaroutput.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "setup.h"
+#include "smash/config.h"
+#include "smash/density.h"
+#include "smash/particles.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST(init_particletypes) { Test::create_smashon_particletypes(); }
+
+/* Compare the columns of a snapshot with the particles */
+static void compare_snapshot(const ColumnarReader &reader, std::size_t index,
+                             const ParticleList &particles) {
+  COMPARE(reader.snapshot(index).n_particles, particles.size());
+  const auto t = reader.column<double>(index, "t");
+  const auto z = reader.column<double>(index, "z");
+  const auto mass = reader.column<double>(index, "mass");
+  const auto px = reader.column<double>(index, "px");
+  const auto pz = reader.column<double>(index, "pz");
+  const auto pdg = reader.column<std::int32_t>(index, "pdg");
+  const auto id = reader.column<std::int32_t>(index, "id");
+  const auto charge = reader.column<std::int32_t>(index, "charge");
+  const auto xsecfac = reader.column<double>(index, "xsecfac");
+  const auto baryon_number =
+      reader.column<std::int32_t>(index, "baryon_number");
+  for (const auto *column : {t.data(), pz.data(), xsecfac.data()}) {
+    COMPARE(reinterpret_cast<std::uintptr_t>(column) % columnar::alignment,
+            0u);
+  }
+  for (std::size_t i = 0; i < particles.size(); i++) {
+    const ParticleData &p = particles[i];
+    COMPARE(t[i], p.position().x0());
+    COMPARE(z[i], p.position().x3());
+    COMPARE(mass[i], p.effective_mass());
+    COMPARE(px[i], p.momentum().x1());
+    COMPARE(pz[i], p.momentum().x3());
+    COMPARE(pdg[i], p.pdgcode().get_decimal());
+    COMPARE(id[i], p.id());
+    COMPARE(charge[i], p.type().charge());
+    COMPARE(xsecfac[i], p.xsec_scaling_factor());
+    COMPARE(baryon_number[i], p.type().baryon_number());
+  }
+}
+
+TEST(columnar_format) {
+  const auto particles =
+      Test::create_particles(5, [] { return Test::smashon_random(); });
+  const double impact_parameter = 2.5;
+  EventInfo event = Test::default_event_info(impact_parameter, false);
+  const ParticleList initial_particles = particles->copy_to_vector();
+  ParticleList intermediate_particles, final_particles;
+
+  const std::filesystem::path path =
+      testoutputpath / "particles_columnar.bin";
+  {
+    OutputParameters output_par = OutputParameters();
+    output_par.part_extended = true;
+    output_par.part_only_final = OutputOnlyFinal::No;
+    ColumnarOutput output(testoutputpath, "Particles", output_par);
+
+    for (int event_id = 0; event_id < 2; event_id++) {
+      output.at_eventstart(*particles, event_id, event);
+      DensityParameters dens_par(Test::default_parameters());
+      if (event_id == 0) {
+        ParticleList final_state = {Test::smashon_random()};
+        particles->replace({particles->copy_to_vector()[0]}, final_state);
+        intermediate_particles = particles->copy_to_vector();
+        output.at_intermediate_time(*particles, nullptr, dens_par, event);
+      }
+      final_particles = particles->copy_to_vector();
+      output.at_eventend(*particles, event_id, event);
+    }
+  }
+  VERIFY(std::filesystem::exists(path));
+
+  ColumnarReader reader(path.native());
+  COMPARE(reader.smash_version(), SMASH_VERSION);
+  COMPARE(reader.columns().size(), 21u);
+  VERIFY(reader.has_column("pdg_mother2"));
+  VERIFY(!reader.has_column("rapidity"));
+  COMPARE(reader.n_snapshots(), 5u);
+  const columnar::SnapshotKind kinds[] = {
+      columnar::SnapshotKind::EventStart, columnar::SnapshotKind::Intermediate,
+      columnar::SnapshotKind::EventEnd, columnar::SnapshotKind::EventStart,
+      columnar::SnapshotKind::EventEnd};
+  for (std::size_t i = 0; i < reader.n_snapshots(); i++) {
+    VERIFY(reader.snapshot(i).kind == kinds[i]);
+    COMPARE(reader.snapshot(i).event, i < 3 ? 0 : 1);
+    COMPARE(reader.snapshot(i).impact_parameter, impact_parameter);
+    COMPARE(reader.snapshot(i).empty_event, 0u);
+  }
+  COMPARE(reader.snapshots_of_event(1), (std::vector<std::size_t>{3, 4}));
+  compare_snapshot(reader, 0, initial_particles);
+  compare_snapshot(reader, 1, intermediate_particles);
+  compare_snapshot(reader, 2, final_particles);
+  compare_snapshot(reader, 4, final_particles);
+
+  // Columns are requested with their type.
+  bool thrown = false;
+  try {
+    reader.column<double>(0, "pdg");
+  } catch (std::invalid_argument &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+}
+
+TEST(incomplete_file) {
+  const std::filesystem::path path = testoutputpath / "incomplete.bin";
+  {
+    FilePtr file = fopen(path, "wb");
+    const char data[100] = "SMASHCOL";
+    std::fwrite(data, 1, sizeof(data), file.get());
+  }
+  bool thrown = false;
+  try {
+    ColumnarReader reader(path.native());
+  } catch (std::runtime_error &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+}
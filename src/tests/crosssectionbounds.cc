@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/crosssectionbounds.h"
+
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "setup.h"
+
+using namespace smash;
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "σ " +
+      std::to_string(Test::smashon_mass) +
+      " 0.0 + 661\n"
+      "π 0.138 0.0 - 111\n"
+      "η' 0.95778 0.000196 - 331\n");
+}
+
+/// Cross section [mb] growing with sqrt(s), for which the bounds are known
+static double rising_cross_section(double sqrts) { return 10. * (1. + sqrts); }
+
+TEST(bound_of_pair) {
+  int n_calls = 0;
+  CrossSectionBounds bounds(
+      [&n_calls](const ParticleType &, const ParticleType &, double sqrts) {
+        n_calls++;
+        return rising_cross_section(sqrts);
+      });
+  // On-shell smashons with sqrt(s) = 0.41 GeV
+  const ParticleData a = Test::smashon(Test::Momentum{0.205, 0., 0., 0.164},
+                                       Test::Position{0., 0., 0., 0.});
+  const ParticleData b = Test::smashon(Test::Momentum{0.205, 0., 0., -0.164},
+                                       Test::Position{0., 0., 1., 0.});
+  const double sqrts = (a.momentum() + b.momentum()).abs();
+  const double bound = bounds.upper_bound(a, b);
+  VERIFY(bound >= rising_cross_section(sqrts));
+  const double bin_end = sqrts + CrossSectionBounds::bin_width;
+  VERIFY(bound <=
+         CrossSectionBounds::safety_factor * rising_cross_section(bin_end));
+  COMPARE(n_calls, CrossSectionBounds::n_samples + 1);
+
+  // The bin is only evaluated once
+  COMPARE(bounds.upper_bound(b, a), bound);
+  COMPARE(bounds.upper_bound(a, b), bound);
+  COMPARE(n_calls, CrossSectionBounds::n_samples + 1);
+}
+
+/* A particle of the given type at rest and one of the other type moving
+ * towards it, such that they have the given sqrt(s) */
+static std::pair<ParticleData, ParticleData> pair_at(const ParticleType &a,
+                                                     const ParticleType &b,
+                                                     double sqrts) {
+  const double ma = a.mass(), mb = b.mass();
+  const double p_cm = std::sqrt((sqrts * sqrts - (ma + mb) * (ma + mb)) *
+                                (sqrts * sqrts - (ma - mb) * (ma - mb))) /
+                      (2. * sqrts);
+  ParticleData data_a{a}, data_b{b};
+  data_a.set_4momentum(ma, 0., 0., p_cm);
+  data_b.set_4momentum(mb, 0., 0., -p_cm);
+  return {data_a, data_b};
+}
+
+TEST(swapped_pair_shares_bins) {
+  int n_calls = 0;
+  CrossSectionBounds bounds([&n_calls](const ParticleType &a,
+                                       const ParticleType &b, double sqrts) {
+    n_calls++;
+    // Always evaluated in the same order
+    VERIFY(a.pdgcode() == 0x661 || b.pdgcode() == 0x661);
+    return rising_cross_section(sqrts);
+  });
+  const auto pair = pair_at(ParticleType::find(0x661),
+                            ParticleType::find(0x111), 0.5);
+  const double bound = bounds.upper_bound(pair.first, pair.second);
+  COMPARE(bounds.upper_bound(pair.second, pair.first), bound);
+  COMPARE(n_calls, CrossSectionBounds::n_samples + 1);
+}
+
+TEST(narrow_peak) {
+  /* A peak at the eta' mass, much narrower than the distance between two
+   * samples of a bin, such that it is only found at the pole mass. */
+  const double pole = ParticleType::find(0x331).mass();
+  const double half_width = 0.5 * ParticleType::find(0x331).width_at_pole();
+  auto peak = [&](double sqrts) {
+    const double x = (sqrts - pole) / half_width;
+    return 100. / (1. + x * x);
+  };
+  CrossSectionBounds bounds(
+      [&](const ParticleType &, const ParticleType &, double sqrts) {
+        return peak(sqrts);
+      });
+  const auto pair = pair_at(ParticleType::find(0x661),
+                            ParticleType::find(0x111), pole - 0.0004);
+  VERIFY(bounds.upper_bound(pair.first, pair.second) >= peak(pole));
+}
+
+TEST(no_bound) {
+  CrossSectionBounds bounds(
+      [](const ParticleType &, const ParticleType &, double sqrts) {
+        return rising_cross_section(sqrts);
+      });
+  const ParticleData a = Test::smashon(Test::Momentum{0.205, 0., 0., 0.164},
+                                       Test::Position{0., 0., 0., 0.});
+  // Off-shell particles are not bounded.
+  const ParticleData off_shell = Test::smashon(
+      Test::Momentum{0.3, 0., 0., -0.164}, Test::Position{0., 0., 1., 0.});
+  VERIFY(std::isinf(bounds.upper_bound(a, off_shell)));
+  // Energies beyond the tabulated range are not bounded.
+  const double p = 4000.;
+  const double energy = std::sqrt(p * p + Test::smashon_mass *
+                                              Test::smashon_mass);
+  const ParticleData fast = Test::smashon(Test::Momentum{energy, 0., 0., -p},
+                                          Test::Position{0., 0., 1., 0.});
+  VERIFY(std::isinf(bounds.upper_bound(a, fast)));
+}
@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "setup.h"
+#include "smash/crosssectionbounds.h"
+#include "smash/scatteractionsfinder.h"
+
+using namespace smash;
+
+TEST(init_particle_types) {
+  Test::create_actual_particletypes();
+  Test::create_actual_decaymodes();
+  ParticleType::check_consistency();
+  sha256::Hash hash;
+  hash.fill(0);
+  IsoParticleType::tabulate_integrals(hash, "");
+}
+
+/* Two particles of the given types on their mass shell, which collide back to
+ * back with the given sqrt(s) */
+static std::pair<ParticleData, ParticleData> pair_at(const ParticleType &a,
+                                                     const ParticleType &b,
+                                                     double sqrts) {
+  const double p_cm = pCM(sqrts, a.mass(), b.mass());
+  ParticleData data_a{a}, data_b{b};
+  data_a.set_4momentum(a.mass(), 0., 0., p_cm);
+  data_b.set_4momentum(b.mass(), 0., 0., -p_cm);
+  return {data_a, data_b};
+}
+
+TEST(bounds_of_actual_cross_sections) {
+  /* The bounds are not proven, but rely on the cross sections varying little
+   * between the samples of a bin, apart from resonance peaks. This checks them
+   * for the cross sections of SMASH, with strings, for pairs of stable
+   * particles covering the main kinds of reactions. */
+  Configuration config{""};
+  ExperimentParameters exp_par = Test::default_parameters();
+  exp_par.strings_switch = true;
+  exp_par.nnbar_treatment = NNbarTreatment::Strings;
+  const ScatterActionsFinder finder(config, exp_par);
+  const CrossSectionBounds bounds(
+      [&finder](const ParticleType &a, const ParticleType &b, double sqrts) {
+        return finder.total_cross_section(a, b, sqrts);
+      });
+  const std::vector<std::pair<int, int>> pairs = {
+      {0x211, 0x2212},  {-0x211, 0x2212}, {0x111, 0x2112},  {0x2212, 0x2212},
+      {0x2212, 0x2112}, {0x2212, -0x2212}, {0x211, -0x211}, {0x111, 0x111},
+      {-0x321, 0x2212}, {0x321, 0x2212},  {0x321, -0x321},  {0x221, 0x2212},
+      {-0x211, 0x3122}};
+  for (const auto &[pdg_a, pdg_b] : pairs) {
+    const ParticleType &a = ParticleType::find(pdg_a);
+    const ParticleType &b = ParticleType::find(pdg_b);
+    const double threshold = a.mass() + b.mass();
+    /* Midway between the samples of the bins, where a smooth cross section
+     * deviates most from them, and beyond the largest resonance masses
+     * more coarsely. */
+    const double sample_distance =
+        CrossSectionBounds::bin_width / CrossSectionBounds::n_samples;
+    std::vector<double> energies;
+    for (double sqrts = threshold + 0.5 * sample_distance;
+         sqrts < threshold + 2.; sqrts += sample_distance) {
+      energies.push_back(sqrts);
+    }
+    for (double sqrts = threshold + 2. + 0.5 * sample_distance;
+         sqrts < threshold + 10.; sqrts += 5. * sample_distance) {
+      energies.push_back(sqrts);
+    }
+    // Finely around the peaks of resonances narrower than the samples
+    for (const ParticleType &resonance : ParticleType::list_all()) {
+      const double width = resonance.width_at_pole();
+      if (resonance.is_stable() || width > 5. * sample_distance) {
+        continue;
+      }
+      for (int i = -30; i <= 30; i++) {
+        const double sqrts = resonance.mass() + 0.1 * i * width;
+        if (sqrts > threshold) {
+          energies.push_back(sqrts);
+        }
+      }
+    }
+    for (const double sqrts : energies) {
+      const auto [data_a, data_b] = pair_at(a, b, sqrts);
+      const double cross_section = finder.total_cross_section(a, b, sqrts);
+      const double bound = bounds.upper_bound(data_a, data_b);
+      VERIFY(cross_section <= bound)
+          << a.name() << b.name() << " at sqrt(s) = " << sqrts
+          << " GeV: " << cross_section << " mb > " << bound << " mb";
+    }
+  }
+}
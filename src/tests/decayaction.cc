@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2015-2020,2022
+ *    Copyright (c) 2015-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -14,7 +14,9 @@
 #include <typeinfo>
 
 #include "setup.h"
+#include "smash/decayactionsfinder.h"
 #include "smash/decaymodes.h"
+#include "smash/random.h"
 
 using namespace smash;
 
@@ -125,3 +127,52 @@ TEST(create_decayaction) {
   const auto act = std::make_unique<DecayAction>(H, time_of_execution);
   std::cout << *act << std::endl;
 }
+
+TEST(total_width_like_partial_widths) {
+  const ParticleType &H = ParticleType::find(0x50661);
+  const ParticleType &A3 = ParticleType::find(0x30661);
+  ParticleType::tabulate_decay_widths();
+  for (ParticleTypePtr type : {&H, &A3}) {
+    for (double m = 1.05; m < 8.; m += 0.173) {
+      const FourVector p(std::sqrt(m * m + 1.), 0., 0., 1.);
+      const ThreeVector x;
+      const double width = total_weight<DecayBranch>(
+          type->get_partial_widths(p, x, WhichDecaymodes::Hadronic));
+      // The exact total width is the same sum of the partial widths
+      COMPARE(type->get_total_width(p, x, WhichDecaymodes::Hadronic), width);
+      COMPARE_RELATIVE_ERROR(
+          type->get_total_width(p, x, WhichDecaymodes::Hadronic, true), width,
+          1.e-3)
+          << type->name() << " m = " << m;
+    }
+  }
+}
+
+TEST(persistent_decay_times) {
+  random::set_seed(random::generate_63bit_seed());
+  Particles particles;
+  ParticleData &H = particles.create(0x50661);
+  H.set_4position(FourVector(2., 0., 0., 0.));
+  H.set_4momentum(H.type().mass(), 1., 0., 0.);
+  VERIFY(std::isnan(H.scheduled_decay_time()));
+
+  const DecayActionsFinder finder(1., false);
+  finder.schedule_decays(particles);
+  const double decay_time = H.scheduled_decay_time();
+  VERIFY(decay_time >= 2.);
+  // The decay time is kept until the particle decays
+  finder.schedule_decays(particles);
+  COMPARE(H.scheduled_decay_time(), decay_time);
+
+  const ParticleList search_list = particles.copy_to_vector();
+  const double dt = decay_time - 2.;
+  COMPARE(finder.find_actions_in_cell(search_list, dt, 0., {}).size(), 0u);
+  const ActionList actions =
+      finder.find_actions_in_cell(search_list, 2. * dt + 1., 0., {});
+  COMPARE(actions.size(), 1u);
+  COMPARE_ABSOLUTE_ERROR(actions[0]->time_of_execution(), decay_time, 1e-12);
+
+  // A new momentum needs a new decay time
+  H.set_4momentum(H.type().mass(), 0., 1., 0.);
+  VERIFY(std::isnan(H.scheduled_decay_time()));
+}
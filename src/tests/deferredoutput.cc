@@ -0,0 +1,152 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/deferredoutput.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "setup.h"
+
+using namespace smash;
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+/// Output remembering the event numbers and particle numbers it was given.
+class EventStartOutput : public OutputInterface {
+ public:
+  EventStartOutput() : OutputInterface("Particles") {}
+
+  void at_eventstart(const Particles &particles, const int event_number,
+                     const EventInfo &) override {
+    events.push_back(event_number);
+    sizes.push_back(particles.size());
+  }
+
+  /// Event numbers of the calls
+  std::vector<int> events;
+  /// Number of particles of the calls
+  std::vector<int> sizes;
+};
+
+TEST(deferred_calls_use_copies) {
+  EventStartOutput target;
+  DeferredOutput deferred(target);
+  Particles particles;
+  particles.create(3, 0x661);
+  deferred.at_eventstart(particles, 7, EventInfo{});
+  particles.create(2, 0x661);
+  COMPARE(target.events.size(), 0u);
+
+  deferred.flush();
+  COMPARE(target.events, std::vector<int>{7});
+  COMPARE(target.sizes, std::vector<int>{3});
+  // Flushing forgets the calls
+  deferred.flush();
+  COMPARE(target.events.size(), 1u);
+}
+
+TEST(sequencer_writes_in_event_order) {
+  EventStartOutput target;
+  OutputSequencer sequencer;
+  Particles particles;
+  auto record_event = [&](int event) {
+    DeferredOutput deferred(target);
+    deferred.at_eventstart(particles, event, EventInfo{});
+    return deferred.take_calls();
+  };
+  sequencer.submit(2, record_event(2));
+  sequencer.submit(1, record_event(1));
+  COMPARE(target.events.size(), 0u);
+  sequencer.submit(0, record_event(0));
+  COMPARE(target.events, (std::vector<int>{0, 1, 2}));
+  sequencer.submit(3, record_event(3));
+  COMPARE(target.events, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST(sequencer_with_threads) {
+  constexpr int n_threads = 4;
+  constexpr int n_events = 400;
+  EventStartOutput target;
+  OutputSequencer sequencer;
+  std::vector<std::thread> threads;
+  for (int i_thread = 0; i_thread < n_threads; i_thread++) {
+    threads.emplace_back([&, i_thread]() {
+      Particles particles;
+      DeferredOutput deferred(target);
+      for (int event = i_thread; event < n_events; event += n_threads) {
+        particles.create(1, 0x661);
+        deferred.at_eventstart(particles, event, EventInfo{});
+        sequencer.submit(event, deferred.take_calls());
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  COMPARE(target.events.size(), static_cast<size_t>(n_events));
+  for (int event = 0; event < n_events; event++) {
+    COMPARE(target.events[event], event);
+    COMPARE(target.sizes[event], event / n_threads + 1);
+  }
+}
+
+TEST(sequencer_keeps_few_events) {
+  constexpr int n_threads = 4;
+  constexpr int n_events = 200;
+  constexpr int max_ahead = 6;
+  EventStartOutput target;
+  OutputSequencer sequencer(0, max_ahead);
+  std::mutex max_pending_mutex;
+  std::size_t max_pending = 0;
+  std::vector<std::thread> threads;
+  for (int i_thread = 0; i_thread < n_threads; i_thread++) {
+    threads.emplace_back([&, i_thread]() {
+      Particles particles;
+      DeferredOutput deferred(target);
+      for (int event = i_thread; event < n_events; event += n_threads) {
+        // The first thread is slow, the others would run far ahead.
+        if (i_thread == 0) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        deferred.at_eventstart(particles, event, EventInfo{});
+        sequencer.submit(event, deferred.take_calls());
+        std::lock_guard<std::mutex> lock(max_pending_mutex);
+        max_pending = std::max(max_pending, sequencer.n_pending());
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  COMPARE(target.events.size(), static_cast<size_t>(n_events));
+  for (int event = 0; event < n_events; event++) {
+    COMPARE(target.events[event], event);
+  }
+  VERIFY(max_pending <= max_ahead);
+}
+
+TEST(cancelled_sequencer_does_not_wait) {
+  EventStartOutput target;
+  OutputSequencer sequencer(0, 1);
+  Particles particles;
+  std::thread waiting([&]() {
+    DeferredOutput deferred(target);
+    deferred.at_eventstart(particles, 5, EventInfo{});
+    sequencer.submit(5, deferred.take_calls());
+  });
+  sequencer.cancel();
+  waiting.join();
+  COMPARE(target.events.size(), 0u);
+}
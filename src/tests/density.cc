@@ -20,6 +20,7 @@
 #include "smash/experiment.h"
 #include "smash/modusdefault.h"
 #include "smash/nucleus.h"
+#include "smash/threadpool.h"
 #include "smash/thermodynamicoutput.h"
 
 using namespace smash;
@@ -184,6 +185,216 @@ TEST(smearing_factor_rcut_correction) {
   FUZZY_COMPARE(smearing_factor_rcut_correction(4.0), 0.99886601571021467);
 }
 
+TEST(gaussian_smearing_table) {
+  const DensityParameters par(smash::Test::default_parameters());
+  DensityLattice lat({10., 12., 14.}, {20, 17, 14}, {-5., -6., -7.}, false,
+                     LatticeUpdate::EveryTimestep);
+  const double mass = 0.938;
+  GaussianSmearingTable table;
+  // from particles at rest to strongly boosted ones
+  for (double boost : {0., 0.5, 5., 50.}) {
+    for (int i = 0; i < 20; i++) {
+      const ThreeVector pos(random::uniform(-3., 3.), random::uniform(-3., 3.),
+                            random::uniform(-3., 3.));
+      const ThreeVector mom =
+          boost * mass *
+          ThreeVector(random::uniform(-1., 1.), random::uniform(-1., 1.),
+                      random::uniform(-1., 1.));
+      const FourVector p(std::sqrt(mass * mass + mom.sqr()), mom);
+      const auto bounds =
+          lat.rectangle_bounds(pos, {par.r_cut(), par.r_cut(), par.r_cut()});
+      table.prepare(bounds.first, bounds.second, lat.origin(),
+                    lat.cell_sizes(), pos, p, 1. / mass, par);
+      lat.iterate_in_cube(
+          pos, par.r_cut(), [&](DensityOnLattice &, int ix, int iy, int iz) {
+            const auto expected = unnormalized_smearing_factor(
+                pos - lat.cell_center(ix, iy, iz), p, 1. / mass, par, true);
+            const auto sf = table.smearing_factor(ix, iy, iz, true);
+            if (expected.first == 0.) {
+              COMPARE(sf.first, 0.);
+            } else {
+              COMPARE_RELATIVE_ERROR(sf.first, expected.first, 1.e-12);
+            }
+            for (int k = 0; k < 3; k++) {
+              COMPARE_ABSOLUTE_ERROR(sf.second[k], expected.second[k],
+                                     1.e-12 * (1. + expected.second.abs()));
+            }
+          });
+    }
+  }
+}
+
+/// Create a lattice for the fused_update_like_separate_updates test
+template <typename T>
+static std::unique_ptr<RectangularLattice<T>> create_fused_test_lattice() {
+  return std::make_unique<RectangularLattice<T>>(
+      std::array<double, 3>{8., 8., 8.}, std::array<int, 3>{16, 16, 16},
+      std::array<double, 3>{-4., -4., -4.}, false,
+      LatticeUpdate::EveryTimestep);
+}
+
+TEST(fused_update_like_separate_updates) {
+  // protons, neutrons, charged pions and antiprotons at random positions
+  std::vector<Particles> ensembles(2);
+  const std::array<PdgCode, 4> pdgs = {0x2212, 0x2112, 0x211, -0x2212};
+  for (Particles &particles : ensembles) {
+    for (int i = 0; i < 40; i++) {
+      ParticleData part{ParticleType::find(pdgs[i % 4])};
+      part.set_4momentum(part.type().mass(), random::uniform(-1., 1.),
+                         random::uniform(-1., 1.), random::uniform(-1., 1.));
+      part.set_4position(FourVector(0., random::uniform(-3., 3.),
+                                    random::uniform(-3., 3.),
+                                    random::uniform(-3., 3.)));
+      particles.insert(part);
+    }
+  }
+  for (DerivativesMode derivatives :
+       {DerivativesMode::CovariantGaussian,
+        DerivativesMode::FiniteDifference}) {
+    ExperimentParameters exp_par = smash::Test::default_parameters();
+    exp_par.n_ensembles = 2;
+    exp_par.derivatives_mode = derivatives;
+    exp_par.rho_derivatives_mode = RestFrameDensityDerivativesMode::On;
+    const DensityParameters par(exp_par);
+    auto old_jmu = create_fused_test_lattice<FourVector>();
+    auto new_jmu = create_fused_test_lattice<FourVector>();
+    auto four_grad = create_fused_test_lattice<std::array<FourVector, 4>>();
+    // isospin, baryon and charge density, updated separately or fused
+    std::array<std::unique_ptr<DensityLattice>, 3> separate, fused;
+    for (int k = 0; k < 3; k++) {
+      separate[k] = create_fused_test_lattice<DensityOnLattice>();
+      fused[k] = create_fused_test_lattice<DensityOnLattice>();
+    }
+    // two time steps, such that finite differences see old values
+    for (double dt : {0.1, 0.2}) {
+      update_lattice(separate[0].get(), old_jmu.get(), new_jmu.get(),
+                     four_grad.get(), LatticeUpdate::EveryTimestep,
+                     DensityType::BaryonicIsospin, par, ensembles, dt, true);
+      update_lattice(separate[1].get(), old_jmu.get(), new_jmu.get(),
+                     four_grad.get(), LatticeUpdate::EveryTimestep,
+                     DensityType::Baryon, par, ensembles, dt, true);
+      update_lattice(separate[2].get(), LatticeUpdate::EveryTimestep,
+                     DensityType::Charge, par, ensembles, true);
+      update_lattices(
+          {{fused[0].get(), DensityType::BaryonicIsospin, true},
+           {fused[1].get(), DensityType::Baryon, true},
+           {fused[2].get(), DensityType::Charge, false}},
+          old_jmu.get(), new_jmu.get(), four_grad.get(),
+          LatticeUpdate::EveryTimestep, par, ensembles, dt, true);
+      for (int k = 0; k < 3; k++) {
+        for (std::size_t i = 0; i < separate[k]->size(); i++) {
+          const DensityOnLattice &expected = (*separate[k])[i];
+          const DensityOnLattice &node = (*fused[k])[i];
+          for (int mu = 0; mu < 4; mu++) {
+            COMPARE(node.jmu_net()[mu], expected.jmu_net()[mu]);
+            COMPARE(node.drho_dxnu()[mu], expected.drho_dxnu()[mu]);
+            for (int nu = 0; nu < 4; nu++) {
+              COMPARE(node.djmu_dxnu()[nu][mu],
+                      expected.djmu_dxnu()[nu][mu]);
+            }
+          }
+        }
+      }
+      for (Particles &particles : ensembles) {
+        for (ParticleData &part : particles) {
+          part.set_4position(part.position() +
+                             FourVector(dt, part.velocity() * dt));
+        }
+      }
+    }
+  }
+}
+
+TEST(repeated_update_like_second_update) {
+  std::vector<Particles> ensembles(1);
+  for (int i = 0; i < 40; i++) {
+    ParticleData part{ParticleType::find(i % 2 == 0 ? 0x2212 : 0x2112)};
+    part.set_4momentum(0.938, random::uniform(-1., 1.),
+                       random::uniform(-1., 1.), random::uniform(-1., 1.));
+    part.set_4position(FourVector(0., random::uniform(-3., 3.),
+                                  random::uniform(-3., 3.),
+                                  random::uniform(-3., 3.)));
+    ensembles[0].insert(part);
+  }
+  ExperimentParameters exp_par = smash::Test::default_parameters();
+  exp_par.derivatives_mode = DerivativesMode::FiniteDifference;
+  exp_par.rho_derivatives_mode = RestFrameDensityDerivativesMode::On;
+  const DensityParameters par(exp_par);
+  auto old_jmu = create_fused_test_lattice<FourVector>();
+  auto new_jmu = create_fused_test_lattice<FourVector>();
+  auto four_grad = create_fused_test_lattice<std::array<FourVector, 4>>();
+  auto updated_twice = create_fused_test_lattice<DensityOnLattice>();
+  auto repeated = create_fused_test_lattice<DensityOnLattice>();
+  for (DensityLattice *lat : {updated_twice.get(), repeated.get()}) {
+    update_lattice(lat, old_jmu.get(), new_jmu.get(), four_grad.get(),
+                   LatticeUpdate::EveryTimestep, DensityType::Baryon, par,
+                   ensembles, 0.1, true);
+  }
+  update_lattice(updated_twice.get(), old_jmu.get(), new_jmu.get(),
+                 four_grad.get(), LatticeUpdate::EveryTimestep,
+                 DensityType::Baryon, par, ensembles, 0.1, true);
+  repeat_lattice_update(repeated.get(), old_jmu.get(), new_jmu.get(),
+                        four_grad.get(), LatticeUpdate::EveryTimestep, par,
+                        0.1);
+  for (std::size_t i = 0; i < repeated->size(); i++) {
+    const DensityOnLattice &expected = (*updated_twice)[i];
+    const DensityOnLattice &node = (*repeated)[i];
+    COMPARE(node.djmu_dxnu()[0], FourVector(0., 0., 0., 0.));
+    for (int mu = 0; mu < 4; mu++) {
+      COMPARE(node.jmu_net()[mu], expected.jmu_net()[mu]);
+      COMPARE(node.drho_dxnu()[mu], expected.drho_dxnu()[mu]);
+      for (int nu = 0; nu < 4; nu++) {
+        COMPARE(node.djmu_dxnu()[nu][mu], expected.djmu_dxnu()[nu][mu]);
+      }
+    }
+  }
+}
+
+TEST(threaded_update_like_serial_update) {
+  // protons and neutrons, some of them outside of the lattice
+  std::vector<Particles> ensembles(3);
+  for (Particles &particles : ensembles) {
+    for (int i = 0; i < 100; i++) {
+      ParticleData part{ParticleType::find(i % 2 == 0 ? 0x2212 : 0x2112)};
+      part.set_4momentum(0.938, random::uniform(-1., 1.),
+                         random::uniform(-1., 1.), random::uniform(-1., 1.));
+      part.set_4position(FourVector(0., random::uniform(-5., 5.),
+                                    random::uniform(-5., 5.),
+                                    random::uniform(-7., 7.)));
+      particles.insert(part);
+    }
+  }
+  ExperimentParameters exp_par = smash::Test::default_parameters();
+  exp_par.n_ensembles = 3;
+  const DensityParameters par(exp_par);
+  for (bool periodic : {false, true}) {
+    const std::array<double, 3> l = {10., 10., 10.};
+    const std::array<int, 3> n = {10, 10, 25};
+    const std::array<double, 3> origin = {-5., -5., -5.};
+    DensityLattice serial(l, n, origin, periodic,
+                          LatticeUpdate::EveryTimestep);
+    update_lattice(&serial, LatticeUpdate::EveryTimestep, DensityType::Baryon,
+                   par, ensembles, true);
+    for (int n_threads : {2, 3, 8}) {
+      ThreadPool pool(n_threads);
+      DensityLattice threaded(l, n, origin, periodic,
+                              LatticeUpdate::EveryTimestep);
+      update_lattice(&threaded, LatticeUpdate::EveryTimestep,
+                     DensityType::Baryon, par, ensembles, true, &pool);
+      // bit for bit the same densities
+      for (std::size_t i = 0; i < serial.size(); i++) {
+        for (int mu = 0; mu < 4; mu++) {
+          COMPARE(threaded[i].jmu_net()[mu], serial[i].jmu_net()[mu]);
+          for (int nu = 0; nu < 4; nu++) {
+            COMPARE(threaded[i].djmu_dxnu()[nu][mu],
+                    serial[i].djmu_dxnu()[nu][mu]);
+          }
+        }
+      }
+    }
+  }
+}
+
 // check that analytical and numerical results for gradient of density coincide
 TEST(density_gradient) {
   // create two protons
@@ -10,13 +10,20 @@
 #include "vir/test.h"  // This include has to be first
 
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
 
 #include "setup.h"
 #include "smash/collidermodus.h"
 
 using namespace smash;
 
-TEST(init_particle_types) { Test::create_actual_particletypes(); }
+TEST(init_particle_types) {
+  Test::create_actual_particletypes();
+  Test::create_actual_decaymodes();
+}
 
 static Configuration get_common_configuration() {
   return Configuration{R"(
@@ -96,6 +103,122 @@ TEST_CATCH(create_invalid, ExperimentBase::InvalidModusRequest) {
   Test::experiment(Configuration{"General: {Modus: Invalid}"});
 }
 
+TEST_CATCH(create_without_event_threads, std::invalid_argument) {
+  auto config = get_collider_configuration();
+  ExperimentBase::create(config, ".", 0);
+}
+
+TEST_CATCH(create_list_modus_with_event_threads, std::invalid_argument) {
+  Configuration config{"General: {Modus: List}"};
+  ExperimentBase::create(config, ".", 2);
+}
+
+TEST(create_with_event_threads) {
+  auto config = get_collider_configuration();
+  VERIFY(!!ExperimentBase::create(config, ".", 2));
+}
+
+/* Read a whole file into a string, to compare it byte by byte */
+static std::string read_file(const std::filesystem::path &file) {
+  std::ifstream stream(file, std::ios::binary);
+  return {std::istreambuf_iterator<char>(stream),
+          std::istreambuf_iterator<char>()};
+}
+
+TEST(event_threads_give_same_output) {
+  const std::filesystem::path output =
+      std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+  /* Pions, and hot nucleons with pions, which produce resonances whose masses
+   * are sampled with adaptive maxima. */
+  const std::map<std::string, std::string> boxes = {
+      {"pions", "{211: 30, 111: 30, -211: 30}"},
+      {"resonances", "{2212: 20, 2112: 20, 211: 20, -211: 20}"}};
+  for (const auto &[box, multiplicities] : boxes) {
+    for (const int n_threads : {1, 3}) {
+      const std::filesystem::path path =
+          output / (box + "_threads_" + std::to_string(n_threads));
+      std::filesystem::remove_all(path);
+      std::filesystem::create_directories(path);
+      Configuration config{R"(
+        General:
+          Modus: Box
+          End_Time: 5.0
+          Nevents: 7
+          Randomseed: 17
+        Modi:
+          Box:
+            Initial_Condition: "thermal momenta"
+            Length: 5.0
+            Temperature: 0.2
+            Start_Time: 0.0
+        Output:
+          Output_Interval: 1.0
+          Particles:
+            Format: ["Oscar2013", "Binary"]
+          Collisions:
+            Format: ["Oscar2013", "Binary"]
+        )"};
+      config.merge_yaml("Modi: {Box: {Init_Multiplicities: " + multiplicities +
+                        "}}");
+      if (box == "resonances") {
+        config.set_value({"Modi", "Box", "Temperature"}, 0.3);
+      }
+      // The files are only complete once the experiment is destroyed.
+      ExperimentBase::create(config, path, n_threads)->run();
+    }
+    const std::filesystem::path serial = output / (box + "_threads_1");
+    const std::filesystem::path concurrent = output / (box + "_threads_3");
+    int n_files = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(serial)) {
+      const std::filesystem::path name = entry.path().filename();
+      VERIFY(std::filesystem::exists(concurrent / name)) << name;
+      VERIFY(read_file(entry.path()) == read_file(concurrent / name)) << name;
+      n_files++;
+    }
+    COMPARE(n_files, 4);
+  }
+}
+
+TEST(pauli_blocking_with_all_particles_propagated) {
+  /* The density at the interaction point, which is only written to the
+   * output, needs all particles to be propagated to each action. The Pauli
+   * blocking, which needs them as well, must hence not change with it. */
+  const std::filesystem::path output =
+      std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+  for (const std::string density : {"none", "baryon"}) {
+    const std::filesystem::path path = output / ("pauli_" + density);
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    Configuration config{R"(
+      General:
+        Modus: Box
+        End_Time: 10.0
+        Nevents: 1
+        Randomseed: 5
+        Testparticles: 5
+      Collision_Term:
+        Pauli_Blocking: {}
+      Modi:
+        Box:
+          Initial_Condition: "thermal momenta"
+          Length: 4.0
+          Temperature: 0.03
+          Start_Time: 0.0
+          Init_Multiplicities: {2212: 200, 2112: 200}
+      Output:
+        Particles:
+          Format: ["Oscar2013"]
+          Only_Final: Yes
+      )"};
+    config.set_value({"Output", "Density_Type"}, density);
+    ExperimentBase::create(config, path)->run();
+  }
+  const std::string file = "particle_lists.oscar";
+  const std::string lazy = read_file(output / "pauli_none" / file);
+  VERIFY(!lazy.empty());
+  VERIFY(lazy == read_file(output / "pauli_baryon" / file));
+}
+
 TEST(access_particles) {
   auto config = get_collider_configuration();
   auto exp = std::make_unique<Experiment<ColliderModus>>(config, ".");
@@ -0,0 +1,127 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/fftcoulombsolver.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "setup.h"
+#include "smash/constants.h"
+#include "smash/potentials.h"
+
+using namespace smash;
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST(fourier_transform) {
+  // Sizes with a prime factor larger than 5 use the slow butterflies.
+  const std::array<int, 3> sizes = {6, 7, 4};
+  FourierTransform3D fft(sizes);
+  COMPARE(fft.size(), 168u);
+  std::vector<std::complex<double>> data(fft.size());
+  for (std::size_t i = 0; i < data.size(); i++) {
+    data[i] = {std::sin(0.7 * i), std::cos(1.3 * i * i)};
+  }
+  const std::vector<std::complex<double>> original = data;
+
+  fft.forward(data);
+  std::size_t k = 0;
+  for (int kz = 0; kz < sizes[2]; kz++) {
+    for (int ky = 0; ky < sizes[1]; ky++) {
+      for (int kx = 0; kx < sizes[0]; kx++, k++) {
+        std::complex<double> expected = 0.;
+        std::size_t n = 0;
+        for (int nz = 0; nz < sizes[2]; nz++) {
+          for (int ny = 0; ny < sizes[1]; ny++) {
+            for (int nx = 0; nx < sizes[0]; nx++, n++) {
+              const double phase = static_cast<double>(kx * nx) / sizes[0] +
+                                   static_cast<double>(ky * ny) / sizes[1] +
+                                   static_cast<double>(kz * nz) / sizes[2];
+              expected += original[n] * std::polar(1., -twopi * phase);
+            }
+          }
+        }
+        COMPARE_ABSOLUTE_ERROR(data[k].real(), expected.real(), 1e-12);
+        COMPARE_ABSOLUTE_ERROR(data[k].imag(), expected.imag(), 1e-12);
+      }
+    }
+  }
+
+  fft.backward(data);
+  for (std::size_t i = 0; i < data.size(); i++) {
+    COMPARE_ABSOLUTE_ERROR(data[i].real(), original[i].real(), 1e-14);
+    COMPARE_ABSOLUTE_ERROR(data[i].imag(), original[i].imag(), 1e-14);
+  }
+}
+
+TEST(next_fast_size) {
+  COMPARE(FourierTransform3D::next_fast_size(1), 1);
+  COMPARE(FourierTransform3D::next_fast_size(7), 8);
+  COMPARE(FourierTransform3D::next_fast_size(30), 30);
+  COMPARE(FourierTransform3D::next_fast_size(31), 32);
+  COMPARE(FourierTransform3D::next_fast_size(97), 100);
+}
+
+/**
+ * Compare the fields of the solver with the direct integration for moving
+ * charges of both signs on an anisotropic lattice.
+ */
+static void compare_with_direct_integration(bool periodic, double r_cut) {
+  DensityLattice jmu_el_lat({8., 6., 10.}, {8, 6, 5}, {-4., -3., -5.},
+                            periodic, LatticeUpdate::EveryTimestep);
+  int i = 0;
+  for (DensityOnLattice &node : jmu_el_lat) {
+    const double p = 0.1 * std::sin(1.1 * i);
+    ParticleData smashon = Test::smashon(
+        Test::Momentum{0.5, p, 0.2 * std::cos(0.3 * i), 0.15 - p});
+    node.add_particle(smashon, std::sin(2.3 * i) * std::exp(-0.02 * i));
+    i++;
+  }
+  FFTCoulombSolver::FieldsLattice em_lat({8., 6., 10.}, {8, 6, 5},
+                                         {-4., -3., -5.}, periodic,
+                                         LatticeUpdate::EveryTimestep);
+  FFTCoulombSolver solver(jmu_el_lat, r_cut);
+  solver.compute_fields(jmu_el_lat, em_lat);
+
+  for (std::size_t i_cell = 0; i_cell < jmu_el_lat.size(); i_cell++) {
+    const ThreeVector position = jmu_el_lat.cell_center(i_cell);
+    ThreeVector electric_field = {0., 0., 0.};
+    jmu_el_lat.integrate_volume(electric_field, Potentials::E_field_integrand,
+                                r_cut, position);
+    ThreeVector magnetic_field = {0., 0., 0.};
+    jmu_el_lat.integrate_volume(magnetic_field, Potentials::B_field_integrand,
+                                r_cut, position);
+    for (int k = 0; k < 3; k++) {
+      COMPARE_ABSOLUTE_ERROR(em_lat[i_cell].first[k], electric_field[k],
+                             1e-12);
+      COMPARE_ABSOLUTE_ERROR(em_lat[i_cell].second[k], magnetic_field[k],
+                             1e-12);
+    }
+  }
+}
+
+TEST(fields_like_direct_integration) {
+  compare_with_direct_integration(false, 3.3);
+  // The cut reaches beyond the lattice.
+  compare_with_direct_integration(false, 12.1);
+  // The cut is a multiple of the cell sizes (1, 1 and 2 fm).
+  compare_with_direct_integration(false, 4.);
+}
+
+TEST(fields_like_direct_integration_periodic) {
+  compare_with_direct_integration(true, 3.3);
+  // The cut covers several images of the cells.
+  compare_with_direct_integration(true, 12.1);
+  // The cut is a multiple of the cell sizes (1, 1 and 2 fm).
+  compare_with_direct_integration(true, 4.);
+}
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2015,2017-2022
+ *    Copyright (c) 2015,2017-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -11,6 +11,7 @@
 
 #include "smash/grid.h"
 
+#include <algorithm>
 #include <set>
 #include <unordered_set>
 
@@ -469,3 +470,107 @@ TEST(max_positions_normal_grid) {
   Grid<GridOptions::Normal> grid2(list, testparticles, 1.0,
                                   CellNumberLimitation::None);
 }
+
+TEST(surrounding_particles) {
+  using Test::Momentum;
+  using Test::Position;
+  // One particle in the center of each of the 4x4x4 cells and two particles
+  // in the corners spanning the grid
+  Particles list;
+  const double cell_length = 2.5;
+  for (int z = 0; z < 4; ++z) {
+    for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 4; ++x) {
+        list.insert(Test::smashon(Position{0., (x + 0.5) * cell_length,
+                                           (y + 0.5) * cell_length,
+                                           (z + 0.5) * cell_length}));
+      }
+    }
+  }
+  const ParticleData corner =
+      list.insert(Test::smashon(Position{0., 0., 0., 0.}));
+  list.insert(Test::smashon(Position{0., 10., 10., 10.}));
+  Grid<GridOptions::Normal> grid(list, cell_length, timestep,
+                                 CellNumberLimitation::None);
+
+  // A particle in the cell (1,1,1) is surrounded by 27 cells
+  const ParticleList search_list{
+      Test::smashon(Position{0., 3.75, 3.75, 3.75})};
+  ParticleList surrounding = grid.surrounding_particles(search_list, list);
+  COMPARE(surrounding.size(), 28u);
+  for (const ParticleData &p : surrounding) {
+    for (int i = 1; i < 4; ++i) {
+      VERIFY(p.position()[i] < 3 * cell_length) << p;
+    }
+  }
+
+  // A particle in a corner cell is surrounded by 8 cells
+  surrounding = grid.surrounding_particles(
+      {Test::smashon(Position{0., 9., 9., 9.})}, list);
+  COMPARE(surrounding.size(), 9u);
+
+  // Removed particles are not found anymore
+  list.remove(corner);
+  COMPARE(grid.surrounding_particles(search_list, list).size(), 27u);
+
+  // Particles added later are sorted in where their trajectory was at the
+  // construction of the grid, here in the cell (2,1,1)
+  ParticleData added = list.insert(
+      Test::smashon(Position{5., 6.25 + 5 * 0.8, 3.75, 3.75},
+                    Momentum{0.205, 0.164, 0., 0.}));
+  grid.add_particles({added});
+  surrounding = grid.surrounding_particles(search_list, list);
+  COMPARE(surrounding.size(), 28u);
+  const auto found = std::find_if(
+      surrounding.begin(), surrounding.end(),
+      [&added](const ParticleData &p) { return p.id() == added.id(); });
+  VERIFY(found != surrounding.end());
+  COMPARE(found->position(), added.position());
+}
+
+TEST(wall_crossing_particle_found_once) {
+  using Test::Position;
+  Particles list;
+  const double cell_length = 2.5;
+  ParticleData crossing{ParticleType::find(0x661)};
+  for (int z = 0; z < 4; ++z) {
+    for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 4; ++x) {
+        const ParticleData &p = list.insert(Test::smashon(
+            Position{0., (x + 0.5) * cell_length, (y + 0.5) * cell_length,
+                     (z + 0.5) * cell_length}));
+        if (x == 0 && y == 1 && z == 1) {
+          crossing = p;
+        }
+      }
+    }
+  }
+  // The corners span the same grid as in the test above.
+  list.insert(Test::smashon(Position{0., 0., 0., 0.}));
+  list.insert(Test::smashon(Position{0., 10., 10., 10.}));
+  Grid<GridOptions::Normal> grid(list, cell_length, timestep,
+                                 CellNumberLimitation::None);
+
+  /* Move the particle from the cell (0,1,1) to the cell (2,1,1). Like a wall
+   * crossing, this keeps its id and process id. */
+  ParticleData moved = crossing;
+  moved.set_4position(FourVector(0., 2.5 * cell_length, 1.5 * cell_length,
+                                 1.5 * cell_length));
+  const ParticleData crossed = list.update_particle(crossing, moved);
+  grid.add_particles({crossed});
+
+  // Both cells are next to (1,1,1), but the particle is only found once.
+  const ParticleList surrounding = grid.surrounding_particles(
+      {Test::smashon(Position{0., 3.75, 3.75, 3.75})}, list);
+  COMPARE(surrounding.size(), 28u);
+  COMPARE(std::count_if(surrounding.begin(), surrounding.end(),
+                        [&crossed](const ParticleData &p) {
+                          return p.id() == crossed.id();
+                        }),
+          1);
+
+  // The searched particle itself is not among its surrounding particles.
+  for (const ParticleData &p : grid.surrounding_particles({crossed}, list)) {
+    VERIFY(p.id() != crossed.id());
+  }
+}
@@ -0,0 +1,121 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/multiparticleratebounds.h"
+
+#include <cmath>
+#include <string>
+
+#include "setup.h"
+
+using namespace smash;
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "σ " +
+      std::to_string(Test::smashon_mass) +
+      " 0.0 + 661\n"
+      "η' 0.95778 0.000196 - 331\n");
+}
+
+/// Reduced rate falling with sqrt(s), for which the bounds are known
+static double falling_rate(double sqrts) { return 3. / sqrts; }
+
+/// Three smashons at rest and one moving with the given momentum
+static ParticleList smashons(double momentum) {
+  const double m = Test::smashon_mass;
+  ParticleList list;
+  for (int i = 0; i < 3; i++) {
+    list.push_back(Test::smashon(Test::Momentum{m, 0., 0., 0.},
+                                 Test::Position{0., 0., 0., 0.}, i));
+  }
+  const double energy = std::sqrt(m * m + momentum * momentum);
+  list.push_back(Test::smashon(Test::Momentum{energy, 0., momentum, 0.},
+                               Test::Position{0., 0., 0., 0.}, 3));
+  return list;
+}
+
+TEST(bound_of_combination) {
+  int n_calls = 0;
+  MultiParticleRateBounds bounds(
+      [&n_calls](const ParticleTypePtrList &types, double sqrts) {
+        COMPARE(types.size(), 3u);
+        n_calls++;
+        return falling_rate(sqrts);
+      });
+  const ParticleList list = smashons(0.3);
+  const std::vector<const ParticleData *> incoming = {&list[0], &list[1],
+                                                      &list[3]};
+  const double sqrts =
+      (list[0].momentum() + list[1].momentum() + list[3].momentum()).abs();
+  const double bound = bounds.upper_bound(incoming);
+  VERIFY(bound >= falling_rate(sqrts));
+  const double bin_start = sqrts - MultiParticleRateBounds::bin_width;
+  VERIFY(bound <=
+         MultiParticleRateBounds::safety_factor * falling_rate(bin_start));
+  COMPARE(n_calls, MultiParticleRateBounds::n_samples + 1);
+
+  // The bin is only evaluated once, for any order of the particles.
+  COMPARE(bounds.upper_bound({&list[3], &list[0], &list[1]}), bound);
+  COMPARE(bounds.upper_bound({&list[1], &list[2], &list[3]}), bound);
+  COMPARE(n_calls, MultiParticleRateBounds::n_samples + 1);
+
+  // Another number of particles is another combination.
+  n_calls = 0;
+  MultiParticleRateBounds four_bounds(
+      [&n_calls](const ParticleTypePtrList &types, double sqrts) {
+        COMPARE(types.size(), 4u);
+        n_calls++;
+        return falling_rate(sqrts);
+      });
+  four_bounds.upper_bound({&list[0], &list[1], &list[2], &list[3]});
+  COMPARE(n_calls, MultiParticleRateBounds::n_samples + 1);
+}
+
+TEST(no_bound) {
+  MultiParticleRateBounds bounds(
+      [](const ParticleTypePtrList &, double sqrts) {
+        return falling_rate(sqrts);
+      });
+  // Energies beyond the tabulated range are not bounded.
+  const ParticleList list = smashons(4000.);
+  VERIFY(std::isinf(bounds.upper_bound({&list[0], &list[1], &list[3]})));
+  // Neither are rates that cannot be evaluated.
+  MultiParticleRateBounds nan_bounds(
+      [](const ParticleTypePtrList &, double) { return std::nan(""); });
+  VERIFY(std::isinf(nan_bounds.upper_bound({&list[0], &list[1], &list[2]})));
+}
+
+TEST(narrow_peak) {
+  // Breit-Wigner peak of the eta', which is much narrower than 1 MeV
+  const ParticleType &eta_prime = ParticleType::find(0x331);
+  auto peak = [&eta_prime](double sqrts) {
+    const double half_width_sqr = 0.25 * eta_prime.width_at_pole() *
+                                  eta_prime.width_at_pole();
+    const double offset = sqrts - eta_prime.mass();
+    return half_width_sqr / (offset * offset + half_width_sqr);
+  };
+  MultiParticleRateBounds bounds(
+      [&peak](const ParticleTypePtrList &, double sqrts) {
+        return peak(sqrts);
+      });
+  /* Two smashons at rest and one moving smashon, with sqrt(s) at the pole
+   * mass of the eta', which lies between two of the equidistant samples. */
+  const double m = Test::smashon_mass;
+  const double energy =
+      (eta_prime.mass() * eta_prime.mass() - 5. * m * m) / (4. * m);
+  const ParticleList list = smashons(std::sqrt(energy * energy - m * m));
+  const double sqrts =
+      (list[0].momentum() + list[1].momentum() + list[3].momentum()).abs();
+  COMPARE_RELATIVE_ERROR(sqrts, eta_prime.mass(), 1e-12);
+  VERIFY(bounds.upper_bound({&list[0], &list[1], &list[3]}) >= peak(sqrts));
+}
@@ -0,0 +1,200 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "setup.h"
+#include "smash/multiparticleratebounds.h"
+#include "smash/scatteractionmulti.h"
+#include "smash/scatteractionsfinder.h"
+
+using namespace smash;
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "π  0.138   7.7e-9    -      111      211\n"
+      "N  0.938   0         +      2112     2212\n"
+      "Λ  1.116   0         +      3122\n"
+      "η  0.548   1.31e-6   -      221\n"
+      "η' 0.958   1.96e-4   -      331\n"
+      "φ  1.019   4.25e-3   -      333\n"
+      "ω  0.783   8.49e-3   -      223\n"
+      "d  1.8756  0         +      1000010020\n"
+      "t  2.8089  0         +      1000010030\n"
+      "He3 2.8084 0         +      1000020030\n"
+      "H3L 2.9934 0         +      1010010030\n");
+}
+
+TEST(init_decay_modes) {
+  DecayModes::load_decaymodes(
+      "ω\n"
+      "0.893    1  π⁺ π⁻ π⁰\n"
+      "\n"
+      "φ\n"
+      "0.152   1  π⁺ π⁻ π⁰\n"
+      "\n"
+      "η'\n"
+      "0.426  0  π⁺ π⁻ η\n"
+      "0.228  0  π⁰ π⁰ η\n");
+  ParticleType::check_consistency();
+  sha256::Hash hash;
+  hash.fill(0);
+  IsoParticleType::tabulate_integrals(hash, "");
+}
+
+/* Particles of the given types on their mass shell with the given sqrt(s):
+ * the first one moves towards the others, which are at rest. */
+static ParticleList particles_at(const ParticleTypePtrList &types,
+                                 double sqrts) {
+  double mass_at_rest = 0.;
+  for (std::size_t i = 1; i < types.size(); i++) {
+    mass_at_rest += types[i]->mass();
+  }
+  const double mass_moving = types[0]->mass();
+  const double energy = (sqrts * sqrts - mass_moving * mass_moving -
+                         mass_at_rest * mass_at_rest) /
+                        (2. * mass_at_rest);
+  const double momentum =
+      std::sqrt(std::max(0., energy * energy - mass_moving * mass_moving));
+  ParticleList list;
+  for (ParticleTypePtr type : types) {
+    ParticleData data(*type);
+    data.set_4momentum(type->mass(), list.empty() ? momentum : 0., 0., 0.);
+    list.push_back(data);
+  }
+  return list;
+}
+
+/* All combinations of n of the given types, with repetitions and without
+ * regard to their order */
+static std::vector<ParticleTypePtrList> combinations(
+    const std::vector<PdgCode> &pdgs, std::size_t n) {
+  std::vector<ParticleTypePtrList> result;
+  ParticleTypePtrList current;
+  std::function<void(std::size_t)> add_from = [&](std::size_t first) {
+    if (current.size() == n) {
+      result.push_back(current);
+      return;
+    }
+    for (std::size_t i = first; i < pdgs.size(); i++) {
+      current.push_back(&ParticleType::find(pdgs[i]));
+      add_from(i);
+      current.pop_back();
+    }
+  };
+  add_from(0);
+  return result;
+}
+
+TEST(bounds_of_actual_rates) {
+  /* The bounds are not proven, but rely on the rates varying little between
+   * the samples of a bin, apart from the peaks of resonances. This checks
+   * them for all multi-particle reactions of SMASH, for every combination of
+   * the species that take part in them. */
+  MultiParticleReactionsBitSet included_multi;
+  included_multi.set();
+  ReactionsBitSet included_2to2 = Test::all_reactions_included();
+  // The deuteron 3 -> 2 reactions replace those with the d'.
+  included_2to2.reset(IncludedReactions::PiDeuteron_to_pidprime);
+  included_2to2.reset(IncludedReactions::NDeuteron_to_Ndprime);
+  Configuration config{""};
+  ExperimentParameters exp_par = Test::default_parameters(
+      1, 0.1, CollisionCriterion::Stochastic, included_2to2, included_multi);
+  exp_par.nnbar_treatment = NNbarTreatment::TwoToFive;
+  const ScatterActionsFinder finder(config, exp_par);
+  const MultiParticleRateBounds bounds(
+      [&finder](const ParticleTypePtrList &types, double sqrts) {
+        return finder.multi_particle_rate(types, sqrts);
+      });
+
+  const std::vector<PdgCode> pions = {0x211, 0x111, -0x211};
+  std::vector<PdgCode> three_body = pions, four_body = pions;
+  three_body.push_back(0x221);
+  for (PdgCode pdg : {0x2212, 0x2112, -0x2212, -0x2112}) {
+    three_body.push_back(pdg);
+    four_body.push_back(pdg);
+  }
+  for (PdgCode pdg : {0x3122, -0x3122}) {
+    four_body.push_back(pdg);
+  }
+  std::vector<ParticleTypePtrList> all_types = combinations(three_body, 3);
+  for (const ParticleTypePtrList &types : combinations(four_body, 4)) {
+    all_types.push_back(types);
+  }
+  for (const ParticleTypePtrList &types : combinations(pions, 5)) {
+    all_types.push_back(types);
+  }
+
+  const double sample_distance =
+      MultiParticleRateBounds::bin_width / MultiParticleRateBounds::n_samples;
+  int n_reacting = 0;
+  for (const ParticleTypePtrList &types : all_types) {
+    double threshold = 0.;
+    for (ParticleTypePtr type : types) {
+      threshold += type->mass();
+    }
+    // The reactions only depend on the types, skip those without any.
+    ScatterActionMulti act(particles_at(types, threshold + 0.5), 0.);
+    act.add_possible_reactions(1., 1., included_multi);
+    if (act.reaction_channels().empty()) {
+      continue;
+    }
+    n_reacting++;
+    std::string names;
+    for (ParticleTypePtr type : types) {
+      names += type->name();
+    }
+    /* Midway between the samples of the bins, where a smooth rate deviates
+     * most from them, and beyond 2 GeV above the threshold more coarsely. */
+    const double sqrts_max =
+        threshold + MultiParticleRateBounds::max_sqrts_above_threshold;
+    std::vector<double> energies;
+    for (double sqrts = threshold + 0.5 * sample_distance;
+         sqrts < threshold + 2.; sqrts += sample_distance) {
+      energies.push_back(sqrts);
+    }
+    for (double sqrts = threshold + 2. + 0.5 * sample_distance;
+         sqrts < sqrts_max; sqrts += 5. * sample_distance) {
+      energies.push_back(sqrts);
+    }
+    // Finely around the peaks of resonances narrower than the samples
+    for (const ParticleType &resonance : ParticleType::list_all()) {
+      const double width = resonance.width_at_pole();
+      if (resonance.is_stable() || width > 5. * sample_distance) {
+        continue;
+      }
+      for (int i = -30; i <= 30; i++) {
+        const double sqrts = resonance.mass() + 0.1 * i * width;
+        if (sqrts > threshold) {
+          energies.push_back(sqrts);
+        }
+      }
+    }
+    for (const double sqrts : energies) {
+      const ParticleList list = particles_at(types, sqrts);
+      std::vector<const ParticleData *> incoming;
+      for (const ParticleData &data : list) {
+        incoming.push_back(&data);
+      }
+      const double rate = finder.multi_particle_rate(types, sqrts);
+      const double bound = bounds.upper_bound(incoming);
+      VERIFY(rate <= bound) << names << " at sqrt(s) = " << sqrts
+                            << " GeV: " << rate << " > " << bound;
+    }
+  }
+  // combinations with 3 -> 1, 3 -> 2, 4 -> 2 and 5 -> 2 reactions
+  VERIFY(n_reacting > 20) << n_reacting;
+}
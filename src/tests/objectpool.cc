@@ -0,0 +1,162 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/objectpool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "smash/processbranch.h"
+
+using namespace smash;
+
+namespace {
+/// Base of the pool allocated test objects
+struct Object : PoolAllocated {
+  virtual ~Object() = default;
+};
+
+/// Pool allocated object with N bytes of data
+template <std::size_t N>
+struct Block : Object {
+  char data[N];
+};
+}  // unnamed namespace
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "σ    1.1 1.1 + 9876542\n");
+}
+
+TEST(reuse_freed_block) {
+  auto a = std::make_unique<Block<33>>();
+  void *address = a.get();
+  a.reset();
+  // The next object of the same block size gets the block back.
+  auto b = std::make_unique<Block<40>>();
+  COMPARE(static_cast<void *>(b.get()), address);
+  // Objects of another block size do not.
+  auto c = std::make_unique<Block<100>>();
+  VERIFY(static_cast<void *>(c.get()) != address);
+}
+
+TEST(alignment_and_distinct_blocks) {
+  std::vector<std::unique_ptr<Object>> objects;
+  for (int i = 0; i < 10000; i++) {
+    objects.emplace_back(std::make_unique<Block<24>>());
+    objects.emplace_back(std::make_unique<Block<700>>());
+  }
+  std::vector<std::uintptr_t> addresses;
+  for (const auto &object : objects) {
+    const auto address = reinterpret_cast<std::uintptr_t>(object.get());
+    COMPARE(address % alignof(std::max_align_t), 0u);
+    addresses.push_back(address);
+  }
+  std::sort(addresses.begin(), addresses.end());
+  VERIFY(std::adjacent_find(addresses.begin(), addresses.end()) ==
+         addresses.end());
+}
+
+TEST(large_objects_from_heap) {
+  auto large = std::make_unique<Block<PoolAllocated::max_block_size + 1>>();
+  large->data[PoolAllocated::max_block_size] = 1;
+  COMPARE(large->data[PoolAllocated::max_block_size], 1);
+}
+
+TEST(delete_through_base) {
+  // The block size of the derived class is given back with a virtual
+  // destructor.
+  const ParticleType &smashon = ParticleType::find(PdgCode("9876542"));
+  std::unique_ptr<ProcessBranch> branch = std::make_unique<CollisionBranch>(
+      smashon, smashon, 1., ProcessType::Elastic);
+  void *address = branch.get();
+  branch.reset();
+  auto other =
+      std::make_unique<CollisionBranch>(smashon, 2., ProcessType::TwoToOne);
+  COMPARE(static_cast<void *>(other.get()), address);
+  COMPARE(other->particle_types().size(), 1u);
+}
+
+TEST(free_on_other_thread) {
+  auto object = std::make_unique<Block<64>>();
+  std::thread([&object]() {
+    object.reset();
+    auto other = std::make_unique<Block<64>>();
+    VERIFY(other != nullptr);
+  }).join();
+  auto again = std::make_unique<Block<64>>();
+  again->data[63] = 2;
+  COMPARE(again->data[63], 2);
+}
+
+TEST(free_on_other_thread_repeatedly) {
+  /* Like actions found on a worker thread and performed on the main thread:
+   * the blocks go back to the worker, which reuses them in the next round. */
+  std::vector<std::unique_ptr<Object>> objects;
+  auto allocate_on_worker = [&objects]() {
+    std::thread([&objects]() {
+      for (int i = 0; i < 5000; i++) {
+        objects.emplace_back(std::make_unique<Block<48>>());
+      }
+    }).join();
+  };
+  allocate_on_worker();
+  objects.clear();
+  const std::size_t n_chunks = PoolAllocated::n_chunks();
+  for (int round = 0; round < 50; round++) {
+    allocate_on_worker();
+    objects.clear();
+  }
+  COMPARE(PoolAllocated::n_chunks(), n_chunks);
+}
+
+TEST(free_blocks_of_finished_threads_shared) {
+  /* In every round, one thread allocates many blocks and another one, which
+   * finishes first, a single small object. The threads of the next round
+   * take over the pool owners the other way round, so the allocating thread
+   * has to use the blocks the thread before left. */
+  auto round = []() {
+    std::atomic<bool> allocated = false;
+    std::thread other([&allocated]() {
+      std::make_unique<Block<16>>();
+      while (!allocated) {
+        std::this_thread::yield();
+      }
+    });
+    std::atomic<bool> other_finished = false;
+    std::thread allocating([&allocated, &other_finished]() {
+      std::vector<std::unique_ptr<Object>> objects;
+      for (int i = 0; i < 1000; i++) {
+        objects.emplace_back(std::make_unique<Block<400>>());
+      }
+      objects.clear();
+      allocated = true;
+      while (!other_finished) {
+        std::this_thread::yield();
+      }
+    });
+    other.join();
+    other_finished = true;
+    allocating.join();
+  };
+  round();
+  const std::size_t n_chunks = PoolAllocated::n_chunks();
+  for (int i = 0; i < 10; i++) {
+    round();
+  }
+  COMPARE(PoolAllocated::n_chunks(), n_chunks);
+}
@@ -10,7 +10,10 @@
 #include "vir/test.h"  // This include has to be first
 
 #include <array>
+#include <cstdio>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -378,3 +381,90 @@ TEST(initial_conditions_format) {
   }
   VERIFY(std::filesystem::remove(outputfilepath));
 }
+
+/* The particle line as the former std::fprintf based output wrote it */
+static std::string printf_particle_line(const ParticleData &p) {
+  char line[512];
+  const FourVector pos = p.position();
+  const FourVector mom = p.momentum();
+  std::snprintf(line, sizeof(line), "%i %s %i %g %g %g %g %g %g %g %g %g\n",
+                p.id(), p.pdgcode().string().c_str(), 0, mom.x1(), mom.x2(),
+                mom.x3(), mom.x0(), p.effective_mass(), pos.x1(), pos.x2(),
+                pos.x3(), pos.x0());
+  return line;
+}
+
+TEST(same_text_as_printf) {
+  // Numbers which are rounded or switch to exponential notation
+  const double values[] = {0.0,        -0.0,        1e-5,    0.1 + 0.2,
+                           999999.5,   123456.789,  -1.5e-7, 3.0e20,
+                           9.99999e-5, 1.234567891, -42.,    0.5};
+  Particles particles;
+  for (std::size_t i = 0; i + 4 <= std::size(values); i++) {
+    ParticleData p = Test::smashon_random();
+    p.set_4position(
+        FourVector(values[i], values[i + 1], values[i + 2], values[i + 3]));
+    p.set_4momentum(
+        FourVector(values[i + 3], values[i + 2], values[i + 1], values[i]));
+    particles.insert(p);
+  }
+  const ParticleList list = particles.copy_to_vector();
+  ScatterActionPtr action =
+      std::make_unique<ScatterAction>(list[0], list[1], 0.);
+  action->add_all_scatterings(Test::default_finder_parameters());
+  action->generate_final_state();
+  const double density = 0.123456789;
+  EventInfo event = Test::default_event_info(1.0005, false);
+
+  const std::filesystem::path outputfilepath =
+      testoutputpath / "full_event_history.oscar1999";
+  {
+    OutputParameters out_par = OutputParameters();
+    out_par.coll_printstartend = true;
+    std::unique_ptr<OutputInterface> output =
+        create_oscar_output("Oscar1999", "Collisions", testoutputpath, out_par);
+    output->at_eventstart(particles, 0, event);
+    output->at_interaction(*action, density);
+    output->at_eventend(particles, 0, event);
+  }
+
+  char line[256];
+  std::snprintf(line, sizeof(line), "%zu %zu %i\n", std::size_t(0),
+                list.size(), 0);
+  std::string expected = line;
+  for (const ParticleData &p : list) {
+    expected += printf_particle_line(p);
+  }
+  std::snprintf(line, sizeof(line), "%zu %zu %12.7f %12.7f %12.7f %5i\n",
+                action->incoming_particles().size(),
+                action->outgoing_particles().size(), density,
+                action->get_total_weight(), action->get_partial_weight(),
+                static_cast<int>(action->get_type()));
+  expected += line;
+  for (const ParticleData &p : action->incoming_particles()) {
+    expected += printf_particle_line(p);
+  }
+  for (const ParticleData &p : action->outgoing_particles()) {
+    expected += printf_particle_line(p);
+  }
+  std::snprintf(line, sizeof(line), "%zu %zu %i\n", list.size(),
+                std::size_t(0), 0);
+  expected += line;
+  for (const ParticleData &p : list) {
+    expected += printf_particle_line(p);
+  }
+  std::snprintf(line, sizeof(line), "%zu %zu %i %7.3f\n", std::size_t(0),
+                std::size_t(0), 0, event.impact_parameter);
+  expected += line;
+
+  // Everything after the eight header lines
+  std::ifstream outputfile(outputfilepath);
+  std::string header;
+  for (int i = 0; i < 8; i++) {
+    std::getline(outputfile, header);
+  }
+  const std::string content((std::istreambuf_iterator<char>(outputfile)),
+                            std::istreambuf_iterator<char>());
+  COMPARE(content, expected);
+  VERIFY(std::filesystem::remove(outputfilepath));
+}
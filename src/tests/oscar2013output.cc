@@ -10,7 +10,10 @@
 #include "vir/test.h"  // This include has to be first
 
 #include <array>
+#include <cstdio>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <map>
 #include <string>
 #include <vector>
@@ -494,3 +497,107 @@ TEST(initial_conditions_2013_format) {
   }
   VERIFY(std::filesystem::remove(outputfilepath));
 }
+
+/* The particle line as the former std::fprintf based output wrote it */
+static std::string printf_particle_line(const ParticleData &p, bool extended) {
+  char line[1024];
+  const FourVector pos = p.position();
+  const FourVector mom = p.momentum();
+  int n = std::snprintf(line, sizeof(line),
+                        "%g %g %g %g %g %.9g %.9g %.9g %.9g %s %i %i", pos.x0(),
+                        pos.x1(), pos.x2(), pos.x3(), p.effective_mass(),
+                        mom.x0(), mom.x1(), mom.x2(), mom.x3(),
+                        p.pdgcode().string().c_str(), p.id(),
+                        p.type().charge());
+  if (extended) {
+    const auto h = p.get_history();
+    n += std::snprintf(line + n, sizeof(line) - n,
+                       " %i %g %g %i %i %g %s %s %i", h.collisions_per_particle,
+                       p.formation_time(), p.xsec_scaling_factor(),
+                       h.id_process, static_cast<int>(h.process_type),
+                       h.time_last_collision, h.p1.string().c_str(),
+                       h.p2.string().c_str(), p.type().baryon_number());
+  }
+  return std::string(line, n) + "\n";
+}
+
+TEST(same_text_as_printf) {
+  /* Numbers which are rounded, switch to exponential notation or need the
+   * full precision of %.9g */
+  const double values[] = {0.0,        -0.0,        1e-5,    0.1 + 0.2,
+                           999999.5,   123456.789,  -1.5e-7, 3.0e20,
+                           9.99999e-5, 1.234567891, -42.,    0.5};
+  Particles particles;
+  for (std::size_t i = 0; i + 4 <= std::size(values); i++) {
+    ParticleData p = Test::smashon_random();
+    p.set_4position(
+        FourVector(values[i], values[i + 1], values[i + 2], values[i + 3]));
+    p.set_4momentum(
+        FourVector(values[i + 3], values[i + 2], values[i + 1], values[i]));
+    p.set_formation_time(values[i]);
+    particles.insert(p);
+  }
+  const ParticleList list = particles.copy_to_vector();
+  ScatterActionPtr action =
+      std::make_unique<ScatterAction>(list[0], list[1], 0.);
+  action->add_all_scatterings(Test::default_finder_parameters());
+  action->generate_final_state();
+  const double density = 0.123456789;
+  EventInfo event = Test::default_event_info(1.0005, false);
+
+  const std::filesystem::path outputfilepath =
+      testoutputpath / "full_event_history.oscar";
+  for (const bool extended : {false, true}) {
+    {
+      OutputParameters out_par = OutputParameters();
+      out_par.coll_printstartend = true;
+      out_par.coll_extended = extended;
+      std::unique_ptr<OutputInterface> output = create_oscar_output(
+          "Oscar2013", "Collisions", testoutputpath, out_par);
+      output->at_eventstart(particles, 0, event);
+      output->at_interaction(*action, density);
+      output->at_eventend(particles, 0, event);
+    }
+
+    std::string expected = "# event 0 in " + std::to_string(list.size()) +
+                           "\n";
+    for (const ParticleData &p : list) {
+      expected += printf_particle_line(p, extended);
+    }
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "# interaction in %zu out %zu rho %12.7f weight %12.7g"
+                  " partial %12.7f type %5i\n",
+                  action->incoming_particles().size(),
+                  action->outgoing_particles().size(), density,
+                  action->get_total_weight(), action->get_partial_weight(),
+                  static_cast<int>(action->get_type()));
+    expected += line;
+    for (const ParticleData &p : action->incoming_particles()) {
+      expected += printf_particle_line(p, extended);
+    }
+    for (const ParticleData &p : action->outgoing_particles()) {
+      expected += printf_particle_line(p, extended);
+    }
+    expected += "# event 0 out " + std::to_string(list.size()) + "\n";
+    for (const ParticleData &p : list) {
+      expected += printf_particle_line(p, extended);
+    }
+    std::snprintf(
+        line, sizeof(line),
+        "# event %i end 0 impact %7.3f scattering_projectile_target %s\n", 0,
+        event.impact_parameter, "yes");
+    expected += line;
+
+    // Everything after the three header lines
+    std::ifstream outputfile(outputfilepath);
+    std::string header;
+    for (int i = 0; i < 3; i++) {
+      std::getline(outputfile, header);
+    }
+    const std::string content((std::istreambuf_iterator<char>(outputfile)),
+                              std::istreambuf_iterator<char>());
+    COMPARE(content, expected);
+    VERIFY(std::filesystem::remove(outputfilepath));
+  }
+}
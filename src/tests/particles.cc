@@ -340,3 +340,22 @@ TEST(update) {
   COMPARE(p.front().position(), FourVector(3, 3, 3, 3));
   COMPARE(p.front().id_process(), 2u);
 }
+
+TEST(copy_from) {
+  Particles p;
+  p.create(5, 0x661);
+  p.remove(*std::next(p.begin(), 2));
+  Particles copy;
+  copy.create(2, 0x211);
+  copy.copy_from(p);
+  COMPARE(copy.size(), 4u);
+  // The copy keeps the ids and does not reuse the removed one
+  COMPARE(copy.copy_to_vector(), p.copy_to_vector());
+  for (const ParticleData &data : p) {
+    VERIFY(copy.is_valid(data));
+  }
+  COMPARE(copy.insert(Test::smashon()).id(), 5);
+  // The copy is independent of the original
+  p.reset();
+  COMPARE(copy.size(), 5u);
+}
@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2015-2018,2020,2022
+ *    Copyright (c) 2015-2018,2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -11,6 +11,7 @@
 
 #include "smash/pauliblocking.h"
 
+#include <algorithm>
 #include <filesystem>
 
 #include "setup.h"
@@ -113,3 +114,72 @@ TEST(phase_space_density_nucleus) {
     std::cout << 0.5 / 100 * i << "  " << f << std::endl;
   }
 }
+
+TEST(phase_space_density_index) {
+  std::map<PdgCode, int> list = {{0x2212, 79}, {0x2112, 118}};
+  int Ntest = 20;
+  Nucleus Au(list, Ntest);
+  Au.set_parameters_automatic();
+  Au.arrange_nucleons();
+  Au.generate_fermi_momenta();
+
+  std::vector<Particles> part_Au(1);
+  Au.copy_particles(&part_Au[0]);
+
+  ExperimentParameters param = smash::Test::default_parameters(Ntest);
+  std::unique_ptr<PauliBlocker> pb =
+      std::make_unique<PauliBlocker>(get_pauli_blocking_conf(), param);
+
+  const PdgCode pdg = 0x2212;
+  const ParticleList disregard{part_Au[0].front()};
+  auto &&densities = [&]() {
+    std::vector<double> f;
+    for (int i = 0; i < 13; i++) {
+      const ThreeVector r(i - 6.0, 0.3 * i - 2.0, 0.0);
+      const ThreeVector p(0.0, 0.0, 0.02 * i);
+      f.push_back(pb->phasespace_dens(r, p, part_Au, pdg, disregard));
+    }
+    return f;
+  };
+  auto &&compare = [](const std::vector<double> &f,
+                     const std::vector<double> &f_expected) {
+    COMPARE(f.size(), f_expected.size());
+    for (std::size_t i = 0; i < f.size(); i++) {
+      COMPARE_ABSOLUTE_ERROR(f[i], f_expected[i], 1e-12) << "point " << i;
+    }
+  };
+
+  const std::vector<double> f_all_particles = densities();
+  pb->build_index(part_Au, 0.0, 1.0);
+  compare(densities(), f_all_particles);
+
+  /* A proton produced later at another time and place is found where it was
+   * at the time of the index. */
+  ParticleData produced{ParticleType::find(pdg)};
+  produced.set_4momentum(FourVector(1.0, 0.0, 0.0, 0.04));
+  produced.set_4position(FourVector(0.5, 0.0, 0.5, 0.02));
+  const ParticleData &inserted = part_Au[0].insert(produced);
+  pb->add_to_index({inserted}, 0);
+  // ...and removed ones are not counted anymore.
+  part_Au[0].remove(part_Au[0].copy_to_vector()[5]);
+
+  /* A proton crossing a wall keeps its id and process id. Moved by less than
+   * a cell of the index, it is only counted once at its new place. */
+  const ParticleList after_removal = part_Au[0].copy_to_vector();
+  const ParticleData crossing = *std::find_if(
+      after_removal.rbegin(), after_removal.rend(),
+      [&pdg](const ParticleData &part) { return part.pdgcode() == pdg; });
+  ParticleData crossed = crossing;
+  crossed.set_4position(crossing.position() + FourVector(0., 4., 0., 0.));
+  pb->add_to_index({part_Au[0].update_particle(crossing, crossed)}, 0);
+  auto &&density_at_crossed = [&]() {
+    return pb->phasespace_dens(crossed.position().threevec(),
+                               crossed.momentum().threevec(), part_Au, pdg,
+                               disregard);
+  };
+  const double f_crossed_with_index = density_at_crossed();
+  const std::vector<double> f_with_index = densities();
+  pb->clear_index();
+  compare(f_with_index, densities());
+  COMPARE_ABSOLUTE_ERROR(f_crossed_with_index, density_at_crossed(), 1e-12);
+}
@@ -325,6 +325,85 @@ TEST(ensembles_vs_testparticles) {
   VERIFY(a == b) << a << " " << b;
 }
 
+/*
+ * The forces on the particles outside of the lattices are calculated from the
+ * baryons near them only. They have to be the same as those from all particles
+ * at the beginning of the time step, while the particles inside the lattices
+ * take their forces from there.
+ */
+TEST(update_momenta_off_lattice_like_all_particles) {
+  auto random_value = random::make_uniform_distribution(-8.0, +8.0);
+  const std::array<PdgCode, 4> pdgs = {0x2212, 0x2112, -0x2212, 0x211};
+  std::vector<Particles> ensembles(2);
+  for (int id = 0; id < 400; id++) {
+    ParticleData p{ParticleType::find(pdgs[id % pdgs.size()]), id};
+    p.set_4position({0., random_value(), random_value(), random_value()});
+    p.set_4momentum(p.pole_mass(), {0.1 * random_value(), 0.1 * random_value(),
+                                    0.1 * random_value()});
+    ensembles[id % 2].insert(p);
+  }
+
+  Configuration conf{R"(
+    Skyrme:
+        Skyrme_A: -209.2
+        Skyrme_B: 156.4
+        Skyrme_Tau: 1.35
+    Symmetry:
+        S_Pot: 18.0
+  )"};
+  ExperimentParameters param = smash::Test::default_parameters();
+  param.n_ensembles = 2;
+  const Potentials pot(std::move(conf), param);
+
+  // The lattices only cover the particles with positive x
+  using ForceLattice = RectangularLattice<std::pair<ThreeVector, ThreeVector>>;
+  ForceLattice FB_lat({8., 16., 16.}, {4, 8, 8}, {0., -8., -8.}, false,
+                      LatticeUpdate::EveryTimestep);
+  ForceLattice FI3_lat({8., 16., 16.}, {4, 8, 8}, {0., -8., -8.}, false,
+                       LatticeUpdate::EveryTimestep);
+  for (std::size_t i = 0; i < FB_lat.size(); i++) {
+    FB_lat[i] = {ThreeVector(0.01 * i, 0., 0.), ThreeVector(0., 0.02, 0.)};
+    FI3_lat[i] = {ThreeVector(0., 0., 0.01), ThreeVector(0.001 * i, 0., 0.)};
+  }
+
+  ParticleList all_particles;
+  for (Particles &particles : ensembles) {
+    const ParticleList tmp = particles.copy_to_vector();
+    all_particles.insert(all_particles.end(), tmp.begin(), tmp.end());
+  }
+  const double dt = 0.1;
+  update_momenta(ensembles, dt, pot, &FB_lat, &FI3_lat, nullptr);
+
+  int n_off_lattice = 0;
+  std::size_t i = 0;
+  for (Particles &particles : ensembles) {
+    for (const ParticleData &data : particles) {
+      const ParticleData &before = all_particles[i++];
+      if (!data.is_baryon()) {
+        COMPARE(data.momentum(), before.momentum());
+        continue;
+      }
+      const ThreeVector r = before.position().threevec();
+      std::pair<ThreeVector, ThreeVector> FB, FI3;
+      if (!(FB_lat.value_at(r, FB) && FI3_lat.value_at(r, FI3))) {
+        const auto forces = pot.all_forces(r, all_particles);
+        FB = std::make_pair(std::get<0>(forces), std::get<1>(forces));
+        FI3 = std::make_pair(std::get<2>(forces), std::get<3>(forces));
+        n_off_lattice++;
+      }
+      const auto scale = pot.force_scale(data.type());
+      const ThreeVector velocity = before.momentum().velocity();
+      const ThreeVector force =
+          scale.first * (FB.first + velocity.cross_product(FB.second)) +
+          scale.second * data.type().isospin3_rel() *
+              (FI3.first + velocity.cross_product(FI3.second));
+      const ThreeVector expected = before.momentum().threevec() + force * dt;
+      COMPARE(data.momentum().threevec(), expected) << data;
+    }
+  }
+  VERIFY(n_off_lattice > 0);
+}
+
 // create experiment parameters for tests with VDF
 static ExperimentParameters default_parameters_vdf(
     int testparticles = 1, double dt = 0.1,
@@ -333,6 +412,7 @@ static ExperimentParameters default_parameters_vdf(
       std::make_unique<UniformClock>(0., dt, 300.0),  // labclock
       std::make_unique<UniformClock>(0., 1., 300.0),  // outputclock
       1,                                              // ensembles
+      1,                                              // ensemble threads
       testparticles,                                  // testparticles
       DerivativesMode::FiniteDifference,              // derivatives mode
       // both the rest frame and the direct derivatives need to be on for the
@@ -340,6 +420,7 @@ static ExperimentParameters default_parameters_vdf(
       RestFrameDensityDerivativesMode::On,  // rest frame derivatives mode
       FieldDerivativesMode::Direct,         // field derivatives mode
       SmearingMode::Triangular,             // smearing modeing mode
+      false,                                // Gaussian smearing tables
       1.0,                                  // Gaussian smearing width
       4.0,                                  // Gaussian smearing cut-off
       0.333333,                             // discrete smearing weight
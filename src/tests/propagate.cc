@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2015,2017-2020,2022
+ *    Copyright (c) 2014-2015,2017-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -76,6 +76,62 @@ TEST(propagate_default_no_potentials) {
           FourVector(1.0, 0.2 - 0.3 / 0.51, 0.0, 4.8 + 0.4 / 0.51));
 }
 
+TEST(propagate_selected_particles) {
+  auto particles = create_box_particles();
+  ParticleList all = particles->copy_to_vector();
+  ParticleList selected = {all[1], all[3]};
+  propagate_straight_line(particles.get(), selected, 1.0, {});
+  COMPARE(selected[0].position(),
+          FourVector(1.0, 0.7 + 0.1 / std::sqrt(0.03),
+                     0.8 - 0.1 / std::sqrt(0.03), 0.9));
+  COMPARE(selected[1].position(), FourVector(1.0, 4.5 + 0.1 / 0.11, 0.0, 0.0));
+  COMPARE(particles->lookup(all[1]).position(), selected[0].position());
+  COMPARE(particles->lookup(all[3]).position(), selected[1].position());
+  // The other particles keep their time and position until they are needed.
+  COMPARE(particles->lookup(all[2]).position(), all[2].position());
+
+  // Propagating all particles brings them to the same time.
+  propagate_straight_line(particles.get(), 2.0, {});
+  for (const ParticleData &data : *particles) {
+    COMPARE(data.position().x0(), 2.0);
+  }
+  COMPARE(particles->lookup(all[1]).position(),
+          FourVector(2.0, 0.7 + 0.2 / std::sqrt(0.03),
+                     0.8 - 0.2 / std::sqrt(0.03), 0.9));
+  COMPARE(particles->lookup(all[2]).position(),
+          FourVector(2., 0.1 + 0.2 / std::sqrt(1.14),
+                     0.2 + 0.4 / std::sqrt(1.14), 0.3 - 0.6 / std::sqrt(1.14)));
+}
+
+TEST(propagate_batches) {
+  /* More particles than fit into one batch of the kernel, the first of them
+   * initial nucleons, which move with the beam momentum. */
+  constexpr int n_particles = 150;
+  constexpr int n_nucleons = 70;
+  const std::vector<FourVector> beam_momentum(n_nucleons,
+                                              FourVector(1.0, 0.0, 0.0, 0.6));
+  Particles particles;
+  for (int i = 0; i < n_particles; i++) {
+    ParticleData &data = particles.create(0x661);
+    data.set_4position(FourVector(0.1 * (i % 7), 0.0, 0.2 * i, -0.1 * i));
+    data.set_4momentum(Test::smashon_mass, 0.1 * i, -0.3, 0.05 * (i % 3));
+  }
+  const ParticleList before = particles.copy_to_vector();
+  propagate_straight_line(&particles, 3.0, beam_momentum);
+  for (const ParticleData &data : before) {
+    const ThreeVector velocity = data.id() < n_nucleons
+                                     ? beam_momentum[data.id()].velocity()
+                                     : data.velocity();
+    const FourVector expected =
+        FourVector(3.0, data.position().threevec() +
+                            velocity * (3.0 - data.position().x0()));
+    const FourVector position = particles.lookup(data).position();
+    for (int mu = 0; mu < 4; mu++) {
+      COMPARE_ABSOLUTE_ERROR(position[mu], expected[mu], 1e-14);
+    }
+  }
+}
+
 TEST(hubble) {
   // setting up some exeplary metrics with simple b_ for
   // easy analytic values. All ExpansionModes are tested.
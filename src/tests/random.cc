@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2014-2020,2022
+ *    Copyright (c) 2014-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -125,3 +125,39 @@ TEST(beta_a0) {
       N_TEST, 0.001, [&]() { return random::beta_a0(xmin, b); },
       [&](double x) { return std::pow(1.0 - x, b) / x; });
 }
+
+TEST(split_streams_are_reproducible) {
+  const random::Stream parent(42);
+  random::Stream parent_advanced(42);
+  for (int i = 0; i < 1000; i++) {
+    parent_advanced();
+  }
+  // The sub-streams only depend on the seed of the parent and the index
+  random::Stream a = parent.split(3), b = parent_advanced.split(3);
+  COMPARE(a.seed(), b.seed());
+  for (int i = 0; i < 100; i++) {
+    COMPARE(a(), b());
+  }
+  // Different indices and different parents give different sub-streams
+  VERIFY(parent.split(0).seed() != parent.split(1).seed());
+  VERIFY(parent.split(0).seed() != random::Stream(43).split(0).seed());
+  VERIFY(parent.split(0).seed() != parent.split(0).split(0).seed());
+}
+
+TEST(stream_scope) {
+  random::set_seed(1);
+  random::Stream outer(2), inner(2), reference(2);
+  const random::Stream::result_type first = random::Stream(1)();
+  {
+    random::StreamScope outer_scope(outer);
+    COMPARE(random::advance(), reference());
+    {
+      random::StreamScope inner_scope(inner);
+      // The inner stream starts from its own beginning
+      COMPARE(random::advance(), random::Stream(2)());
+    }
+    COMPARE(random::advance(), reference());
+  }
+  // The default stream of the thread has not been touched
+  COMPARE(random::advance(), first);
+}
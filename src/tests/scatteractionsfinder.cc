@@ -1,6 +1,6 @@
 /*
  *
- *    Copyright (c) 2015-2020,2022
+ *    Copyright (c) 2015-2020,2022-2023
  *      SMASH Team
  *
  *    GNU General Public License (GPLv3 or later)
@@ -16,6 +16,7 @@
 #include "setup.h"
 #include "smash/action.h"
 #include "smash/constants.h"
+#include "smash/objectpool.h"
 #include "smash/particledata.h"
 #include "smash/pdgcode.h"
 
@@ -333,3 +334,31 @@ TEST(check_stochastic_collision) {
   // compare probability to the probability of finding an action
   COMPARE_RELATIVE_ERROR(ratio_found, prob, 0.05);
 }
+
+TEST(rejected_pairs_create_no_action) {
+  /* Many pairs approach each other in the time step, but pass by too far
+   * away to collide. Such pairs are the large majority in the collision
+   * search and should be rejected without creating an action, which would
+   * be allocated from the pool. */
+  constexpr int n_neighbors = 1000;
+  constexpr double dt = 2.;
+  ParticleList search_list{Test::smashon(Test::Momentum{1., 0.5, 0., 0.},
+                                         Test::Position{0., 0., 0., 0.}, 0)};
+  ParticleList neighbors_list;
+  for (int i = 0; i < n_neighbors; i++) {
+    neighbors_list.push_back(
+        Test::smashon(Test::Momentum{1., -0.5, 0., 0.},
+                      Test::Position{0., 1., 5. + 0.01 * i, 0.}, i + 1));
+  }
+  ExperimentParameters exp_par = Test::default_parameters();
+  Configuration config = create_configuration_for_tests(10.);
+  ScatterActionsFinder finder(config, exp_par);
+  VERIFY(finder.max_transverse_distance_sqr(1) < 25.);
+
+  const std::size_t allocations_before = PoolAllocated::n_allocations();
+  COMPARE(finder
+              .find_actions_with_neighbors(search_list, neighbors_list, dt, {})
+              .size(),
+          0u);
+  COMPARE(PoolAllocated::n_allocations(), allocations_before);
+}
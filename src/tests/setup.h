@@ -220,28 +220,33 @@ inline MultiParticleReactionsBitSet no_multiparticle_reactions() {
  * testing purposes.
  *
  * If needed you can set the testparticles parameter to a different value than
- * 1.
+ * 1, and choose the collision criterion and the included reactions.
  */
 inline ExperimentParameters default_parameters(
     int testparticles = 1, double dt = 0.1,
-    CollisionCriterion crit = CollisionCriterion::Geometric) {
+    CollisionCriterion crit = CollisionCriterion::Geometric,
+    ReactionsBitSet included_2to2 = all_reactions_included(),
+    MultiParticleReactionsBitSet included_multi =
+        no_multiparticle_reactions()) {
   return ExperimentParameters{
       std::make_unique<UniformClock>(0., dt, 300.0),  // labclock
       std::make_unique<UniformClock>(0., 1., 300.0),  // outputclock
       1,                                              // ensembles
+      1,                                              // ensemble threads
       testparticles,                                  // testparticles
       DerivativesMode::CovariantGaussian,             // derivatives mode
       RestFrameDensityDerivativesMode::Off,  // rest frame derivatives mode
       FieldDerivativesMode::ChainRule,       // field derivatives mode
       SmearingMode::CovariantGaussian,       // smearing mode
+      false,                                 // Gaussian smearing tables
       1.0,                                   // Gaussian smearing width
       4.0,                                   // Gaussian smearing cut-off
       0.333333,                              // discrete smearing weight
       2.0,                                   // triangular smearing range
       crit,
       true,  // two_to_one
-      all_reactions_included(),
-      no_multiparticle_reactions(),
+      included_2to2,
+      included_multi,
       false,  // strings switch
       1.0,
       NNbarTreatment::NoAnnihilation,
@@ -0,0 +1,78 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/threadpool.h"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace smash;
+
+TEST_CATCH(invalid_number_of_threads, std::invalid_argument) {
+  ThreadPool pool(0);
+}
+
+TEST(all_tasks_run_once) {
+  for (int n_threads : {1, 2, 5}) {
+    ThreadPool pool(n_threads);
+    COMPARE(pool.size(), n_threads);
+    for (int n_tasks : {0, 1, 3, 17}) {
+      std::vector<int> calls(n_tasks, 0);
+      pool.parallel_for(n_tasks, [&](int i) { calls[i]++; });
+      for (int i = 0; i < n_tasks; i++) {
+        COMPARE(calls[i], 1) << "task " << i << " with " << n_threads
+                             << " threads";
+      }
+    }
+  }
+}
+
+TEST(static_task_assignment) {
+  constexpr int n_threads = 3;
+  constexpr int n_tasks = 10;
+  ThreadPool pool(n_threads);
+  std::vector<int> worker_of_task(n_tasks, -1);
+  // Repeat a few times to make sure the assignment does not depend on timing
+  for (int repetition = 0; repetition < 5; repetition++) {
+    pool.parallel_for(n_tasks, [&](int i) {
+      worker_of_task[i] = ThreadPool::current_thread_index();
+    });
+    for (int i = 0; i < n_tasks; i++) {
+      COMPARE(worker_of_task[i], i % n_threads);
+    }
+  }
+  COMPARE(ThreadPool::current_thread_index(), 0);
+}
+
+TEST(lowest_exception_is_rethrown) {
+  ThreadPool pool(2);
+  std::vector<int> calls(6, 0);
+  bool caught = false;
+  try {
+    pool.parallel_for(6, [&](int i) {
+      calls[i]++;
+      if (i == 3 || i == 4) {
+        throw std::runtime_error(std::to_string(i));
+      }
+    });
+  } catch (const std::runtime_error &e) {
+    caught = true;
+    COMPARE(std::string(e.what()), "3");
+  }
+  VERIFY(caught);
+  for (int c : calls) {
+    COMPARE(c, 1);
+  }
+  // The pool is still usable after a failed parallel_for
+  int sum = 0;
+  pool.parallel_for(1, [&](int i) { sum += i + 1; });
+  COMPARE(sum, 1);
+}
@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2023
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/threadpool.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace smash {
+
+/// Index of the pool worker running on this thread
+static thread_local int this_thread_index = 0;
+
+ThreadPool::ThreadPool(int n_threads) : n_threads_(n_threads) {
+  if (n_threads < 1) {
+    throw std::invalid_argument("A thread pool needs at least one thread, " +
+                                std::to_string(n_threads) + " were requested.");
+  }
+  workers_.reserve(n_threads - 1);
+  for (int worker = 1; worker < n_threads; worker++) {
+    workers_.emplace_back([this, worker]() { worker_loop(worker); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_available_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+int ThreadPool::current_thread_index() { return this_thread_index; }
+
+void ThreadPool::run_tasks_of(int worker) {
+  for (int i = worker; i < n_tasks_; i += n_threads_) {
+    try {
+      (*task_)(i);
+    } catch (...) {
+      errors_[i] = std::current_exception();
+    }
+  }
+}
+
+void ThreadPool::worker_loop(int worker) {
+  this_thread_index = worker;
+  uint64_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(
+          lock, [&]() { return stop_ || generation_ != seen_generation; });
+      if (stop_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+    run_tasks_of(worker);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busy_workers_--;
+    }
+    work_done_.notify_one();
+  }
+}
+
+void ThreadPool::parallel_for(int n_tasks,
+                              const std::function<void(int)> &task) {
+  if (n_tasks <= 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    n_tasks_ = n_tasks;
+    task_ = &task;
+    errors_.assign(n_tasks, nullptr);
+    busy_workers_ = n_threads_ - 1;
+    generation_++;
+  }
+  work_available_.notify_all();
+  run_tasks_of(0);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this]() { return busy_workers_ == 0; });
+    task_ = nullptr;
+  }
+  for (const std::exception_ptr &error : errors_) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+}  // namespace smash